@@ -38,17 +38,46 @@ Q_DEFINE_THIS_MODULE("bsp") /* module tag for assertions */
 #endif
 
 
+/* state of the button debouncing, see SysTick_Handler() */
+static struct ButtonsDebouncing {
+    uint32_t depressed;
+    uint32_t previous;
+} buttons = { 0U, 0U };
+
+/* tickless idle =====================================================*/
+#ifdef QF_TICKLESS
+    #define SYSTICK_PERIOD      (SystemCoreClock / BSP_TICKS_PER_SEC)
+    #define SYSTICK_MAX_LOAD    0x01000000U /* 24-bit SysTick counter */
+    #define SYSTICK_CTRL_ENABLE (1U << 0)
+
+    void GPIOPortF_IRQHandler(void); /* Forward decl of ISR */
+
+    /* clock ticks covered by the next SysTick interrupt (0: stopped) */
+    static QTimeEvtCtr l_sysTickN = 1U;
+
+    /* (re)starts the SysTick to interrupt after 'load' CPU clocks */
+    static void BSP_sysTickStart(uint32_t const load, QTimeEvtCtr const n) {
+        SysTick->LOAD = load - 1U;
+        SysTick->VAL  = 0U; /* reload the counter right away */
+        SysTick->CTRL |= SYSTICK_CTRL_ENABLE;
+        l_sysTickN = n;
+    }
+#endif
+
 /* Systick handler ISR application hooks ===============================================*/
 void SysTick_Handler(void) {
-    /* state of the button debouncing, see below */
-    static struct ButtonsDebouncing {
-        uint32_t depressed;
-        uint32_t previous;
-    } buttons = { 0U, 0U };
     uint32_t current;
     uint32_t tmp;
 
+#ifdef QF_TICKLESS
+    QTimeEvtCtr const nTicks = l_sysTickN;
+    if (SysTick->LOAD != (SYSTICK_PERIOD - 1U)) { /* end of a long period? */
+        BSP_sysTickStart(SYSTICK_PERIOD, 1U);   /* back to periodic ticks */
+    }
+    QTIMEEVT_TICKN_X(0U, nTicks, (void *)0); /* catch up the slept ticks */
+#else
     QF_TICK_X(0U, (void *)0); /* process all QP/C time event */
+#endif
 
     /* Perform the debouncing of buttons. The algorithm for debouncing
     * adapted from the book "Embedded Systems Dictionary" by Jack Ganssle
@@ -64,7 +93,7 @@ void SysTick_Handler(void) {
     if ((tmp & BTN_SW1) != 0U) {  /* debounced SW1 state changed? */
         if ((buttons.depressed & BTN_SW1) != 0U) { /* is SW1 depressed? */
             static QEvt const buttonPressedEvt = QEVT_INITIALIZER(BUTTON_PRESSED_SIG);
-            QACTIVE_POST(AO_timeBomb, &buttonPressedEvt, 0U);
+            BSP_ISR_POST(AO_timeBomb, &buttonPressedEvt);
             QS_BEGIN_ID(QS_USER, 0)
              QS_STR("SW1");
              QS_U8(1U, 1U);
@@ -72,7 +101,7 @@ void SysTick_Handler(void) {
         }
         else { /* the button is released */
             static QEvt const buttonReleasedEvt = QEVT_INITIALIZER(BUTTON_RELEASED_SIG);
-            QACTIVE_POST(AO_timeBomb, &buttonReleasedEvt, 0U);
+            BSP_ISR_POST(AO_timeBomb, &buttonReleasedEvt);
             QS_BEGIN_ID(QS_USER, 0)
              QS_STR("SW1");
              QS_U8(1U, 1U);
@@ -83,7 +112,7 @@ void SysTick_Handler(void) {
     if ((tmp & BTN_SW2) != 0U) {  /* debounced SW2 state changed? */
             if ((buttons.depressed & BTN_SW2) != 0U) { /* is SW2 depressed? */
                 static QEvt const button2PressedEvt = QEVT_INITIALIZER(BUTTON2_PRESSED_SIG);
-                QACTIVE_POST(AO_timeBomb, &button2PressedEvt, 0U);
+                BSP_ISR_POST_URGENT(AO_timeBomb, &button2PressedEvt);
                 QS_BEGIN_ID(QS_USER, 0)
                  QS_STR("SW2");
                  QS_U8(1U, 1U);
@@ -91,7 +120,7 @@ void SysTick_Handler(void) {
             }
             else { /* the button is released */
                 static QEvt const button2ReleasedEvt = QEVT_INITIALIZER(BUTTON2_RELEASED_SIG);
-                QACTIVE_POST(AO_timeBomb, &button2ReleasedEvt, 0U);
+                BSP_ISR_POST(AO_timeBomb, &button2ReleasedEvt);
                 QS_BEGIN_ID(QS_USER, 0)
                  QS_STR("SW2");
                  QS_U8(1U, 1U);
@@ -99,6 +128,64 @@ void SysTick_Handler(void) {
             }
         }
 }
+
+#ifdef QF_TICKLESS
+/* a button press ends the tickless sleep =================================*/
+void GPIOPortF_IRQHandler(void) {
+    GPIOF_AHB->IM &= ~(BTN_SW1 | BTN_SW2); /* one wakeup per sleep */
+    GPIOF_AHB->ICR = (BTN_SW1 | BTN_SW2);
+
+    QTimeEvtCtr const n = l_sysTickN;
+    if (n == 0U) { /* SysTick stopped (no time event armed)? */
+        BSP_sysTickStart(SYSTICK_PERIOD, 1U); /* debounce from now on */
+    }
+    else if ((n > 1U) && ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) == 0U)) {
+        /* CPU clocks left until the end of the sleep (on a tick boundary) */
+        uint32_t const left = SysTick->VAL;
+        if (left != 0U) { /* otherwise SysTick_Handler() catches up */
+            QTimeEvtCtr const nLeft
+                = (QTimeEvtCtr)(((left - 1U) / SYSTICK_PERIOD) + 1U);
+
+            /* next SysTick at the next tick boundary, then periodic */
+            BSP_sysTickStart(((left - 1U) % SYSTICK_PERIOD) + 1U, 1U);
+            if (n > nLeft) { /* catch up the ticks slept so far */
+                QTIMEEVT_TICKN_X(0U, (QTimeEvtCtr)(n - nLeft), (void *)0);
+            }
+        }
+    }
+    else {
+        /* the periodic ticks are running */
+    }
+}
+#endif /* QF_TICKLESS */
+
+#if (QF_MAX_TICK_RATE > 1U)
+/* the fast tick rate ================================================*/
+void Timer0A_IRQHandler(void) {
+    TIMER0->ICR = (1U << 0); /* clear the time-out interrupt */
+    QTIMEEVT_TICK_X(BSP_TICK_RATE_FAST, (void *)0);
+}
+
+#ifdef QF_ON_TICK_ACTIVE
+/* Called inside the critical section when the first time event of a tick
+* rate gets armed and when the last one is gone. TIMER0A runs only while
+* it has work to do; a restart begins with a full period.
+*/
+void QF_onTickActive(uint_fast8_t const tickRate, bool const active) {
+    if (tickRate == BSP_TICK_RATE_FAST) {
+        if (active) {
+            TIMER0->TAV = TIMER0->TAILR;  /* restart with a full period */
+            TIMER0->ICR = (1U << 0);      /* discard a stale time-out */
+            TIMER0->CTL |= (1U << 0);     /* TAEN */
+        }
+        else {
+            TIMER0->CTL &= ~(1U << 0);
+        }
+    }
+}
+#endif /* QF_ON_TICK_ACTIVE */
+#endif /* (QF_MAX_TICK_RATE > 1U) */
+
 /* QV idle callback ===============================================*/
 void QV_onIdle(void) {
 #ifdef Q_SPY
@@ -118,6 +205,36 @@ void QV_onIdle(void) {
         }
     }
 #elif defined NDEBUG
+#ifdef QF_TICKLESS
+    /* Skip the idle ticks, unless the debouncing needs them (a button is
+    * pressed or bouncing). The next SysTick is programmed for the next
+    * time-event expiry (at most the 24-bit SysTick range); with no time
+    * event armed, the SysTick stops and only a button press wakes up.
+    */
+    if (((buttons.depressed | buttons.previous) == 0U)
+        && ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) == 0U))
+    {
+        QTimeEvtCtr const next = QTimeEvt_nextExpiry(0U);
+        uint32_t const left = SysTick->VAL; /* rest of the current tick */
+        if (next == 0U) {
+            SysTick->CTRL &= ~SYSTICK_CTRL_ENABLE;
+            l_sysTickN = 0U;
+        }
+        else if ((next > 1U) && (left != 0U)) {
+            uint32_t const nMax = (SYSTICK_MAX_LOAD - left) / SYSTICK_PERIOD;
+            QTimeEvtCtr const n = (next <= nMax)
+                                  ? next : (QTimeEvtCtr)(nMax + 1U);
+            BSP_sysTickStart(left + ((uint32_t)(n - 1U) * SYSTICK_PERIOD), n);
+        }
+        else {
+            /* the next tick is due anyway */
+        }
+        if (l_sysTickN != 1U) {
+            GPIOF_AHB->ICR = (BTN_SW1 | BTN_SW2); /* clear stale edges */
+            GPIOF_AHB->IM |= (BTN_SW1 | BTN_SW2);  /* a press wakes up */
+        }
+    }
+#endif /* QF_TICKLESS */
     QV_CPU_SLEEP();     /* Wait-For-Interrupt */
 #else
     QF_INT_ENABLE();    /* Just re-enable IRQs */
@@ -134,6 +251,21 @@ void QF_onStartup(void) {
 
     /* Set SysTick to lowest prio (kernel-aware); keep UART0 at higher prio */
     NVIC_SetPriority(SysTick_IRQn,  (1u << __NVIC_PRIO_BITS) - 1u);
+
+#if (QF_MAX_TICK_RATE > 1U)
+    /* the fast tick shares the SysTick prio. (no mutual preemption) */
+    NVIC_SetPriority(TIMER0A_IRQn, (1u << __NVIC_PRIO_BITS) - 1u);
+    NVIC_EnableIRQ(TIMER0A_IRQn);
+#ifndef QF_ON_TICK_ACTIVE
+    TIMER0->CTL |= (1U << 0); /* TAEN: tick all the time */
+#endif
+#endif
+
+#ifdef QF_TICKLESS
+    /* the wakeup by a button shares the SysTick prio. (no mutual preemption) */
+    NVIC_SetPriority(GPIOF_IRQn, (1u << __NVIC_PRIO_BITS) - 1u);
+    NVIC_EnableIRQ(GPIOF_IRQn);
+#endif
 }
 
 void QF_onCleanup(void) {
@@ -175,6 +307,27 @@ void BSP_init(void) {
     GPIOF_AHB->DEN |= (BTN_SW1 | BTN_SW2);
     GPIOF_AHB->PUR |= (BTN_SW1 | BTN_SW2);
 
+#if (QF_MAX_TICK_RATE > 1U)
+    /* TIMER0A: periodic 32-bit timer of the fast tick rate (stopped) */
+    SYSCTL->RCGCTIMER |= (1U << 0); /* enable Run mode for TIMER0 */
+    (void)SYSCTL->RCGCTIMER;        /* wait for the clock */
+    TIMER0->CTL   = 0U;             /* disabled while configured */
+    TIMER0->CFG   = 0U;             /* 32-bit timer */
+    TIMER0->TAMR  = 0x02U;          /* periodic mode, count down */
+    TIMER0->TAILR = (SystemCoreClock / BSP_FAST_TICKS_PER_SEC) - 1U;
+    TIMER0->ICR   = (1U << 0);
+    TIMER0->IMR   = (1U << 0);      /* time-out interrupt */
+#endif
+
+#ifdef QF_TICKLESS
+    /* falling edge (press) on the buttons, masked until a tickless sleep */
+    GPIOF_AHB->IM  &= ~(BTN_SW1 | BTN_SW2);
+    GPIOF_AHB->IS  &= ~(BTN_SW1 | BTN_SW2); /* edge-sensitive */
+    GPIOF_AHB->IBE &= ~(BTN_SW1 | BTN_SW2); /* one edge */
+    GPIOF_AHB->IEV &= ~(BTN_SW1 | BTN_SW2); /* falling edge */
+    GPIOF_AHB->ICR  = (BTN_SW1 | BTN_SW2);
+#endif
+
     // initialize the QS software tracing...
     if (!QS_INIT((void *)0)) {
         Q_ERROR();
@@ -188,6 +341,9 @@ void BSP_init(void) {
     QS_SIG_DICTIONARY(BUTTON2_PRESSED_SIG, (void *)0);
     QS_SIG_DICTIONARY(BUTTON2_RELEASED_SIG, (void *)0);
     QS_SIG_DICTIONARY(TIMEOUT_SIG, (void *)0);
+#ifdef QS_RTC_HIST
+    QS_USR_DICTIONARY(QS_RTC_HIST_REC); /* RTC-step histogram reports */
+#endif
 
     // setup the QS filters...
     QS_GLB_FILTER(QS_ALL_RECORDS); /* all QS records */
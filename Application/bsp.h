@@ -9,8 +9,19 @@
 
 /* System tick rate and configuration parameters of QP, =========================================================*/
 #define BSP_TICKS_PER_SEC 100U
+#ifndef QF_MAX_SIG /* might be set by QHSM_SIG_MASK in qp.h */
 #define QF_MAX_SIG 16U
+#endif
+#ifndef QF_MAX_TICK_RATE /* define as 2U in the project for the fast rate */
 #define QF_MAX_TICK_RATE 1U
+#endif
+#define BSP_FAST_TICKS_PER_SEC 1000U
+
+/* tick rates for QTimeEvt_ctorX() (the fast one needs QF_MAX_TICK_RATE 2U,
+* and with QF_ON_TICK_ACTIVE it runs only while its time events are armed)
+*/
+#define BSP_TICK_RATE_BASE 0U /* SysTick @ BSP_TICKS_PER_SEC */
+#define BSP_TICK_RATE_FAST 1U /* TIMER0A @ BSP_FAST_TICKS_PER_SEC */
 
 /* Public API =========================================================*/
 void BSP_init(void);
@@ -36,4 +47,24 @@ enum EventSignals {
 /* Extern Active object */
 extern QActive *AO_timeBomb;
 
+/* ISR producers post through the lock-free ingress ring when it is enabled.
+* A full ring is an error, just as a full queue is for QACTIVE_POST().
+*/
+#ifdef QACTIVE_ISR_RING
+    #define BSP_ISR_POST(ao_, e_) do { \
+        bool const posted_ = QACTIVE_POST_FROM_ISR((ao_), (e_)); \
+        Q_ASSERT(posted_); \
+        (void)posted_; /* unused when assertions are disabled (Q_UNSAFE) */ \
+    } while (false)
+#else
+    #define BSP_ISR_POST(ao_, e_) QACTIVE_POST((ao_), (e_), 0U)
+#endif
+
+/* critical events (e.g., defuse) jump the queue through the urgent lane */
+#if (defined QACTIVE_URGENT_LANE) && !(defined QACTIVE_ISR_RING)
+    #define BSP_ISR_POST_URGENT(ao_, e_) QACTIVE_POST_URGENT((ao_), (e_), 0U)
+#else
+    #define BSP_ISR_POST_URGENT(ao_, e_) BSP_ISR_POST((ao_), (e_))
+#endif
+
 #endif /* BSP_H */
@@ -17,6 +17,9 @@ typedef struct {
 
     QTimeEvt te; /* Time event (TIMEOUT_SIG) */
     uint32_t blink_ctr; /* remaining blinks before "boom" */
+#ifdef QF_TIMEEVT_ABS
+    uint64_t deadline; /* absolute tick of the next blink/pause TIMEOUT */
+#endif
 } TimeBomb;
 
 /* constructor declaration */
@@ -37,6 +40,19 @@ static QState TimeBomb_boom(TimeBomb * const me, QEvt const * const e);
 #endif
 
 /* State machine =========================================================*/
+/* Arms the 0.5 s blink/pause timeout. With QF_TIMEEVT_ABS the timeouts
+* follow the absolute grid started by BUTTON_PRESSED, so the latency of
+* the TIMEOUT processing does not accumulate over the blinks.
+*/
+static void TimeBomb_armHalfSec(TimeBomb * const me) {
+#ifdef QF_TIMEEVT_ABS
+    me->deadline += BSP_TICKS_PER_SEC/2;
+    QTimeEvt_armAt(&me->te, me->deadline, 0U);
+#else
+    QTimeEvt_armX(&me->te, BSP_TICKS_PER_SEC/2, 0U);
+#endif
+}
+
 /* Initial transition for the TimeBomb AO */
 static QState TimeBomb_initial(TimeBomb * const me, void const * const par) {
 
@@ -101,6 +117,9 @@ static QState TimeBomb_wait4button(TimeBomb * const me, QEvt const * const e) {
         }
         case BUTTON_PRESSED_SIG: {
             me->blink_ctr = 5U;
+#ifdef QF_TIMEEVT_ABS
+            me->deadline = QTimeEvt_getTick(0U); /* start of the grid */
+#endif
             status_ = Q_TRAN(&TimeBomb_blink);
             break;
         }
@@ -122,7 +141,7 @@ static QState TimeBomb_blink(TimeBomb * const me, QEvt const * const e) {
     switch (e->sig) {
         case Q_ENTRY_SIG: {
             BSP_ledRedOn();
-            QTimeEvt_armX(&me->te, BSP_TICKS_PER_SEC/2, 0U);
+            TimeBomb_armHalfSec(me);
             status_ = Q_HANDLED();
             break;
         }
@@ -153,7 +172,7 @@ static QState TimeBomb_pause(TimeBomb * const me, QEvt const * const e) {
     QState status_;
     switch (e->sig) {
         case Q_ENTRY_SIG: {
-            QTimeEvt_armX(&me->te, BSP_TICKS_PER_SEC/2, 0U);
+            TimeBomb_armHalfSec(me);
             status_ = Q_HANDLED();
             break;
         }
@@ -229,14 +248,59 @@ static QState TimeBomb_defused(TimeBomb * const me, QEvt const * const e) {
 }
 
 /* Constructor =========================================================*/
+#ifdef QHSM_TRAN_CACHE
+static QTranCache timeBomb_tranCache; /* shared by all TimeBomb instances */
+#endif
+#ifdef QHSM_SIG_MASK
+/* signals handled in each TimeBomb state (BUTTON_RELEASED in none) */
+static QSignal const timeBomb_armedSigs[]   = { BUTTON2_PRESSED_SIG, 0U };
+static QSignal const timeBomb_buttonSigs[]  = { BUTTON_PRESSED_SIG, 0U };
+static QSignal const timeBomb_timeoutSigs[] = { TIMEOUT_SIG, 0U };
+static QHsmSigMask timeBomb_sigMasks[] = { /* shared by all instances */
+    { .state = (QStateHandler)&TimeBomb_armed, .sigs = timeBomb_armedSigs },
+    { .state = (QStateHandler)&TimeBomb_wait4button,
+      .sigs = timeBomb_buttonSigs },
+    { .state = (QStateHandler)&TimeBomb_blink, .sigs = timeBomb_timeoutSigs },
+    { .state = (QStateHandler)&TimeBomb_pause, .sigs = timeBomb_timeoutSigs },
+    { .state = (QStateHandler)&TimeBomb_boom, .sigs = (QSignal const *)0 },
+    { .state = (QStateHandler)&TimeBomb_defused, .sigs = timeBomb_armedSigs }
+};
+#endif
+
+#ifdef QACTIVE_COALESCE
+/* "latest-wins" signals: only the newest queued instance matters */
+static QSignal const timeBomb_latestSigs[] = {
+    BUTTON_RELEASED_SIG, BUTTON2_RELEASED_SIG, TIMEOUT_SIG, 0U
+};
+#endif
+
 static void TimeBomb_ctor(TimeBomb * const me) {
     QActive_ctor(&me->super, (QStateHandler)&TimeBomb_initial);
     QTimeEvt_ctorX(&me->te, &me->super, TIMEOUT_SIG, 0U);
+#ifdef QHSM_TRAN_CACHE
+    QHsm_setTranCache((QHsm *)&me->super, &timeBomb_tranCache);
+#endif
+#ifdef QACTIVE_COALESCE
+    QActive_setCoalesce(&me->super, timeBomb_latestSigs);
+#endif
+#ifdef QHSM_SIG_MASK
+    QHsm_setSigMasks((QHsm *)&me->super,
+                     timeBomb_sigMasks, Q_DIM(timeBomb_sigMasks));
+#endif
 }
 
 /* AO instance and queue =========================================================*/
 
 static QEvt const *timeBomb_queue[32];  /* Storage for TimeBomb's event queue  */
+#ifdef QACTIVE_ISR_RING
+static QEvt const *timeBomb_isrRing[8]; /* Storage for TimeBomb's ISR ring */
+#endif
+#ifdef QACTIVE_URGENT_LANE
+static QEvt const *timeBomb_urgentSto[4]; /* Storage for the urgent lane */
+#endif
+#ifdef QS_RTC_HIST
+static uint32_t timeBomb_stamps[Q_DIM(timeBomb_queue)]; /* queue post times */
+#endif
 static TimeBomb timeBomb;               /* AO instance */
 QActive *AO_timeBomb = &timeBomb.super;
 
@@ -251,12 +315,23 @@ int main() {
 
     /* create AO and start it */
     TimeBomb_ctor(&timeBomb);
+#ifdef QACTIVE_ISR_RING
+    QActive_setIsrRing(AO_timeBomb, timeBomb_isrRing, Q_DIM(timeBomb_isrRing));
+#endif
+#ifdef QACTIVE_URGENT_LANE
+    QActive_setUrgentLane(AO_timeBomb,
+                          timeBomb_urgentSto, Q_DIM(timeBomb_urgentSto));
+#endif
     QACTIVE_START(AO_timeBomb,
                   2U,                               /* priority (1-based) */
                   timeBomb_queue,
                   Q_DIM(timeBomb_queue),
                   (void *)0, 0U,
                   (void *)0);
+#ifdef QS_RTC_HIST
+    /* queue-wait histograms (QS-RX command QS_RTC_HIST_CMD) */
+    QActive_setStampSto(AO_timeBomb, timeBomb_stamps, Q_DIM(timeBomb_stamps));
+#endif
 
 
     QF_run(); /* Enter the QP framework's scheduler/event loop (never returns) */
@@ -0,0 +1,166 @@
+/******************************************************************************
+* @file    bsp.c
+* @brief   Board Support Package for the POSIX (Linux) host, QV kernel
+* @board   none (Linux host, qpc/ports/posix/qv)
+******************************************************************************/
+#include "qpc.h"            /* QPC API */
+#include "bsp.h"            /* Board Support Package */
+
+#include <poll.h>           /* poll() for the console input */
+#include <stdio.h>          /* fprintf() */
+#include <stdlib.h>         /* exit() */
+#include <unistd.h>         /* read() */
+
+Q_DEFINE_THIS_MODULE("bsp") /* module tag for assertions */
+
+/* simulated LEDs on the host */
+#define LED_RED      (1U << 1)
+#define LED_GREEN    (1U << 3)
+#define LED_BLUE     (1U << 2)
+
+static uint32_t l_leds; /* current state of the simulated LEDs */
+
+#ifdef Q_SPY
+    static uint8_t const l_clock_tick = 0U; /* QS source of tick events */
+#endif
+
+/* Clock tick callback from the ticker thread ================================*/
+void QF_onClockTick(void) {
+    QF_TICK_X(0U, &l_clock_tick); /* process all QP/C time event */
+
+    /* The console replaces the buttons of the board: '1' clicks SW1,
+    * '2' clicks SW2 and 'q' terminates the application.
+    */
+    struct pollfd pfd = { 0, POLLIN, 0 };
+    if ((poll(&pfd, 1, 0) > 0) && ((pfd.revents & POLLIN) != 0)) {
+        char key;
+        if (read(0, &key, 1) == 1) {
+            switch (key) {
+                case '1': {
+                    static QEvt const buttonPressedEvt =
+                        QEVT_INITIALIZER(BUTTON_PRESSED_SIG);
+                    static QEvt const buttonReleasedEvt =
+                        QEVT_INITIALIZER(BUTTON_RELEASED_SIG);
+                    QACTIVE_POST(AO_timeBomb, &buttonPressedEvt,
+                                 &l_clock_tick);
+                    QACTIVE_POST(AO_timeBomb, &buttonReleasedEvt,
+                                 &l_clock_tick);
+                    break;
+                }
+                case '2': {
+                    static QEvt const button2PressedEvt =
+                        QEVT_INITIALIZER(BUTTON2_PRESSED_SIG);
+                    static QEvt const button2ReleasedEvt =
+                        QEVT_INITIALIZER(BUTTON2_RELEASED_SIG);
+                    QACTIVE_POST(AO_timeBomb, &button2PressedEvt,
+                                 &l_clock_tick);
+                    QACTIVE_POST(AO_timeBomb, &button2ReleasedEvt,
+                                 &l_clock_tick);
+                    break;
+                }
+                case 'q': {
+                    QF_stop();
+                    break;
+                }
+                default: {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/* QF start/cleanup hooks ====================================================*/
+void QF_onStartup(void) {
+    QF_setTickRate(BSP_TICKS_PER_SEC, 30); /* desired tick rate/ticker-prio */
+}
+
+void QF_onCleanup(void) {
+    QS_EXIT();
+    exit(0);
+}
+
+/* BSP init ==================================================================*/
+void BSP_init(void) {
+    // initialize the QS software tracing (binary trace to stdout)...
+    if (!QS_INIT((void *)0)) {
+        Q_ERROR();
+    }
+
+    /* Dictionaries (objects + signals) for readable traces */
+    QS_OBJ_DICTIONARY(AO_timeBomb);
+    QS_OBJ_DICTIONARY(&l_clock_tick);
+    QS_SIG_DICTIONARY(BUTTON_PRESSED_SIG, (void *)0);
+    QS_SIG_DICTIONARY(BUTTON_RELEASED_SIG, (void *)0);
+    QS_SIG_DICTIONARY(BUTTON2_PRESSED_SIG, (void *)0);
+    QS_SIG_DICTIONARY(BUTTON2_RELEASED_SIG, (void *)0);
+    QS_SIG_DICTIONARY(TIMEOUT_SIG, (void *)0);
+#ifdef QS_RTC_HIST
+    QS_USR_DICTIONARY(QS_RTC_HIST_REC); /* RTC-step histogram reports */
+#endif
+
+    // setup the QS filters...
+    QS_GLB_FILTER(QS_ALL_RECORDS); /* all QS records */
+    QS_GLB_FILTER(-QS_QF_TICK); /* disable */
+}
+
+/* LED helpers ===============================================================*/
+static void BSP_led(uint32_t const led, char const * const name,
+                    uint8_t const on)
+{
+    if (on != 0U) {
+        l_leds |= led;
+    }
+    else {
+        l_leds &= ~led;
+    }
+    QS_BEGIN_ID(QS_USER, 0)
+     QS_STR(name);
+     QS_U8(1U, on);
+    QS_END()
+#ifndef Q_SPY
+    Q_UNUSED_PAR(name);
+#endif
+}
+
+void BSP_ledRedOn(void)    { BSP_led(LED_RED,   "red",   1U); }
+void BSP_ledRedOff(void)   { BSP_led(LED_RED,   "red",   0U); }
+void BSP_ledBlueOn(void)   { BSP_led(LED_BLUE,  "blue",  1U); }
+void BSP_ledBlueOff(void)  { BSP_led(LED_BLUE,  "blue",  0U); }
+void BSP_ledGreenOn(void)  { BSP_led(LED_GREEN, "green", 1U); }
+void BSP_ledGreenOff(void) { BSP_led(LED_GREEN, "green", 0U); }
+
+/* Assertions ================================================================*/
+Q_NORETURN Q_onError(char const * const module, int_t const id) {
+    QS_ASSERTION(module, id, 10000U); /* report assertion to QS */
+    fprintf(stderr, "ERROR in %s:%d\n", module, (int)id);
+    exit(-1);
+}
+Q_NORETURN assert_failed(char const * const module, int const id);
+Q_NORETURN assert_failed(char const * const module, int const id) {
+    Q_onError(module, id);
+}
+
+/* QS callbacks ==============================================================*/
+#ifdef Q_SPY
+
+/* QS_onStartup(), QS_onCleanup(), QS_onFlush() and QS_onGetTime() are
+* provided by the POSIX port (qpc/ports/posix/qv/qs_port.c)
+*/
+
+void QS_onReset(void) {
+    exit(0);
+}
+/* custom commands from QSPY */
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    QS_BEGIN_ID(QS_USER + 1U, 0U) /* app-specific record */
+        QS_U8(2, cmdId);
+        QS_U32(8, param1);
+        QS_U32(8, param2);
+        QS_U32(8, param3);
+    QS_END()
+}
+
+#endif /* Q_SPY */
@@ -0,0 +1,450 @@
+/******************************************************************************
+* @file    bsp_replay.c
+* @brief   Replay BSP: sizes the event queues, event pools and QS buffer
+* @board   none (Linux host, qpc/ports/posix/qk)
+*
+* Runs the unchanged TimeBomb application (Application/main.c) on the
+* single-threaded QK simulation in virtual time and replays a recorded or
+* synthetic trace of the button events instead of the real buttons. At
+* the end it reports the peak use of every AO event queue (and urgent lane),
+* every event pool and the QS transmit buffer, together with the minimum
+* sizes recommended at a given safety margin.
+*
+* Model:
+*  - one virtual clock tick per trace tick; the tick and all the events of
+*    that tick are posted from one simulated "interrupt" (like SysTick on
+*    the board, which also debounces the buttons), so the events of one tick
+*    queue up behind each other;
+*  - "busy" periods hold off all the AOs (QK scheduler locked) for a number
+*    of ticks, which stands in for long RTC steps or long critical sections;
+*    the events posted meanwhile pile up in the queues;
+*  - the QS transmit buffer is drained at QSIZE_DRAIN bytes per tick (the
+*    UART rate on the board), and its high-water mark is sampled before
+*    every drain (the QS filters are the same as in Application/bsp.c).
+*  Durations of the RTC steps are NOT modeled, so leave room for the
+*  backlog that a long RTC step of another AO can cause (e.g., with "busy").
+*
+* Trace format (text on stdin, one record per line, '#' starts a comment):
+*   <tick> <SIGNAL>     post SIGNAL to AO_timeBomb at the absolute <tick>
+*   <tick> busy <n>     hold off all the AOs for <n> ticks from <tick>
+* The ticks must not decrease. SIGNAL is one of BUTTON_PRESSED_SIG,
+* BUTTON_RELEASED_SIG, BUTTON2_PRESSED_SIG and BUTTON2_RELEASED_SIG.
+*
+* Environment variables:
+*   QSIZE_SYNTH=<ticks>  replay a synthetic trace of <ticks> ticks with
+*                        random button chatter and busy periods instead of
+*                        reading stdin
+*   QSIZE_SEED=<n>       seed of the synthetic trace (default 1)
+*   QSIZE_MARGIN=<pct>   safety margin of the recommendations (default 25)
+*   QSIZE_DRAIN=<bytes>  QS bytes sent per tick (default 115: 115200 baud
+*                        at BSP_TICKS_PER_SEC 100)
+*   QSIZE_TAIL=<ticks>   ticks replayed after the last record (default 500)
+*
+* Build (from the repository root, add -DQ_SPY, QS/qs.c, QS/qs_rx.c,
+* QS/qs_fp.c, QS/qs_64bit.c, QS/qstamp.c and qpc/ports/posix/qk/qs_port.c
+* to measure the QS buffer):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qk -IApplication \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       Application/main.c Application/posix/bsp_replay.c -o timebomb_replay
+*
+* Usage:
+*   QSIZE_SYNTH=100000 ./timebomb_replay
+*   ./timebomb_replay < buttons.trace
+*
+* Output: one JSON object per line, e.g.
+*   {"qsize":"queue","prio":2,"len":32,"peak":..,"recommended":..}
+*   {"qsize":"qs_tx","size":65536,"peak":..,"recommended":..}
+******************************************************************************/
+#define QP_IMPL             /* inspects the event pools in QF_priv_ */
+#include "qpc.h"            /* QPC API */
+#include "qp_pkg.h"         /* QF_priv_ (event pools) */
+#include "bsp.h"            /* Board Support Package */
+
+#include <stdio.h>          /* fprintf(), printf(), fgets() */
+#include <stdlib.h>         /* exit(), getenv(), strtoul() */
+#include <string.h>         /* strcmp(), strtok() */
+
+#ifdef Q_SPY /* the assertions check the QS buffer only */
+Q_DEFINE_THIS_MODULE("bsp_replay") /* module tag for assertions */
+#endif
+
+/* trace records ============================================================*/
+typedef struct {
+    uint32_t tick;     /* absolute tick of the record */
+    QEvt const *e;     /* event to post or NULL for "busy" */
+    uint32_t busy;     /* number of "busy" ticks */
+} Record;
+
+typedef struct {
+    char const *name;
+    QEvt const *e;
+} SigName;
+
+static QEvt const l_buttonPressedEvt  = QEVT_INITIALIZER(BUTTON_PRESSED_SIG);
+static QEvt const l_buttonReleasedEvt = QEVT_INITIALIZER(BUTTON_RELEASED_SIG);
+static QEvt const l_button2PressedEvt = QEVT_INITIALIZER(BUTTON2_PRESSED_SIG);
+static QEvt const l_button2ReleasedEvt =
+    QEVT_INITIALIZER(BUTTON2_RELEASED_SIG);
+
+static SigName const l_sigNames[] = {
+    { "BUTTON_PRESSED_SIG",   &l_buttonPressedEvt   },
+    { "BUTTON_RELEASED_SIG",  &l_buttonReleasedEvt  },
+    { "BUTTON2_PRESSED_SIG",  &l_button2PressedEvt  },
+    { "BUTTON2_RELEASED_SIG", &l_button2ReleasedEvt }
+};
+
+static uint32_t l_tick;      /* current virtual tick */
+static uint32_t l_endTick;   /* last tick of the replay */
+static uint32_t l_busyEnd;   /* end of the current "busy" period */
+static bool     l_busy;      /* AOs held off? */
+static QSchedStatus l_lockStat;
+
+static Record   l_next;      /* next record to replay */
+static bool     l_hasNext;   /* l_next valid? */
+static bool     l_synth;     /* synthetic trace? */
+static uint32_t l_synthTicks;
+static uint32_t l_rnd;       /* state of the synthetic trace generator */
+static uint32_t l_nPosted;
+
+static uint32_t l_margin;    /* safety margin [%] */
+static uint32_t l_tail;      /* ticks after the last record */
+
+#ifdef Q_SPY
+static uint8_t const l_replay = 0U; /* QS source of the replayed events */
+static uint16_t l_qsDrain;   /* QS bytes drained per tick */
+static uint32_t l_qsPeak;    /* high-water mark of the QS buffer */
+#endif
+
+/*..........................................................................*/
+static uint32_t envU32(char const *name, uint32_t dflt) {
+    char const * const s = getenv(name);
+    return (s != (char *)0) ? (uint32_t)strtoul(s, (char **)0, 0) : dflt;
+}
+/*..........................................................................*/
+static uint32_t rnd(void) { /* xorshift32 */
+    l_rnd ^= l_rnd << 13;
+    l_rnd ^= l_rnd >> 17;
+    l_rnd ^= l_rnd << 5;
+    return l_rnd;
+}
+/*..........................................................................*/
+/* the synthetic trace: bursts of SW1 chatter (bounces of 1..8 press/release
+* pairs in one tick), occasional SW2 clicks and rare busy periods. The buttons
+* stay quiet for a second after every SW2 click: the TimeBomb does not disarm
+* its time event when defused, and re-entering "blink" before it expires
+* would fail the QTimeEvt_armX() precondition (qf_time:400).
+*/
+static bool synthNext(Record * const r) {
+    static uint32_t tick;
+    static uint32_t pending; /* remaining chatter events at 'tick' */
+    static uint32_t quiet;   /* end of the quiet period after SW2 */
+    while (tick < l_synthTicks) {
+        if (pending > 0U) {
+            r->tick = tick;
+            r->e = ((pending & 1U) == 0U)
+                   ? &l_buttonPressedEvt : &l_buttonReleasedEvt;
+            r->busy = 0U;
+            --pending;
+            return true;
+        }
+        ++tick;
+        uint32_t const x = rnd() % 1000U;
+        if (tick < quiet) {
+            /* no button events */
+        }
+        else if (x < 50U) {   /* 5%: SW1 chatter burst */
+            pending = 2U * (1U + (rnd() % 8U));
+        }
+        else if (x < 60U) {   /* 1%: SW2 click */
+            r->tick = tick;
+            r->e = &l_button2PressedEvt;
+            r->busy = 0U;
+            quiet = tick + BSP_TICKS_PER_SEC;
+            return true;
+        }
+        else {
+            /* idle tick */
+        }
+        if ((x >= 60U) && (x < 62U)) { /* 0.2%: busy for up to 10 ticks */
+            r->tick = tick;
+            r->e = (QEvt *)0;
+            r->busy = 1U + (rnd() % 10U);
+            return true;
+        }
+    }
+    return false;
+}
+/*..........................................................................*/
+static bool traceNext(Record * const r) {
+    static uint32_t lineNo;
+    char line[128];
+    while (fgets(line, sizeof(line), stdin) != (char *)0) {
+        ++lineNo;
+        char * const hash = strchr(line, '#');
+        if (hash != (char *)0) {
+            *hash = '\0';
+        }
+        char const * const tickStr = strtok(line, " \t\r\n");
+        if (tickStr == (char *)0) {
+            continue; /* empty line */
+        }
+        char const * const what = strtok((char *)0, " \t\r\n");
+        r->tick = (uint32_t)strtoul(tickStr, (char **)0, 0);
+        r->e = (QEvt *)0;
+        r->busy = 0U;
+        if ((what != (char *)0) && (strcmp(what, "busy") == 0)) {
+            char const * const n = strtok((char *)0, " \t\r\n");
+            r->busy = (n != (char *)0) ? (uint32_t)strtoul(n, (char **)0, 0)
+                                       : 0U;
+        }
+        else if (what != (char *)0) {
+            for (uint_fast8_t i = 0U; i < Q_DIM(l_sigNames); ++i) {
+                if (strcmp(what, l_sigNames[i].name) == 0) {
+                    r->e = l_sigNames[i].e;
+                }
+            }
+        }
+        if (((r->e == (QEvt *)0) && (r->busy == 0U))
+            || (r->tick < l_tick))
+        {
+            fprintf(stderr, "trace line %u: bad record\n", (unsigned)lineNo);
+            exit(-1);
+        }
+        return true;
+    }
+    return false;
+}
+/*..........................................................................*/
+static void readNext(void) {
+    l_hasNext = l_synth ? synthNext(&l_next) : traceNext(&l_next);
+    if (l_hasNext) {
+        l_endTick = l_next.tick + l_tail;
+    }
+}
+/*..........................................................................*/
+static uint32_t recommend(uint32_t peak) {
+    return ((peak * (100U + l_margin)) + 99U) / 100U;
+}
+/*..........................................................................*/
+static void report(void) {
+    fprintf(stderr, "replayed %u ticks, %u events\n",
+            (unsigned)l_tick, (unsigned)l_nPosted);
+
+    for (uint_fast8_t p = 1U; p <= QF_MAX_ACTIVE; ++p) {
+        QActive const * const a = QActive_registry_[p];
+        if (a == (QActive *)0) {
+            continue;
+        }
+        /* the front event is extra: a queue of 'len' holds len + 1 events */
+        uint32_t const len  = (uint32_t)a->eQueue.end;
+        uint32_t const peak = len + 1U - (uint32_t)QF_getQueueMin(p);
+        uint32_t rec = recommend(peak);
+        rec = (rec > 1U) ? (rec - 1U) : 1U;
+        printf("{\"qsize\":\"queue\",\"prio\":%u,\"len\":%u,\"peak\":%u,"
+               "\"recommended\":%u}\n",
+               (unsigned)p, (unsigned)len, (unsigned)peak, (unsigned)rec);
+#ifdef QACTIVE_URGENT_LANE
+        if (a->urgent.end != 0U) {
+            uint32_t const ulen  = (uint32_t)a->urgent.end;
+            uint32_t const upeak = ulen - (uint32_t)QF_getUrgentMin(p);
+            uint32_t const urec  = recommend(upeak);
+            printf("{\"qsize\":\"urgent\",\"prio\":%u,\"len\":%u,"
+                   "\"peak\":%u,\"recommended\":%u}\n",
+                   (unsigned)p, (unsigned)ulen, (unsigned)upeak,
+                   (unsigned)((urec > 0U) ? urec : 1U));
+        }
+#endif
+    }
+
+#if (QF_MAX_EPOOL > 0U)
+    for (uint_fast8_t id = 1U; id <= QF_priv_.maxPool_; ++id) {
+        uint32_t const n    = (uint32_t)QF_priv_.ePool_[id - 1U].nTot;
+        uint32_t const peak = n - (uint32_t)QF_getPoolMin(id);
+        printf("{\"qsize\":\"pool\",\"id\":%u,\"blocks\":%u,"
+               "\"block_size\":%u,\"peak\":%u,\"recommended\":%u}\n",
+               (unsigned)id, (unsigned)n,
+               (unsigned)QF_priv_.ePool_[id - 1U].blockSize,
+               (unsigned)peak, (unsigned)recommend(peak));
+    }
+#endif
+
+#ifdef Q_SPY
+    /* a saturated buffer (peak == size) has lost data: the peak is then
+    * only a lower bound
+    */
+    printf("{\"qsize\":\"qs_tx\",\"size\":%u,\"peak\":%u,"
+           "\"recommended\":%u,\"drain_per_tick\":%u}\n",
+           (unsigned)QS_priv_.end, (unsigned)l_qsPeak,
+           (unsigned)recommend(l_qsPeak), (unsigned)l_qsDrain);
+#endif
+}
+
+#ifdef Q_SPY
+/*..........................................................................*/
+/* samples the high-water mark and sends one tick worth of QS data */
+static void qsDrain(void) {
+    if (l_qsPeak < (uint32_t)QS_priv_.used) {
+        l_qsPeak = (uint32_t)QS_priv_.used;
+    }
+    uint16_t left = l_qsDrain;
+    while (left > 0U) {
+        uint16_t n = left;
+        QF_CRIT_STAT
+        QF_CRIT_ENTRY();
+        uint8_t const * const block = QS_getBlock(&n); /* "sent" */
+        QF_CRIT_EXIT();
+        if (block == (uint8_t *)0) {
+            break;
+        }
+        left -= n;
+    }
+}
+#endif
+
+/* QK idle callback: advances the virtual time =============================*/
+void QK_onIdle(void) {
+#ifdef Q_SPY
+    qsDrain();
+#endif
+
+    if ((!l_hasNext) && (l_tick >= l_endTick) && (!l_busy)) {
+        report();
+        exit(0);
+    }
+
+    ++l_tick;
+
+    QK_ISR_ENTRY(); /* the SysTick "interrupt" */
+    QF_TICK_X(0U, &l_replay);
+    while (l_hasNext && (l_next.tick <= l_tick)) {
+        if (l_next.e != (QEvt *)0) {
+            QACTIVE_POST(AO_timeBomb, l_next.e, &l_replay);
+            QS_BEGIN_ID(QS_USER, 0) /* the same record as Application/bsp.c */
+                QS_STR(((l_next.e->sig == BUTTON_PRESSED_SIG)
+                        || (l_next.e->sig == BUTTON_RELEASED_SIG))
+                       ? "SW1" : "SW2");
+                QS_U8(1U, 1U);
+            QS_END()
+            ++l_nPosted;
+        }
+        else if (l_busyEnd < (l_tick + l_next.busy)) { /* start/extend */
+            l_busyEnd = l_tick + l_next.busy;
+        }
+        else {
+            /* within the current busy period */
+        }
+        readNext();
+    }
+    QK_ISR_EXIT(); /* runs the AOs, unless busy */
+
+    /* QK_schedLock() is not allowed in the ISR */
+    if ((!l_busy) && (l_tick < l_busyEnd)) {
+        l_busy = true;
+        l_lockStat = QK_schedLock(QF_MAX_ACTIVE); /* hold off all AOs */
+    }
+    else if (l_busy && (l_tick >= l_busyEnd)) {
+        l_busy = false;
+        QK_schedUnlock(l_lockStat); /* runs the backlog */
+    }
+    else {
+        /* no change */
+    }
+}
+
+/* QF start/cleanup hooks ====================================================*/
+void QF_onStartup(void) {
+    readNext();
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+
+/* BSP init ==================================================================*/
+void BSP_init(void) {
+    l_margin = envU32("QSIZE_MARGIN", 25U);
+    l_tail   = envU32("QSIZE_TAIL", 500U);
+    l_synthTicks = envU32("QSIZE_SYNTH", 0U);
+    l_synth  = (l_synthTicks != 0U);
+    l_rnd    = envU32("QSIZE_SEED", 1U);
+    if (l_rnd == 0U) {
+        l_rnd = 1U; /* xorshift must not start at 0 */
+    }
+    l_endTick = l_tail;
+
+#ifdef Q_SPY
+    l_qsDrain = (uint16_t)envU32("QSIZE_DRAIN", 115U);
+    Q_ASSERT(l_qsDrain > 0U);
+
+    if (!QS_INIT("/dev/null")) { /* the QS data is only measured */
+        Q_ERROR();
+    }
+
+    /* the same dictionaries and filters as Application/bsp.c */
+    QS_OBJ_DICTIONARY(AO_timeBomb);
+    QS_SIG_DICTIONARY(BUTTON_PRESSED_SIG, (void *)0);
+    QS_SIG_DICTIONARY(BUTTON_RELEASED_SIG, (void *)0);
+    QS_SIG_DICTIONARY(BUTTON2_PRESSED_SIG, (void *)0);
+    QS_SIG_DICTIONARY(BUTTON2_RELEASED_SIG, (void *)0);
+    QS_SIG_DICTIONARY(TIMEOUT_SIG, (void *)0);
+#ifdef QS_RTC_HIST
+    QS_USR_DICTIONARY(QS_RTC_HIST_REC); /* RTC-step histogram reports */
+#endif
+
+    QS_GLB_FILTER(QS_ALL_RECORDS); /* all QS records */
+    QS_GLB_FILTER(-QS_QF_TICK); /* disable */
+#endif
+}
+
+/* LEDs (the same QS records as Application/bsp.c) ===========================*/
+static void BSP_led(char const * const name, uint8_t const on) {
+    QS_BEGIN_ID(QS_USER, 0)
+        QS_STR(name);
+        QS_U8(1U, on);
+    QS_END()
+#ifndef Q_SPY
+    Q_UNUSED_PAR(name);
+    Q_UNUSED_PAR(on);
+#endif
+}
+void BSP_ledRedOn(void)    { BSP_led("red",   1U); }
+void BSP_ledRedOff(void)   { BSP_led("red",   0U); }
+void BSP_ledBlueOn(void)   { BSP_led("blue",  1U); }
+void BSP_ledBlueOff(void)  { BSP_led("blue",  0U); }
+void BSP_ledGreenOn(void)  { BSP_led("green", 1U); }
+void BSP_ledGreenOff(void) { BSP_led("green", 0U); }
+
+/* error handling ============================================================*/
+Q_NORETURN Q_onError(char const * const module, int_t const id) {
+    /* e.g., an event queue overflow (Q_ERROR_INCRIT(190) in qf_actq) */
+    fprintf(stderr, "ERROR in %s:%d at tick %u\n",
+            module, (int)id, (unsigned)l_tick);
+    report();
+    exit(-1);
+}
+/*..........................................................................*/
+Q_NORETURN assert_failed(char const * const module, int const id);
+Q_NORETURN assert_failed(char const * const module, int const id) {
+    Q_onError(module, id);
+}
+
+/* QS callbacks ==============================================================*/
+#ifdef Q_SPY
+
+/* QS_onStartup(), QS_onCleanup(), QS_onFlush() and QS_onGetTime() are
+* provided by the POSIX port (qpc/ports/posix/qk/qs_port.c)
+*/
+
+void QS_onReset(void) {
+    exit(0);
+}
+/*..........................................................................*/
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    Q_UNUSED_PAR(cmdId);
+    Q_UNUSED_PAR(param1);
+    Q_UNUSED_PAR(param2);
+    Q_UNUSED_PAR(param3);
+}
+
+#endif /* Q_SPY */
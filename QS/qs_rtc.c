@@ -0,0 +1,219 @@
+//============================================================================
+// QP/C Real-Time Embedded Framework (RTEF)
+//
+//                   Q u a n t u m  L e a P s
+//                   ------------------------
+//                   Modern Embedded Software
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open source GNU
+// General Public License version 3 (or any later version), or alternatively,
+// under the terms of one of the closed source Quantum Leaps commercial
+// licenses.
+//
+// The terms of the open source GNU General Public License version 3
+// can be found at: <www.gnu.org/licenses/gpl-3.0>
+//
+// The terms of the closed source Quantum Leaps commercial licenses
+// can be found at: <www.state-machine.com/licensing>
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// Contact information:
+// <www.state-machine.com>
+// <info@state-machine.com>
+//============================================================================
+//! @date Last updated on: 2026-10-17
+//! @version Last updated for: @ref qpc_7_3_0
+//!
+//! @file
+//! @brief QS per-AO/per-signal RTC-step latency histograms (QS_RTC_HIST)
+
+#define QP_IMPL           // this is QP implementation
+#include "qs_port.h"      // QS port
+#include "qs_pkg.h"       // QS package-scope internal interface
+#include "qp_pkg.h"       // QP package-scope interface (QF_bzero_())
+
+#ifdef QS_RTC_HIST
+
+//============================================================================
+//! @cond INTERNAL
+
+// the histograms of one (active object, signal) pair
+typedef struct {
+    uint32_t exec[QS_RTC_HIST_BINS]; // RTC-step execution times
+    uint32_t wait[QS_RTC_HIST_BINS]; // queue wait times
+    uint32_t maxExec; // the longest execution time so far
+    uint32_t maxWait; // the longest queue wait so far
+    uint32_t count;   // number of the RTC steps
+    QSignal  sig;     // the signal processed in the RTC steps
+    uint8_t  prio;    // prio. of the active object (0 for a free slot)
+} QS_RtcHist;
+
+static QS_RtcHist l_rtcHist[QS_RTC_HIST_SLOTS];
+static uint32_t   l_rtcLost; // RTC steps not recorded (all slots taken)
+
+//............................................................................
+// the log2 bin of the time 'dt': bin 0 holds dt < (1 << QS_RTC_HIST_SHIFT),
+// bin k holds dt < (1 << (QS_RTC_HIST_SHIFT + k)), the last bin the rest
+static uint_fast8_t QS_rtcHistBin_(uint32_t const dt) {
+    uint32_t d = dt >> QS_RTC_HIST_SHIFT;
+    uint_fast8_t bin = 0U;
+    while ((d != 0U) && (bin < (QS_RTC_HIST_BINS - 1U))) {
+        d >>= 1U;
+        ++bin;
+    }
+    return bin;
+}
+
+//............................................................................
+// the slot of the (prio, sig) pair, allocated on the first use;
+// NULL when all the slots are taken by other pairs
+static QS_RtcHist *QS_rtcHistFind_(
+    uint8_t const prio,
+    QSignal const sig)
+{
+    uint_fast16_t i = (((uint_fast16_t)prio * 31U) + (uint_fast16_t)sig)
+                      % QS_RTC_HIST_SLOTS;
+    QS_RtcHist *h = (QS_RtcHist *)0;
+    for (uint_fast16_t n = QS_RTC_HIST_SLOTS; n != 0U; --n) {
+        if (l_rtcHist[i].prio == 0U) { // free slot?
+            l_rtcHist[i].prio = prio; // take it for the (prio, sig) pair
+            l_rtcHist[i].sig  = sig;
+            h = &l_rtcHist[i];
+            break;
+        }
+        if ((l_rtcHist[i].prio == prio) && (l_rtcHist[i].sig == sig)) {
+            h = &l_rtcHist[i];
+            break;
+        }
+        ++i;
+        if (i == QS_RTC_HIST_SLOTS) {
+            i = 0U;
+        }
+    }
+    return h;
+}
+
+//! @endcond
+//============================================================================
+
+//............................................................................
+//! @static @private @memberof QS
+void QS_rtcHistUpdate_(
+    QActive const * const a,
+    enum_t const sig)
+{
+    QS_CRIT_STAT
+    QS_CRIT_ENTRY();
+    QS_MEM_SYS();
+
+    // NOTE: under a preemptive kernel the execution time includes the
+    // preemptions by the higher-priority active objects and interrupts
+    uint32_t const exec =
+        (uint32_t)(QSTimeCtr)(QS_onGetTime() - (QSTimeCtr)a->rtcStart);
+
+    QS_RtcHist * const h = QS_rtcHistFind_(a->prio, (QSignal)sig);
+    if (h != (QS_RtcHist *)0) {
+        ++h->count;
+        ++h->exec[QS_rtcHistBin_(exec)];
+        if (h->maxExec < exec) {
+            h->maxExec = exec;
+        }
+        // the queue wait is known only with the time stamps of the
+        // ring-buffer entries (see QActive_setStampSto())
+        if (a->stampSto != (uint32_t *)0) {
+            ++h->wait[QS_rtcHistBin_(a->rtcWait)];
+            if (h->maxWait < a->rtcWait) {
+                h->maxWait = a->rtcWait;
+            }
+        }
+    }
+    else {
+        ++l_rtcLost;
+    }
+
+    QS_MEM_APP();
+    QS_CRIT_EXIT();
+}
+
+//............................................................................
+//! @static @private @memberof QS
+void QS_rtcHistReport_(
+    uint_fast8_t const prio,
+    bool const reset)
+{
+    QS_CRIT_STAT
+    uint_fast16_t nRep = 0U;
+    for (uint_fast16_t i = 0U; i < QS_RTC_HIST_SLOTS; ++i) {
+        QS_RtcHist h;
+
+        // take a consistent snapshot of the slot
+        QS_CRIT_ENTRY();
+        QS_MEM_SYS();
+        h = l_rtcHist[i];
+        if ((h.prio != 0U) && ((prio == 0U) || (h.prio == prio))) {
+            if (reset) {
+                QF_bzero_(&l_rtcHist[i], sizeof(l_rtcHist[i]));
+                if (prio != 0U) { // reset of one AO only?
+                    // keep the (prio, sig) pair in its slot, because a free
+                    // slot ends the probing in QS_rtcHistFind_() and would
+                    // hide the pairs of the other AOs stored past it
+                    l_rtcHist[i].prio = h.prio;
+                    l_rtcHist[i].sig  = h.sig;
+                }
+            }
+        }
+        else {
+            h.prio = 0U; // don't report this slot
+        }
+        QS_MEM_APP();
+        QS_CRIT_EXIT();
+
+        if (h.prio != 0U) {
+            ++nRep;
+            // one record per histogram:
+            // prio, signal, kind (0:exec, 1:wait), count, max, bins...
+            for (uint_fast8_t kind = 0U; kind < 2U; ++kind) {
+                uint32_t const * const bins = (kind == 0U)
+                                              ? &h.exec[0] : &h.wait[0];
+                QS_BEGIN_ID(QS_RTC_HIST_REC, 0U)
+                    QS_U8(0, h.prio);
+                    QS_SIG(h.sig, QActive_registry_[h.prio]);
+                    QS_U8(0, kind);
+                    QS_U32(0, h.count);
+                    QS_U32(0, (kind == 0U) ? h.maxExec : h.maxWait);
+                    for (uint_fast8_t b = 0U; b < QS_RTC_HIST_BINS; ++b) {
+                        QS_U32(0, bins[b]);
+                    }
+                QS_END()
+                QS_FLUSH(); // don't overrun the QS buffer with the report
+            }
+        }
+    }
+
+    // the closing record: kind 2, # histograms reported, # steps lost
+    QS_CRIT_ENTRY();
+    QS_MEM_SYS();
+    uint32_t const lost = l_rtcLost;
+    if (reset && (prio == 0U)) {
+        l_rtcLost = 0U;
+    }
+    QS_MEM_APP();
+    QS_CRIT_EXIT();
+
+    QS_BEGIN_ID(QS_RTC_HIST_REC, 0U)
+        QS_U8(0, 0U);
+        QS_SIG(0U, (void *)0);
+        QS_U8(0, 2U);
+        QS_U32(0, nRep);
+        QS_U32(0, lost);
+    QS_END()
+    QS_FLUSH();
+}
+
+#endif // def QS_RTC_HIST
@@ -778,8 +778,25 @@ static void QS_rxHandleGoodFrame_(uint8_t const state) {
         case WAIT4_CMD_PARAM3: // intentionally fall-through
         case WAIT4_CMD_FRAME: {
             QS_rxReportAck_((int8_t)QS_RX_COMMAND);
-            QS_onCommand(l_rx.var.cmd.cmdId, l_rx.var.cmd.param1,
-                         l_rx.var.cmd.param2, l_rx.var.cmd.param3);
+#ifdef QS_RTC_HIST
+            if (l_rx.var.cmd.cmdId == (uint8_t)QS_RTC_HIST_CMD) {
+                // param1: AO prio. (0 for all), param2: reset if not 0
+                QS_rtcHistReport_((uint_fast8_t)l_rx.var.cmd.param1,
+                                  l_rx.var.cmd.param2 != 0U);
+            }
+            else
+#endif // def QS_RTC_HIST
+#ifdef QF_EPOOL_TRACK
+            if (l_rx.var.cmd.cmdId == (uint8_t)QS_EPOOL_TRACK_CMD) {
+                // param1: event pool id (0 for all tracked pools)
+                QF_poolTrackReport_((uint_fast8_t)l_rx.var.cmd.param1);
+            }
+            else
+#endif // def QF_EPOOL_TRACK
+            {
+                QS_onCommand(l_rx.var.cmd.cmdId, l_rx.var.cmd.param1,
+                             l_rx.var.cmd.param2, l_rx.var.cmd.param3);
+            }
 #ifdef Q_UTEST
     #if Q_UTEST != 0
             QS_processTestEvts_(); // process all events produced
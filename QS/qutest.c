@@ -59,6 +59,10 @@
 #endif
 //$endskip${QP_VERSION} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
+#ifdef QF_TIMEEVT_WHEEL
+#error QUTest stub of QTimeEvt_tick1_() requires the linked-list time events
+#endif
+
 //$define${QS::QUTest} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 //$enddef${QS::QUTest} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
@@ -257,9 +261,17 @@ void QTimeEvt_tick1_(
 
     QTimeEvt *prev = &QTimeEvt_timeEvtHead_[tickRate];
 
+    #ifdef QF_TIMEEVT_ABS
+    ++QTimeEvt_tickCtr_[tickRate];
+    #endif
+
     QS_BEGIN_PRE_(QS_QF_TICK, 0U)
+    #ifdef QF_TIMEEVT_ABS
+        QS_TEC_PRE_(QTimeEvt_tickCtr_[tickRate]); // tick ctr (low bits)
+    #else
         ++prev->ctr;
         QS_TEC_PRE_(prev->ctr); // tick ctr
+    #endif
         QS_U8_PRE_(tickRate);   // tick rate
     QS_END_PRE_()
 
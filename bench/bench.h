@@ -0,0 +1,52 @@
+/******************************************************************************
+* @file    bench.h
+* @brief   Fixture shared by the host benchmarks
+*
+* Every benchmark program includes this header once, after "qpc.h" (the
+* TimeBomb state machines linked into some of them do not). It provides:
+*  - now_ns(): the monotonic time [ns] for timing the measured loops;
+*  - Q_onError(): prints the module and the id of the failed assertion
+*    and exits with status -1. A benchmark can add context to the report
+*    (e.g., its virtual time) by setting the BENCH_onErrorCtx hook;
+*  - empty QF_onStartup() and QF_onCleanup(). A benchmark that needs its
+*    own callback defines BENCH_QF_ON_STARTUP or BENCH_QF_ON_CLEANUP
+*    before including this header.
+******************************************************************************/
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*..........................................................................*/
+static inline uint64_t now_ns(void) {
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/* optional context printed by Q_onError() after the failed assertion */
+static void (*BENCH_onErrorCtx)(void);
+
+/*..........................................................................*/
+Q_NORETURN Q_onError(char const * const module, int_t const id) {
+    fprintf(stderr, "ERROR in %s:%d\n", module, (int)id);
+    if (BENCH_onErrorCtx != (void (*)(void))0) {
+        (*BENCH_onErrorCtx)();
+    }
+    exit(-1);
+}
+
+/* QF callbacks ============================================================*/
+#ifndef BENCH_QF_ON_STARTUP
+void QF_onStartup(void) {
+}
+#endif
+/*..........................................................................*/
+#ifndef BENCH_QF_ON_CLEANUP
+void QF_onCleanup(void) {
+}
+#endif
+
+#endif /* BENCH_H_ */
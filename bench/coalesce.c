@@ -0,0 +1,173 @@
+/******************************************************************************
+* @file    coalesce.c
+* @brief   "Latest-wins" event coalescing in AO queues (QACTIVE_COALESCE)
+*
+* A "Sensor" AO receives bursts of dynamic SAMPLE events (each carrying
+* an increasing value) interleaved with immutable CMD events. The events are
+* posted with the QK scheduler locked, so that a burst waits in the queue
+* as it would behind a long RTC step or under an interrupt storm. With
+* QACTIVE_COALESCE, SAMPLE is a "latest-wins" signal: a new SAMPLE replaces
+* the one already in the queue, so every burst costs one SAMPLE RTC step
+* and one queue entry, and the replaced events are recycled by QF_gc().
+* The same source is built twice, with and without QACTIVE_COALESCE.
+*
+* Checks (the "ok" field):
+*  - every CMD event is processed and the last processed SAMPLE of every
+*    burst carries the newest value;
+*  - no event leaks: after the run, all the blocks of the event pool can be
+*    allocated again (the reference counters of the replaced events are
+*    correct).
+*
+* Build (from the repository root):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/coalesce.c -o coalesce_off
+*   gcc -O2 -DQACTIVE_COALESCE -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/coalesce.c -o coalesce_on
+*
+* Usage:
+*   ./coalesce_off; ./coalesce_on
+*
+* Output: one JSON object, e.g.
+*   {"bench":"coalesce","mode":"latest","posted":..,"steps":..,
+*    "max_depth":..,"ns_per_post":..,"ok":1}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("coalesce")
+
+#define BENCH_BURSTS  200000U /* number of bursts */
+#define BENCH_BURST   24U     /* events per burst (every 4th is a CMD) */
+#define QUEUE_LEN     32U     /* as timeBomb_queue in Application/main.c */
+
+#ifdef QACTIVE_COALESCE
+    #define BENCH_MODE "latest"
+#else
+    #define BENCH_MODE "fifo"
+#endif
+
+enum BenchSignals {
+    SAMPLE_SIG = Q_USER_SIG,
+    CMD_SIG,
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;     /* inherits QEvt */
+    uint32_t value; /* sample value (increasing) */
+} SampleEvt;
+
+static QActive l_sensor;
+static QEvt const *l_sensorQueue[QUEUE_LEN];
+static QF_MPOOL_EL(SampleEvt) l_samplePool[QUEUE_LEN + 4U];
+#ifdef QACTIVE_COALESCE
+static QSignal const l_latestSigs[] = { SAMPLE_SIG, 0U };
+#endif
+
+static QEvt const l_cmdEvt = QEVT_INITIALIZER(CMD_SIG);
+
+static uint32_t l_nSteps; /* all RTC steps */
+static uint32_t l_nCmds;  /* CMD RTC steps */
+static uint32_t l_last;   /* value of the last processed SAMPLE */
+
+/*..........................................................................*/
+static QState Sensor_active(QActive * const me, QEvt const * const e) {
+    Q_UNUSED_PAR(me);
+    QState status;
+    switch (e->sig) {
+        case SAMPLE_SIG: {
+            l_last = Q_EVT_CAST(SampleEvt)->value;
+            ++l_nSteps;
+            status = Q_HANDLED();
+            break;
+        }
+        case CMD_SIG: {
+            ++l_nCmds;
+            ++l_nSteps;
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+static QState Sensor_initial(QActive * const me, void const * const par) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Sensor_active);
+}
+
+/*..........................................................................*/
+static void bench(void) {
+    uint32_t value = 0U;
+    bool ok = true;
+    uint64_t const t0 = now_ns();
+    for (uint32_t k = 0U; k < BENCH_BURSTS; ++k) {
+        QSchedStatus const lockStat = QK_schedLock(1U);
+        for (uint_fast8_t i = 0U; i < BENCH_BURST; ++i) {
+            if ((i & 3U) == 3U) {
+                QACTIVE_POST(&l_sensor, &l_cmdEvt, (void *)0);
+            }
+            else {
+                SampleEvt * const se = Q_NEW(SampleEvt, SAMPLE_SIG);
+                se->value = ++value;
+                QACTIVE_POST(&l_sensor, &se->super, (void *)0);
+            }
+        }
+        QK_schedUnlock(lockStat); /* runs the whole burst */
+        ok = ok && (l_last == value); /* the newest sample wins */
+    }
+    uint64_t const dt = now_ns() - t0;
+    uint32_t const nPosted = BENCH_BURSTS * BENCH_BURST;
+    ok = ok && (l_nCmds == (nPosted / 4U));
+
+    /* all the pool blocks must be free again (no leaked references) */
+    QEvt const *evts[Q_DIM(l_samplePool) + 1U];
+    uint_fast16_t nFree = 0U;
+    while (nFree < Q_DIM(evts)) {
+        evts[nFree] = QF_newX_(sizeof(SampleEvt), 0U, SAMPLE_SIG);
+        if (evts[nFree] == (QEvt *)0) {
+            break;
+        }
+        ++nFree;
+    }
+    ok = ok && (nFree == Q_DIM(l_samplePool));
+    for (uint_fast16_t i = 0U; i < nFree; ++i) {
+        QF_gc(evts[i]);
+    }
+
+    printf("{\"bench\":\"coalesce\",\"mode\":\"%s\",\"posted\":%u,"
+           "\"steps\":%u,\"max_depth\":%u,\"ns_per_post\":%.1f,\"ok\":%d}\n",
+           BENCH_MODE, (unsigned)nPosted, (unsigned)l_nSteps,
+           (unsigned)(QUEUE_LEN + 1U - QF_getQueueMin(l_sensor.prio)),
+           (double)dt / (double)nPosted, ok ? 1 : 0);
+    Q_ASSERT(ok);
+}
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+    bench();
+    exit(0);
+}
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+    QF_poolInit(l_samplePool, sizeof(l_samplePool), sizeof(l_samplePool[0]));
+
+    QActive_ctor(&l_sensor, Q_STATE_CAST(&Sensor_initial));
+#ifdef QACTIVE_COALESCE
+    QActive_setCoalesce(&l_sensor, l_latestSigs);
+#endif
+    QACTIVE_START(&l_sensor, 1U, l_sensorQueue, Q_DIM(l_sensorQueue),
+                  (void *)0, 0U, (void *)0);
+    return QF_run();
+}
@@ -0,0 +1,197 @@
+/******************************************************************************
+* @file    deadline.c
+* @brief   Phase drift of re-armed one-shot timeouts vs absolute deadlines
+*
+* Three "Sampler" AOs run the same 100 ms activity for one virtual hour,
+* while a seeded script of busy periods (the scheduler locked for 1..15
+* ticks, sometimes longer than the period) delays their RTC steps:
+*  - "relative": the TIMEOUT handler re-arms a one-shot time event with
+*    QTimeEvt_armX(period), so every delay shifts all later activations;
+*  - "absolute": the handler re-arms at the previous deadline plus the
+*    period with QTimeEvt_armAt() (QF_TIMEEVT_ABS), so the activations stay
+*    on the grid start + k*period, however late the handler runs;
+*  - "periodic": a periodic QTimeEvt_armX(period, period), the reference.
+* For each AO the benchmark reports the number of activations, the drift
+* of the last activation from its grid point [ticks] and the worst lateness
+* of an activation behind its grid point [ticks].
+*
+* Build (from the repository root):
+*   gcc -O2 -DQF_TIMEEVT_ABS -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/deadline.c -o deadline
+*
+* Usage:
+*   ./deadline
+*
+* Output: one JSON object per AO, e.g.
+*   {"bench":"deadline","mode":"absolute","ticks":..,"activations":..,
+*    "expected":..,"drift":..,"max_late":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("deadline")
+
+#ifndef QF_TIMEEVT_ABS
+    #error the benchmark needs QF_TIMEEVT_ABS (QTimeEvt_armAt())
+#endif
+
+#define TICKS_PER_SEC    100U
+#define BENCH_TICKS      (3600U * TICKS_PER_SEC) /* one virtual hour */
+#define BENCH_SEED       12345U
+#define PERIOD           (TICKS_PER_SEC / 10U) /* 100 ms */
+#define BUSY_PERCENT     10U  /* chance of a busy period starting at a tick */
+#define BUSY_MAX         15U  /* longest busy period [ticks] */
+
+enum BenchSignals {
+    TIMEOUT_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+enum SamplerModes {
+    MODE_RELATIVE,
+    MODE_ABSOLUTE,
+    MODE_PERIODIC,
+    MODE_MAX
+};
+
+typedef struct {
+    QActive super;
+    QTimeEvt te;
+    uint_fast8_t mode;
+    uint64_t deadline;     /* absolute tick of the next TIMEOUT */
+    uint32_t activations;
+    int32_t  drift;        /* last activation minus its grid point */
+    int32_t  maxLate;      /* worst activation behind its grid point */
+} Sampler;
+
+static char const * const l_modeNames[MODE_MAX] = {
+    "relative", "absolute", "periodic"
+};
+
+static Sampler l_samplers[MODE_MAX];
+static QEvt const *l_samplerQueues[MODE_MAX][8];
+
+static uint32_t l_tick;   /* current virtual tick */
+static uint32_t l_rnd = BENCH_SEED;
+
+/*..........................................................................*/
+static QState Sampler_active(Sampler * const me, QEvt const * const e) {
+    QState status;
+    switch (e->sig) {
+        case TIMEOUT_SIG: {
+            ++me->activations;
+            int32_t const late
+                = (int32_t)l_tick - (int32_t)(me->activations * PERIOD);
+            me->drift = late;
+            if (late > me->maxLate) {
+                me->maxLate = late;
+            }
+
+            if (me->mode == MODE_RELATIVE) {
+                QTimeEvt_armX(&me->te, PERIOD, 0U);
+            }
+            else if (me->mode == MODE_ABSOLUTE) {
+                me->deadline += PERIOD;
+                QTimeEvt_armAt(&me->te, me->deadline, 0U);
+            }
+            else {
+                /* the periodic time event re-arms itself */
+            }
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+static QState Sampler_initial(Sampler * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+    me->deadline = QTimeEvt_getTick(0U) + PERIOD;
+    if (me->mode == MODE_RELATIVE) {
+        QTimeEvt_armX(&me->te, PERIOD, 0U);
+    }
+    else if (me->mode == MODE_ABSOLUTE) {
+        QTimeEvt_armAt(&me->te, me->deadline, 0U);
+    }
+    else {
+        QTimeEvt_armX(&me->te, PERIOD, PERIOD);
+    }
+    return Q_TRAN(&Sampler_active);
+}
+
+/*..........................................................................*/
+static uint32_t rnd(uint32_t range) { /* xorshift32 */
+    l_rnd ^= l_rnd << 13;
+    l_rnd ^= l_rnd >> 17;
+    l_rnd ^= l_rnd << 5;
+    return l_rnd % range;
+}
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+    uint32_t busy = 0U; /* ticks left in the current busy period */
+    QSchedStatus lockStat = 0U;
+
+    for (l_tick = 1U; l_tick <= BENCH_TICKS; ++l_tick) {
+        QK_ISR_ENTRY(); /* SysTick */
+        QTIMEEVT_TICK_X(0U, (void *)0);
+        QK_ISR_EXIT(); /* runs the AOs, unless the scheduler is locked */
+
+        /* the tick counter of QF_TIMEEVT_ABS follows the clock ticks */
+        Q_ASSERT(QTimeEvt_getTick(0U) == l_tick);
+
+        if (busy != 0U) { /* in a busy period? */
+            --busy;
+            if (busy == 0U) {
+                QK_schedUnlock(lockStat); /* runs the delayed AOs */
+            }
+        }
+        else if (rnd(100U) < BUSY_PERCENT) { /* a busy period starts */
+            busy = 1U + rnd(BUSY_MAX);
+            lockStat = QK_schedLock(MODE_MAX); /* blocks all Samplers */
+        }
+        else {
+            /* no delay */
+        }
+    }
+    --l_tick;
+
+    for (uint_fast8_t m = 0U; m < MODE_MAX; ++m) {
+        Sampler const * const s = &l_samplers[m];
+        printf("{\"bench\":\"deadline\",\"mode\":\"%s\",\"ticks\":%u,"
+               "\"activations\":%u,\"expected\":%u,\"drift\":%d,"
+               "\"max_late\":%d}\n",
+               l_modeNames[m], (unsigned)l_tick,
+               (unsigned)s->activations, (unsigned)(l_tick / PERIOD),
+               (int)s->drift, (int)s->maxLate);
+    }
+    exit(0);
+}
+/*..........................................................................*/
+static void error_ctx(void) { /* context of the error report */
+    fprintf(stderr, "  at tick %u\n", (unsigned)l_tick);
+}
+
+/*..........................................................................*/
+int main(void) {
+    BENCH_onErrorCtx = &error_ctx;
+    QF_init();
+
+    for (uint_fast8_t m = 0U; m < MODE_MAX; ++m) {
+        Sampler * const s = &l_samplers[m];
+        s->mode = m;
+        QActive_ctor(&s->super, Q_STATE_CAST(&Sampler_initial));
+        QTimeEvt_ctorX(&s->te, &s->super, TIMEOUT_SIG, 0U);
+        QACTIVE_START(&s->super, (uint_fast8_t)(m + 1U),
+                      l_samplerQueues[m], Q_DIM(l_samplerQueues[m]),
+                      (void *)0, 0U, (void *)0);
+    }
+    return QF_run();
+}
@@ -0,0 +1,228 @@
+/******************************************************************************
+* @file    epool_mag.c
+* @brief   Producer->consumer event throughput with and without the per-AO
+*          magazines in front of the event pools (QF_EPOOL_MAG)
+*
+* P = 1, 2, 4, 8 pairs of AOs run on the multi-threaded POSIX port
+* (qpc/ports/posix/mt). Every Producer allocates bursts of BENCH_BURST
+* dynamic DATA events with Q_NEW() and posts them to its Consumer, which
+* checks their sequence numbers; the kernel recycles them with QF_gc() in
+* the Consumer's thread. Every burst is acknowledged, with BENCH_CREDITS
+* bursts in flight per pair. So in steady state the Producers only
+* allocate and the Consumers only free, which is the worst case for the
+* magazines: the Producer's magazine refills from the pool and the
+* Consumer's magazine flushes to the pool, both in batches of
+* QF_EPOOL_MAG/2 blocks, instead of one critical section per event.
+* The same source is built twice and the "mode" field tells the two apart.
+*
+* Build (from the repository root):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/mt \
+*       qpc/src/qf/q*.c qpc/ports/posix/mt/qf_port.c \
+*       bench/epool_mag.c -o epool_pool -lpthread
+*   gcc -O2 -DQF_EPOOL_MAG=8U -Iqpc/include -Iqpc/ports/posix/mt \
+*       qpc/src/qf/q*.c qpc/ports/posix/mt/qf_port.c \
+*       bench/epool_mag.c -o epool_mag -lpthread
+*
+* Usage:
+*   ./epool_pool; ./epool_mag
+*
+* Output: one JSON object per line, e.g.
+*   {"bench":"epool_mag","mode":"mag","mag":8,"pairs":4,"events":..,
+*    "mevents_per_sec":..,"ns_per_event":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+Q_DEFINE_THIS_MODULE("epool_mag")
+
+#define BENCH_MAX_PAIRS   8U
+#define BENCH_EVENTS      (1024U * 1024U) /* DATA events per run */
+#define BENCH_BURST       16U  /* DATA events per burst */
+#define BENCH_CREDITS     2U   /* bursts in flight per pair */
+#define BENCH_QLEN        ((BENCH_BURST * BENCH_CREDITS) + 8U)
+
+enum BenchSignals {
+    START_SIG = Q_USER_SIG,
+    ACK_SIG,
+    DATA_SIG,
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;
+    uint32_t seq;  /* sequence number within the pair */
+    bool last;     /* last event of a burst? */
+} DataEvt;
+
+typedef struct {
+    QActive super;
+    QActive *consumer;
+    uint32_t seq;   /* next sequence number to send */
+    uint32_t total; /* number of events to send */
+} Producer;
+
+typedef struct {
+    QActive super;
+    QActive *producer;
+    uint32_t seq;   /* next expected sequence number */
+    uint32_t total; /* number of events to receive */
+} Consumer;
+
+/* all the runs use fresh AOs, because the AO threads cannot be stopped */
+#define BENCH_N_AO (2U * (1U + 2U + 4U + BENCH_MAX_PAIRS))
+
+static Producer l_producer[BENCH_N_AO / 2U];
+static Consumer l_consumer[BENCH_N_AO / 2U];
+static QEvt const *l_queueSto[BENCH_N_AO][BENCH_QLEN];
+
+/* the blocks in flight, plus the magazines of all the AOs */
+static QF_MPOOL_EL(DataEvt) l_pool[(BENCH_N_AO * (BENCH_QLEN + 8U)) + 64U];
+
+static QEvt const l_startEvt = QEVT_INITIALIZER(START_SIG);
+static QEvt const l_ackEvt   = QEVT_INITIALIZER(ACK_SIG);
+
+static atomic_uint l_nDone; /* pairs done in the current run */
+
+#ifdef QF_EPOOL_MAG
+    #define BENCH_MODE "mag"
+    #define BENCH_MAG  ((unsigned)QF_EPOOL_MAG)
+#else
+    #define BENCH_MODE "pool"
+    #define BENCH_MAG  0U
+#endif
+
+/*..........................................................................*/
+static void Producer_burst(Producer * const me) {
+    for (uint_fast8_t i = 0U; (i < BENCH_BURST) && (me->seq < me->total);
+         ++i)
+    {
+        DataEvt * const d = Q_NEW(DataEvt, DATA_SIG);
+        d->seq  = me->seq;
+        ++me->seq;
+        d->last = ((i == (BENCH_BURST - 1U)) || (me->seq == me->total));
+        QACTIVE_POST(me->consumer, &d->super, me);
+    }
+}
+/*..........................................................................*/
+static QState Producer_active(Producer * const me, QEvt const * const e) {
+    QState status;
+    switch (e->sig) {
+        case START_SIG: {
+            for (uint_fast8_t c = 0U; c < BENCH_CREDITS; ++c) {
+                Producer_burst(me);
+            }
+            status = Q_HANDLED();
+            break;
+        }
+        case ACK_SIG: {
+            Producer_burst(me);
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+static QState Producer_initial(Producer * const me, void const * const par) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Producer_active);
+}
+/*..........................................................................*/
+static QState Consumer_active(Consumer * const me, QEvt const * const e) {
+    QState status;
+    switch (e->sig) {
+        case DATA_SIG: {
+            DataEvt const * const d = Q_EVT_CAST(DataEvt);
+            Q_ASSERT(d->seq == me->seq); /* no lost or duplicated events */
+            ++me->seq;
+            if (me->seq == me->total) {
+                (void)atomic_fetch_add(&l_nDone, 1U);
+            }
+            else if (d->last) {
+                QACTIVE_POST(me->producer, &l_ackEvt, me);
+            }
+            else {
+                /* more events of the burst to come */
+            }
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+static QState Consumer_initial(Consumer * const me, void const * const par) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Consumer_active);
+}
+
+/*..........................................................................*/
+static void bench(uint_fast8_t const nPairs, uint_fast8_t * const nAO) {
+    uint32_t const perPair = BENCH_EVENTS / nPairs;
+    Producer * const prod = &l_producer[*nAO / 2U];
+    Consumer * const cons = &l_consumer[*nAO / 2U];
+
+    for (uint_fast8_t i = 0U; i < nPairs; ++i) {
+        QActive_ctor(&prod[i].super, Q_STATE_CAST(&Producer_initial));
+        QActive_ctor(&cons[i].super, Q_STATE_CAST(&Consumer_initial));
+        prod[i].consumer = &cons[i].super;
+        prod[i].total    = perPair;
+        cons[i].producer = &prod[i].super;
+        cons[i].total    = perPair;
+        QACTIVE_START(&prod[i].super, (uint_fast8_t)(*nAO + 1U),
+                      l_queueSto[*nAO], BENCH_QLEN, (void *)0, 0U, (void *)0);
+        QACTIVE_START(&cons[i].super, (uint_fast8_t)(*nAO + 2U),
+                      l_queueSto[*nAO + 1U], BENCH_QLEN,
+                      (void *)0, 0U, (void *)0);
+        *nAO += 2U;
+    }
+
+    atomic_store(&l_nDone, 0U);
+    uint64_t const t0 = now_ns();
+    for (uint_fast8_t i = 0U; i < nPairs; ++i) {
+        QACTIVE_POST(&prod[i].super, &l_startEvt, (void *)0);
+    }
+    while (atomic_load(&l_nDone) < nPairs) {
+        struct timespec const ts = { 0, 100000 }; /* 0.1 ms */
+        (void)nanosleep(&ts, (struct timespec *)0);
+    }
+    uint64_t const dt = now_ns() - t0;
+
+    uint32_t const events = perPair * nPairs;
+    printf("{\"bench\":\"epool_mag\",\"mode\":\"%s\",\"mag\":%u,"
+           "\"pairs\":%u,\"events\":%u,\"mevents_per_sec\":%.2f,"
+           "\"ns_per_event\":%.2f}\n",
+           BENCH_MODE, BENCH_MAG, (unsigned)nPairs, (unsigned)events,
+           (double)events * 1000.0 / (double)dt,
+           (double)dt / (double)events);
+}
+
+/* QF callbacks ============================================================*/
+void QF_onClockTick(void) {
+}
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+    QF_poolInit(l_pool, sizeof(l_pool), sizeof(l_pool[0]));
+
+    /* the AO threads run as soon as the AOs are started (no QF_run()) */
+    uint_fast8_t nAO = 0U;
+    for (uint_fast8_t n = 1U; n <= BENCH_MAX_PAIRS; n *= 2U) {
+        bench(n, &nAO);
+    }
+    return 0;
+}
@@ -0,0 +1,194 @@
+/******************************************************************************
+* @file    epool_track.c
+* @brief   Cost and attribution of the event-pool leak detector
+*          (QF_EPOOL_TRACK)
+*
+* A "driver" standing in for an ISR (the QK idle loop between
+* QK_ISR_ENTRY() and QK_ISR_EXIT()) allocates BENCH_EVENTS dynamic DATA
+* events with Q_NEW() and posts them to a Consumer AO, which recycles them
+* (QF_gc() after the RTC step). Every BENCH_RARE-th event is a RARE event
+* allocated at another site, and the Consumer leaks every one of them (it
+* keeps a reference with Q_NEW_REF() and never deletes it). The same
+* source is built twice and the "mode" field tells the two apart:
+*  - "off": no tracking;
+*  - "track": QF_EPOOL_TRACK with a side table for the event pool, so
+*    every allocation records its site, signal and time stamp, and every
+*    recycling clears the record.
+* The tracked build then lists the outstanding events with
+* QF_poolForEachLive() and checks that all of them, and only them, are
+* the leaked RARE events attributed to their allocation site. If the pool
+* runs dry, Q_onError() prints the outstanding events (the host dump).
+*
+* Build (from the repository root):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/epool_track.c -o epool_off
+*   gcc -O2 -DQF_EPOOL_TRACK -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/epool_track.c -o epool_track
+*
+* Usage:
+*   ./epool_off; ./epool_track
+*
+* Output: one JSON object per build, e.g.
+*   {"bench":"epool_track","mode":"track","events":..,"ns_per_event":..,
+*    "leaked":..,"outstanding":..,"attributed":..,"site":"...:NN"}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("epool_track")
+
+#define BENCH_EVENTS     (4U * 1024U * 1024U)
+#define BENCH_RARE       16384U /* one RARE event per BENCH_RARE events */
+#define BENCH_LEAKS      (BENCH_EVENTS / BENCH_RARE)
+
+enum BenchSignals {
+    DATA_SIG = Q_USER_SIG,
+    RARE_SIG,
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;
+    uint32_t seq;
+} DataEvt;
+
+typedef struct {
+    QActive super;
+    uint32_t seq;      /* next expected sequence number */
+    uint32_t nLeaked;  /* RARE events kept */
+    DataEvt const *leaked[BENCH_LEAKS];
+} Consumer;
+
+#ifdef QF_EPOOL_TRACK
+    #define BENCH_MODE "track"
+#else
+    #define BENCH_MODE "off"
+#endif
+
+static Consumer l_consumer;
+static QEvt const *l_consumerQueue[8];
+
+/* the leaked events, plus the events in flight */
+static QF_MPOOL_EL(DataEvt) l_pool[BENCH_LEAKS + 16U];
+#ifdef QF_EPOOL_TRACK
+static QEvtSite l_sites[Q_DIM(l_pool)];
+#endif
+
+static int l_rareLine; /* source line of the RARE allocation */
+
+/*..........................................................................*/
+static QState Consumer_active(Consumer * const me, QEvt const * const e) {
+    QState status;
+    switch (e->sig) {
+        case DATA_SIG: {
+            Q_ASSERT(Q_EVT_CAST(DataEvt)->seq == me->seq);
+            ++me->seq;
+            status = Q_HANDLED();
+            break;
+        }
+        case RARE_SIG: {
+            Q_ASSERT(Q_EVT_CAST(DataEvt)->seq == me->seq);
+            ++me->seq;
+            /* the leak: a reference that is never deleted */
+            Q_NEW_REF(me->leaked[me->nLeaked], DataEvt);
+            ++me->nLeaked;
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+static QState Consumer_initial(Consumer * const me, void const * const par) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Consumer_active);
+}
+
+#ifdef QF_EPOOL_TRACK
+static uint32_t l_attributed; /* outstanding events at the RARE site */
+
+/*..........................................................................*/
+static void count_leak(uint_fast8_t const poolId, uint_fast16_t const block,
+                       QEvtSite const * const site)
+{
+    Q_UNUSED_PAR(poolId);
+    Q_UNUSED_PAR(block);
+    if ((site->sig == RARE_SIG) && (site->line == (uint16_t)l_rareLine)) {
+        ++l_attributed;
+    }
+}
+/*..........................................................................*/
+static void print_leak(uint_fast8_t const poolId, uint_fast16_t const block,
+                       QEvtSite const * const site)
+{
+    fprintf(stderr, "  pool %u block %u: sig %u allocated at %s:%u\n",
+            (unsigned)poolId, (unsigned)block, (unsigned)site->sig,
+            site->file, (unsigned)site->line);
+}
+/*..........................................................................*/
+static void error_ctx(void) { /* the host dump of the outstanding events */
+    fprintf(stderr, "outstanding events:\n");
+    (void)QF_poolForEachLive(0U, &print_leak);
+}
+#endif /* QF_EPOOL_TRACK */
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+    uint64_t const t0 = now_ns();
+    for (uint32_t k = 0U; k < BENCH_EVENTS; ++k) {
+        QK_ISR_ENTRY();
+        DataEvt *d;
+        if ((k % BENCH_RARE) == (BENCH_RARE - 1U)) {
+            d = Q_NEW(DataEvt, RARE_SIG); l_rareLine = __LINE__;
+        }
+        else {
+            d = Q_NEW(DataEvt, DATA_SIG);
+        }
+        d->seq = k;
+        QACTIVE_POST(&l_consumer.super, &d->super, (void *)0);
+        QK_ISR_EXIT(); /* the Consumer runs here */
+    }
+    uint64_t const dt = now_ns() - t0;
+
+    uint32_t outstanding = 0U;
+    uint32_t attributed  = 0U;
+#ifdef QF_EPOOL_TRACK
+    outstanding = (uint32_t)QF_poolForEachLive(0U, &count_leak);
+    attributed  = l_attributed;
+    Q_ASSERT((outstanding == l_consumer.nLeaked)
+             && (attributed == l_consumer.nLeaked));
+#endif
+    printf("{\"bench\":\"epool_track\",\"mode\":\"%s\",\"events\":%u,"
+           "\"ns_per_event\":%.2f,\"leaked\":%u,\"outstanding\":%u,"
+           "\"attributed\":%u,\"site\":\"%s:%d\"}\n",
+           BENCH_MODE, (unsigned)BENCH_EVENTS,
+           (double)dt / (double)BENCH_EVENTS,
+           (unsigned)l_consumer.nLeaked, (unsigned)outstanding,
+           (unsigned)attributed, __FILE__, l_rareLine);
+    exit(0);
+}
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+    QF_poolInit(l_pool, sizeof(l_pool), sizeof(l_pool[0]));
+#ifdef QF_EPOOL_TRACK
+    QF_poolSetSiteSto(1U, l_sites, Q_DIM(l_sites));
+    BENCH_onErrorCtx = &error_ctx;
+#endif
+
+    QActive_ctor(&l_consumer.super, Q_STATE_CAST(&Consumer_initial));
+    QACTIVE_START(&l_consumer.super, 1U,
+                  l_consumerQueue, Q_DIM(l_consumerQueue),
+                  (void *)0, 0U, (void *)0);
+    return QF_run();
+}
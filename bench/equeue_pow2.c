@@ -0,0 +1,125 @@
+/******************************************************************************
+* @file    equeue_pow2.c
+* @brief   Cost of the event-queue hot paths: wrap-around vs power-of-two
+*
+* Measures the average time of one post+get pair on a raw QEQueue
+* (QEQueue_post()/QEQueue_get()) and on the built-in queue of an active
+* object (QActive_post_()/QActive_get_()). The queues are kept partially
+* full, so that every post and get goes through the ring buffer and the
+* indices wrap around continuously. The same source is built twice, with
+* and without QF_EQUEUE_POW2, and the "mode" field tells the two apart.
+*
+* The benchmark uses the single-threaded QK simulation (qpc/ports/posix/qk),
+* whose critical section is only a counter, so that the numbers reflect
+* the queue algorithm rather than the cost of a host mutex.
+*
+* Build (from the repository root):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/equeue_pow2.c -o equeue_wrap
+*   gcc -O2 -DQF_EQUEUE_POW2 -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/equeue_pow2.c -o equeue_pow2
+*
+* Usage:
+*   ./equeue_wrap; ./equeue_pow2
+*
+* Output: one JSON object per line, e.g.
+*   {"bench":"equeue_pow2","mode":"pow2","queue":"QEQueue","qlen":16,
+*    "ns_per_pair":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("equeue_pow2")
+
+#define BENCH_PAIRS  (8U * 1000U * 1000U) /* post+get pairs per run */
+#define QLEN         16U  /* power of two, valid in both modes */
+#define QFILL        (QLEN / 2U) /* events kept in the queue */
+
+#ifdef QF_EQUEUE_POW2
+    #define BENCH_MODE "pow2"
+#else
+    #define BENCH_MODE "wrap"
+#endif
+
+enum BenchSignals {
+    SAMPLE_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+static QEQueue l_rawQueue;
+static QEvt const *l_rawQueueSto[QLEN];
+static QActive l_sink;
+static QEvt const *l_sinkQueueSto[QLEN];
+
+static QEvt const l_sampleEvt = QEVT_INITIALIZER(SAMPLE_SIG);
+
+/*..........................................................................*/
+static void report(char const *queue, uint64_t dt) {
+    printf("{\"bench\":\"equeue_pow2\",\"mode\":\"%s\",\"queue\":\"%s\","
+           "\"qlen\":%u,\"ns_per_pair\":%.2f}\n",
+           BENCH_MODE, queue, (unsigned)QLEN,
+           (double)dt / (double)BENCH_PAIRS);
+}
+/*..........................................................................*/
+static void bench_raw(void) {
+    QEQueue_init(&l_rawQueue, l_rawQueueSto, Q_DIM(l_rawQueueSto));
+    for (uint_fast16_t i = 0U; i < QFILL; ++i) {
+        (void)QEQueue_post(&l_rawQueue, &l_sampleEvt, QF_NO_MARGIN, 0U);
+    }
+    uint64_t const t0 = now_ns();
+    for (uint32_t k = 0U; k < BENCH_PAIRS; ++k) {
+        (void)QEQueue_post(&l_rawQueue, &l_sampleEvt, QF_NO_MARGIN, 0U);
+        QEvt const * const e = QEQueue_get(&l_rawQueue, 0U);
+        Q_ASSERT(e == &l_sampleEvt);
+    }
+    report("QEQueue", now_ns() - t0);
+}
+/*..........................................................................*/
+static void bench_active(void) {
+    for (uint_fast16_t i = 0U; i < QFILL; ++i) {
+        QACTIVE_POST(&l_sink, &l_sampleEvt, (void *)0);
+    }
+    uint64_t const t0 = now_ns();
+    for (uint32_t k = 0U; k < BENCH_PAIRS; ++k) {
+        QACTIVE_POST(&l_sink, &l_sampleEvt, (void *)0);
+        QEvt const * const e = QActive_get_(&l_sink);
+        Q_ASSERT(e == &l_sampleEvt);
+    }
+    report("QActive", now_ns() - t0);
+}
+
+/*..........................................................................*/
+static QState Sink_idle(QActive * const me, QEvt const * const e) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(e);
+    return Q_SUPER(&QHsm_top);
+}
+static QState Sink_initial(QActive * const me, void const * const par) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Sink_idle);
+}
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+}
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+    QActive_ctor(&l_sink, Q_STATE_CAST(&Sink_initial));
+    /* the AO never runs, because QF_run() is not called and the QK
+    * scheduler stays locked, so the queue is drained by QActive_get_()
+    */
+    QACTIVE_START(&l_sink, 1U, l_sinkQueueSto, Q_DIM(l_sinkQueueSto),
+                  (void *)0, 0U, (void *)0);
+
+    bench_raw();
+    bench_active();
+    return 0;
+}
@@ -0,0 +1,265 @@
+/******************************************************************************
+* @file    evt_buf.c
+* @brief   Large payloads published to several AOs: copied into inline
+*          events vs zero-copy external buffers (QF_EVT_BUF)
+*
+* A "driver" standing in for an ISR with a DMA channel (the QK idle loop
+* between QK_ISR_ENTRY() and QK_ISR_EXIT()) publishes BENCH_FRAMES frames
+* of 64 to 4096 bytes to BENCH_SUBS subscriber AOs:
+*  - "copy": the DMA fills the driver's own buffer and the driver copies
+*    the frame into a dynamic event with an inline payload (Q_NEW());
+*  - "zerocopy": the driver allocates a QEvtBuf event with Q_NEW_BUF() and
+*    the DMA fills the event's external buffer directly, so the frame is
+*    never copied. The buffer goes back to its buffer pool with the last
+*    reference to the event, when the last subscriber is done with it.
+* The DMA is a memset() in both modes. Zero-copy trades the copy of the
+* frame for a second pool operation (the buffer), so it is slower than the
+* copy for the frames, whose copy costs less than that. The last line
+* reports the crossover: the smallest frame size, from which on zero-copy
+* is faster (0 if it is not even at 4096 bytes). The modes are interleaved
+* and the best of BENCH_RUNS runs counts, after a warm-up run of each mode.
+* Every subscriber checks the frame (its first and last byte). At the end,
+* the benchmark checks that all the events and buffers are back in their
+* pools: a failed Q_NEW_BUF_X() must not leave an event or a buffer behind. (With QF_EPOOL_MAG only the buffer
+* pool is checked, because the subscribers' magazines keep some events.)
+*
+* Build (from the repository root):
+*   gcc -O2 -DQF_EVT_BUF -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/evt_buf.c -o evt_buf
+*
+* Usage:
+*   ./evt_buf
+*
+* Output: one JSON object per mode and frame size, e.g.
+*   {"bench":"evt_buf","mode":"zerocopy","bytes":4096,"subscribers":4,
+*    "frames":..,"copied_per_frame":0,"ns_per_frame":..}
+* and the crossover:
+*   {"bench":"evt_buf","crossover_bytes":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+Q_DEFINE_THIS_MODULE("evt_buf")
+
+#ifndef QF_EVT_BUF
+    #error the benchmark needs QF_EVT_BUF (QEvtBuf and Q_NEW_BUF())
+#endif
+
+#define BENCH_FRAMES     100000U /* frames per run */
+#define BENCH_RUNS       5U      /* runs per mode and size, the best counts */
+#define BENCH_SUBS       4U
+#define BENCH_MAX_FRAME  4096U
+#define BENCH_POOL_LEN   8U   /* buffers */
+#define BENCH_EVT_LEN    (BENCH_POOL_LEN + (BENCH_SUBS * 8U)) /* + magazines */
+
+enum BenchSignals {
+    FRAME_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+enum BenchModes {
+    MODE_COPY,
+    MODE_ZEROCOPY,
+    MODE_MAX
+};
+
+typedef struct { /* frame copied into the event */
+    QEvt super;
+    uint16_t len;
+    uint8_t data[BENCH_MAX_FRAME];
+} FrameEvt;
+
+typedef struct { /* frame in the external buffer */
+    QEvtBuf super;
+    uint32_t seq;
+} FrameBufEvt;
+
+typedef struct {
+    QActive super;
+    uint32_t frames; /* frames received */
+} Subscriber;
+
+static char const * const l_modeNames[MODE_MAX] = {
+    "copy", "zerocopy"
+};
+
+static Subscriber  l_subs[BENCH_SUBS];
+static QEvt const *l_subQueues[BENCH_SUBS][4];
+static QSubscrList l_subscrSto[MAX_SIG];
+
+static QF_MPOOL_EL(FrameBufEvt) l_smlPool[BENCH_EVT_LEN];
+static QF_MPOOL_EL(FrameEvt)    l_bigPool[BENCH_EVT_LEN];
+static uint8_t l_bufPool[BENCH_POOL_LEN][BENCH_MAX_FRAME];
+
+static uint8_t l_dmaBuf[BENCH_MAX_FRAME]; /* the driver's own buffer */
+static uint8_t l_expected; /* byte pattern of the current frame */
+
+/*..........................................................................*/
+static QState Subscriber_active(Subscriber * const me, QEvt const * const e) {
+    QState status;
+    switch (e->sig) {
+        case FRAME_SIG: {
+            uint8_t const *data;
+            uint_fast16_t len;
+            if ((e->evtTag_ & QEVT_XBUF) != 0U) {
+                FrameBufEvt const * const f = Q_EVT_CAST(FrameBufEvt);
+                data = (uint8_t const *)f->super.buf;
+                len  = f->super.size;
+            }
+            else {
+                FrameEvt const * const f = Q_EVT_CAST(FrameEvt);
+                data = &f->data[0];
+                len  = f->len;
+            }
+            Q_ASSERT((data[0] == l_expected)
+                     && (data[len - 1U] == l_expected));
+            Q_UNUSED_PAR(data); /* if Q_ASSERT() is disabled (Q_UNSAFE) */
+            Q_UNUSED_PAR(len);
+            ++me->frames;
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+static QState Subscriber_initial(Subscriber * const me,
+                                 void const * const par)
+{
+    Q_UNUSED_PAR(par);
+    QActive_subscribe(&me->super, FRAME_SIG);
+    return Q_TRAN(&Subscriber_active);
+}
+
+/*..........................................................................*/
+static void driver_frame(uint_fast8_t const mode, uint_fast16_t const len) {
+    QK_ISR_ENTRY(); /* DMA "transfer complete" interrupt */
+    if (mode == MODE_COPY) {
+        (void)memset(l_dmaBuf, l_expected, len); /* DMA */
+        FrameEvt * const f = Q_NEW(FrameEvt, FRAME_SIG);
+        f->len = (uint16_t)len;
+        (void)memcpy(f->data, l_dmaBuf, len);
+        QACTIVE_PUBLISH(&f->super, (void *)0);
+    }
+    else {
+        FrameBufEvt * const f = Q_NEW_BUF(FrameBufEvt, len, FRAME_SIG);
+        (void)memset(f->super.buf, l_expected, len); /* DMA */
+        QACTIVE_PUBLISH(&f->super.super, (void *)0);
+    }
+    QK_ISR_EXIT(); /* the subscribers run here */
+}
+/*..........................................................................*/
+static double run(uint_fast8_t const mode, uint_fast16_t const len) {
+    for (uint_fast8_t i = 0U; i < BENCH_SUBS; ++i) {
+        l_subs[i].frames = 0U;
+    }
+    uint64_t const t0 = now_ns();
+    for (uint32_t k = 0U; k < BENCH_FRAMES; ++k) {
+        l_expected = (uint8_t)(k + 1U);
+        driver_frame(mode, len);
+    }
+    uint64_t const dt = now_ns() - t0;
+
+    for (uint_fast8_t i = 0U; i < BENCH_SUBS; ++i) {
+        Q_ASSERT(l_subs[i].frames == BENCH_FRAMES); /* no lost frames */
+    }
+    return (double)dt / (double)BENCH_FRAMES; /* ns per frame */
+}
+/*..........................................................................*/
+static bool bench(uint_fast16_t const len) { /* is zero-copy faster? */
+    double best[MODE_MAX] = { 0.0 };
+    for (uint_fast8_t r = 0U; r < BENCH_RUNS; ++r) { /* modes interleaved */
+        for (uint_fast8_t m = 0U; m < MODE_MAX; ++m) {
+            double const ns = run(m, len);
+            if ((r == 0U) || (ns < best[m])) {
+                best[m] = ns;
+            }
+        }
+    }
+    for (uint_fast8_t m = 0U; m < MODE_MAX; ++m) {
+        printf("{\"bench\":\"evt_buf\",\"mode\":\"%s\",\"bytes\":%u,"
+               "\"subscribers\":%u,\"frames\":%u,\"copied_per_frame\":%u,"
+               "\"ns_per_frame\":%.2f}\n",
+               l_modeNames[m], (unsigned)len, (unsigned)BENCH_SUBS,
+               (unsigned)BENCH_FRAMES,
+               (unsigned)((m == MODE_COPY) ? len : 0U), best[m]);
+    }
+    return best[MODE_ZEROCOPY] < best[MODE_COPY];
+}
+/*..........................................................................*/
+static void check_pools(void) {
+    /* all the buffers must be back: drain them with external events... */
+    static FrameBufEvt *all[BENCH_EVT_LEN];
+    uint_fast16_t n = 0U;
+    for (; n < BENCH_POOL_LEN; ++n) {
+        all[n] = Q_NEW_BUF_X(FrameBufEvt, BENCH_MAX_FRAME, 0U, FRAME_SIG);
+        Q_ASSERT(all[n] != (FrameBufEvt *)0);
+    }
+    FrameBufEvt const * const extra
+        = Q_NEW_BUF_X(FrameBufEvt, BENCH_MAX_FRAME, 0U, FRAME_SIG);
+    Q_ASSERT(extra == (FrameBufEvt *)0);
+    Q_UNUSED_PAR(extra);
+
+#ifndef QF_EPOOL_MAG /* else the subscribers' magazines hold some events */
+    /* ...the failed allocation must not have taken an event */
+    for (; n < Q_DIM(all); ++n) {
+        all[n] = Q_NEW_X(FrameBufEvt, 0U, FRAME_SIG);
+        Q_ASSERT(all[n] != (FrameBufEvt *)0);
+    }
+    FrameBufEvt const * const extraEvt = Q_NEW_X(FrameBufEvt, 0U, FRAME_SIG);
+    Q_ASSERT(extraEvt == (FrameBufEvt *)0);
+    Q_UNUSED_PAR(extraEvt);
+#endif
+    while (n > 0U) {
+        --n;
+        QF_gc(&all[n]->super.super);
+    }
+}
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+    for (uint_fast8_t m = 0U; m < MODE_MAX; ++m) { /* warm-up: caches, pools */
+        (void)run(m, BENCH_MAX_FRAME);
+    }
+    uint_fast16_t crossover = 0U; /* zero-copy faster from this size on */
+    for (uint_fast16_t len = 64U; len <= BENCH_MAX_FRAME; len *= 2U) {
+        if (!bench(len)) {
+            crossover = 0U;
+        }
+        else if (crossover == 0U) {
+            crossover = len;
+        }
+        else {
+            /* zero-copy still faster */
+        }
+    }
+    printf("{\"bench\":\"evt_buf\",\"crossover_bytes\":%u}\n",
+           (unsigned)crossover);
+    check_pools();
+    exit(0);
+}
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+    QActive_psInit(l_subscrSto, Q_DIM(l_subscrSto));
+    QF_poolInit(l_smlPool, sizeof(l_smlPool), sizeof(l_smlPool[0]));
+    QF_poolInit(l_bigPool, sizeof(l_bigPool), sizeof(l_bigPool[0]));
+    QF_bufPoolInit(l_bufPool, sizeof(l_bufPool), sizeof(l_bufPool[0]));
+
+    for (uint_fast8_t i = 0U; i < BENCH_SUBS; ++i) {
+        QActive_ctor(&l_subs[i].super, Q_STATE_CAST(&Subscriber_initial));
+        QACTIVE_START(&l_subs[i].super, (uint_fast8_t)(i + 1U),
+                      l_subQueues[i], Q_DIM(l_subQueues[i]),
+                      (void *)0, 0U, (void *)0);
+    }
+    return QF_run();
+}
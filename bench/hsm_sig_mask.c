@@ -0,0 +1,128 @@
+/******************************************************************************
+* @file    hsm_sig_mask.c
+* @brief   Cost of unhandled events in a QHsm: handler walk vs QHSM_SIG_MASK
+*
+* Runs the TimeBomb state machine of Application/main.c (the hand-written
+* QHsm in bench/timebomb_qhsm.c) with a traffic mix in which every other
+* event is BUTTON_RELEASED, which no TimeBomb state handles. Without
+* QHSM_SIG_MASK, QEP walks such an event from the leaf state up to
+* QHsm_top; with it, the handled-signal masks registered in TimeBomb_ctor()
+* drop the event without calling any state handler, and the handled events
+* skip the states that don't handle them (e.g. BUTTON2_PRESSED goes
+* straight to "armed").
+*
+* Two measurements:
+*  - "mix": one cycle of the TimeBomb script (arm, 10 TIMEOUTs to "boom",
+*    defuse, re-arm: 13 events) with a BUTTON_RELEASED after each event
+*    (26 events). The time event is disarmed before every TIMEOUT, as if
+*    it had expired. The stub BSP folds every LED operation into a checksum
+*    and the two builds must report the same "trace".
+*  - "drop": BUTTON_RELEASED events only, in the state "wait4button".
+*
+* Build (from the repository root):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qk -IApplication -Ibench \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/timebomb_qhsm.c bench/hsm_sig_mask.c -o hsm_walk
+*   gcc -O2 -DQHSM_SIG_MASK -Iqpc/include -Iqpc/ports/posix/qk \
+*       -IApplication -Ibench \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/timebomb_qhsm.c bench/hsm_sig_mask.c -o hsm_sig_mask
+*
+* Usage:
+*   ./hsm_walk; ./hsm_sig_mask
+*
+* Output: one JSON object per line, e.g.
+*   {"bench":"hsm_sig_mask","mode":"mask","run":"mix","events":..,
+*    "ns_per_evt":..,"trace":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bsp.h"
+#include "timebomb_qhsm.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("hsm_sig_mask")
+
+#define BENCH_CYCLES  (500U * 1000U)        /* script cycles of the "mix" */
+#define BENCH_DROPS   (10U * 1000U * 1000U) /* events of the "drop" run */
+
+#ifdef QHSM_SIG_MASK
+    #define BENCH_MODE "mask"
+#else
+    #define BENCH_MODE "walk"
+#endif
+
+static TimeBomb l_timeBomb;
+
+static QEvt const l_buttonEvt   = QEVT_INITIALIZER(BUTTON_PRESSED_SIG);
+static QEvt const l_releaseEvt  = QEVT_INITIALIZER(BUTTON_RELEASED_SIG);
+static QEvt const l_button2Evt  = QEVT_INITIALIZER(BUTTON2_PRESSED_SIG);
+static QEvt const l_timeoutEvt  = QEVT_INITIALIZER(TIMEOUT_SIG);
+
+static uint32_t l_trace; /* checksum of the LED operations */
+
+/* stub BSP ================================================================*/
+static void led(uint32_t op) {
+    l_trace = (l_trace * 31U) + op;
+}
+void BSP_ledRedOn(void)    { led(1U); }
+void BSP_ledRedOff(void)   { led(2U); }
+void BSP_ledBlueOn(void)   { led(3U); }
+void BSP_ledBlueOff(void)  { led(4U); }
+void BSP_ledGreenOn(void)  { led(5U); }
+void BSP_ledGreenOff(void) { led(6U); }
+
+/*..........................................................................*/
+/* dispatches e followed by the unhandled BUTTON_RELEASED */
+static void dispatch2(QAsm * const sm, QEvt const * const e) {
+    QASM_DISPATCH(sm, e, 0U);
+    QASM_DISPATCH(sm, &l_releaseEvt, 0U);
+}
+/*..........................................................................*/
+static void report(char const *run, uint32_t nEvt, uint64_t dt) {
+    printf("{\"bench\":\"hsm_sig_mask\",\"mode\":\"%s\",\"run\":\"%s\","
+           "\"events\":%u,\"ns_per_evt\":%.2f,\"trace\":%u}\n",
+           BENCH_MODE, run, (unsigned)nEvt,
+           (double)dt / (double)nEvt, (unsigned)l_trace);
+}
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+}
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+
+    /* the state machine is dispatched directly, the AO is not started */
+    TimeBomb_ctor(&l_timeBomb);
+    QAsm * const sm = &l_timeBomb.super.super;
+    QASM_INIT(sm, (void *)0, 0U);
+
+    l_trace = 0U;
+    uint32_t nEvt = 0U;
+    uint64_t t0 = now_ns();
+    for (uint32_t k = 0U; k < BENCH_CYCLES; ++k) {
+        dispatch2(sm, &l_buttonEvt);
+        for (uint_fast8_t i = 0U; i < 10U; ++i) {
+            (void)QTimeEvt_disarm(&l_timeBomb.te); /* the time evt "expired" */
+            dispatch2(sm, &l_timeoutEvt);
+        }
+        dispatch2(sm, &l_button2Evt); /* -> defused */
+        dispatch2(sm, &l_button2Evt); /* -> armed/wait4button */
+        nEvt += 26U;
+    }
+    report("mix", nEvt, now_ns() - t0);
+
+    /* back in "wait4button" after every script cycle */
+    uint32_t const trace = l_trace;
+    t0 = now_ns();
+    for (uint32_t k = 0U; k < BENCH_DROPS; ++k) {
+        QASM_DISPATCH(sm, &l_releaseEvt, 0U);
+    }
+    report("drop", BENCH_DROPS, now_ns() - t0);
+    Q_ASSERT(l_trace == trace); /* the ignored events had no effect */
+    return 0;
+}
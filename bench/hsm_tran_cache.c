@@ -0,0 +1,169 @@
+/******************************************************************************
+* @file    hsm_tran_cache.c
+* @brief   Cost of QHsm transitions: LCA discovery vs transition-path cache
+*
+* A QHsm with the maximum supported nesting depth (top + 5 levels) toggles
+* between two leaf states in different branches on every TIMEOUT event:
+*
+*   top
+*    +-s1
+*       +-s11
+*          +-s111
+*             +-a1
+*             |  +-a2      TIMEOUT: tran. to b2
+*             +-b1         TIMEOUT: tran. to a2
+*                +-b2
+*
+* The transition a2->b2 is taken in the leaf state, while b2->a2 is taken
+* in the superstate b1, so the current state exits up to the source first.
+* Every transition exits 2 and enters 2 states below the LCA s111. All the
+* states have entry and exit actions, which fold the state into a checksum
+* of the exit/entry sequence. The same source is built twice, with and
+* without QHSM_TRAN_CACHE, and the two builds must report the same "trace".
+*
+* The benchmark dispatches the events directly to the state machine with
+* QASM_DISPATCH() (no event queue), using the single-threaded QK simulation
+* (qpc/ports/posix/qk) only for the critical section.
+*
+* Build (from the repository root):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/hsm_tran_cache.c -o hsm_tran
+*   gcc -O2 -DQHSM_TRAN_CACHE -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/hsm_tran_cache.c -o hsm_tran_cache
+*
+* Usage:
+*   ./hsm_tran; ./hsm_tran_cache
+*
+* Output: one JSON object, e.g.
+*   {"bench":"hsm_tran_cache","mode":"cache","events":..,"calls_per_evt":..,
+*    "ns_per_evt":..,"trace":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("hsm_tran_cache")
+
+#define BENCH_EVENTS  (4U * 1000U * 1000U) /* TIMEOUT events dispatched */
+
+#ifdef QHSM_TRAN_CACHE
+    #define BENCH_MODE "cache"
+#else
+    #define BENCH_MODE "lca"
+#endif
+
+enum BenchSignals {
+    TIMEOUT_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+typedef struct {
+    QHsm super;     /* inherits QHsm */
+    uint32_t trace; /* checksum of the exit/entry sequence */
+    uint32_t calls; /* number of state-handler calls */
+} Deep;
+
+static Deep l_deep;
+#ifdef QHSM_TRAN_CACHE
+static QTranCache l_deepCache; /* shared by all instances of Deep */
+#endif
+
+static QEvt const l_timeoutEvt = QEVT_INITIALIZER(TIMEOUT_SIG);
+
+static QState Deep_initial(Deep * const me, void const * const par);
+static QState Deep_s1  (Deep * const me, QEvt const * const e);
+static QState Deep_s11 (Deep * const me, QEvt const * const e);
+static QState Deep_s111(Deep * const me, QEvt const * const e);
+static QState Deep_a1  (Deep * const me, QEvt const * const e);
+static QState Deep_a2  (Deep * const me, QEvt const * const e);
+static QState Deep_b1  (Deep * const me, QEvt const * const e);
+static QState Deep_b2  (Deep * const me, QEvt const * const e);
+
+/*..........................................................................*/
+/* folds the entry (id) or exit (id + 16) of a state into the checksum */
+static void Deep_trace(Deep * const me, uint32_t id) {
+    me->trace = (me->trace * 31U) + id;
+}
+
+/* every state handles entry/exit the same way ==============================*/
+#define DEEP_STATE_(name_, id_, super_, timeout_)     \
+static QState Deep_##name_(Deep * const me, QEvt const * const e) { \
+    QState status;                                    \
+    ++me->calls;                                      \
+    switch (e->sig) {                                 \
+        case Q_ENTRY_SIG: {                           \
+            Deep_trace(me, (id_));                    \
+            status = Q_HANDLED();                     \
+            break;                                    \
+        }                                             \
+        case Q_EXIT_SIG: {                            \
+            Deep_trace(me, (id_) + 16U);              \
+            status = Q_HANDLED();                     \
+            break;                                    \
+        }                                             \
+        timeout_                                      \
+        default: {                                    \
+            status = Q_SUPER(super_);                 \
+            break;                                    \
+        }                                             \
+    }                                                 \
+    return status;                                    \
+}
+
+#define NO_TIMEOUT_
+#define TIMEOUT_TRAN_(target_)                        \
+        case TIMEOUT_SIG: {                           \
+            status = Q_TRAN(target_);                 \
+            break;                                    \
+        }
+
+DEEP_STATE_(s1,   1U, &QHsm_top,  NO_TIMEOUT_)
+DEEP_STATE_(s11,  2U, &Deep_s1,   NO_TIMEOUT_)
+DEEP_STATE_(s111, 3U, &Deep_s11,  NO_TIMEOUT_)
+DEEP_STATE_(a1,   4U, &Deep_s111, NO_TIMEOUT_)
+DEEP_STATE_(a2,   5U, &Deep_a1,   TIMEOUT_TRAN_(&Deep_b2))
+DEEP_STATE_(b1,   6U, &Deep_s111, TIMEOUT_TRAN_(&Deep_a2))
+DEEP_STATE_(b2,   7U, &Deep_b1,   NO_TIMEOUT_)
+
+/*..........................................................................*/
+static QState Deep_initial(Deep * const me, void const * const par) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Deep_a2);
+}
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+}
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+    QHsm_ctor(&l_deep.super, Q_STATE_CAST(&Deep_initial));
+#ifdef QHSM_TRAN_CACHE
+    QHsm_setTranCache(&l_deep.super, &l_deepCache);
+#endif
+    QASM_INIT(&l_deep.super, (void *)0, 0U);
+    l_deep.trace = 0U;
+    l_deep.calls = 0U;
+
+    uint64_t const t0 = now_ns();
+    for (uint32_t k = 0U; k < BENCH_EVENTS; ++k) {
+        QASM_DISPATCH(&l_deep.super, &l_timeoutEvt, 0U);
+    }
+    uint64_t const dt = now_ns() - t0;
+
+    /* an even number of toggles ends up in the initial leaf state */
+    Q_ASSERT(QHsm_state(&l_deep.super) == Q_STATE_CAST(&Deep_a2));
+
+    printf("{\"bench\":\"hsm_tran_cache\",\"mode\":\"%s\",\"events\":%u,"
+           "\"calls_per_evt\":%.2f,\"ns_per_evt\":%.2f,\"trace\":%u}\n",
+           BENCH_MODE, (unsigned)BENCH_EVENTS,
+           (double)l_deep.calls / (double)BENCH_EVENTS,
+           (double)dt / (double)BENCH_EVENTS, (unsigned)l_deep.trace);
+    return 0;
+}
@@ -0,0 +1,180 @@
+/******************************************************************************
+* @file    isr_ring_stress.c
+* @brief   Stress test of the lock-free ISR-to-AO ingress rings (QV kernel)
+*
+* Two producer P-threads stand in for two ISRs. Each producer posts a long
+* sequence of immutable events with QACTIVE_POST_FROM_ISR() into the small
+* ISR ring of its own consumer active object. The producers never take the
+* QF critical section to publish an event; the QV event loop drains the
+* rings into the regular event queues. Every consumer AO checks that it
+* receives all the events exactly once and in the FIFO order. A producer
+* that finds its ring full spins and retries, so the rings wrap around and
+* run full many times.
+*
+* Build (from the repository root):
+*   gcc -O2 -DQACTIVE_ISR_RING -Iqpc/include -Iqpc/ports/posix/qv \
+*       qpc/src/qf/q*.c qpc/src/qv/qv.c qpc/ports/posix/qv/qv_port.c \
+*       bench/isr_ring_stress.c -o isr_ring_stress -lpthread
+*
+* Usage:
+*   ./isr_ring_stress [events]    (default: 2000000 events per producer)
+*
+* Output: one JSON object, e.g.
+*   {"bench":"isr_ring_stress","producers":2,"events":..,"ring_full":..,
+*    "errors":0,"evt_per_sec":..}
+* The exit status is non-zero when any event is lost, duplicated or
+* reordered.
+******************************************************************************/
+#include "qpc.h"
+
+#define BENCH_QF_ON_STARTUP /* starts the producer threads */
+#define BENCH_QF_ON_CLEANUP /* reports and exits */
+#include "bench.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("isr_ring_stress")
+
+#ifndef QACTIVE_ISR_RING
+    #error "isr_ring_stress requires QACTIVE_ISR_RING"
+#endif
+
+#define N_PRODUCERS  2U
+#define N_SEQ_EVT    256U /* distinct events, the pointer encodes the seq. */
+#define RING_LEN     16U  /* small ring to make it wrap and run full */
+
+enum BenchSignals {
+    SAMPLE_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+typedef struct {
+    QActive super;     /* inherits QActive */
+    QEvt const *seq;   /* the sequence of events of this consumer */
+    uint32_t nRecv;    /* number of events received */
+    uint32_t nErr;     /* number of events out of order */
+} Consumer;
+
+static Consumer l_cons[N_PRODUCERS];
+static QEvt const *l_consQueue[N_PRODUCERS][64];
+static QEvt const *l_consRing[N_PRODUCERS][RING_LEN];
+static QEvt l_seqEvt[N_PRODUCERS][N_SEQ_EVT];
+
+static uint32_t l_nEvents = 2000000U;
+static atomic_uint_fast64_t l_ringFull;
+static uint32_t l_nDone; /* consumers done (QV thread only) */
+static uint64_t l_t0;
+
+/*..........................................................................*/
+static void *producer_thread(void *arg) {
+    Consumer * const c = (Consumer *)arg;
+    uint64_t nFull = 0U;
+    for (uint32_t i = 0U; i < l_nEvents; ++i) {
+        QEvt const * const e = &c->seq[i % N_SEQ_EVT];
+        while (!QACTIVE_POST_FROM_ISR(&c->super, e)) { /* ring full? */
+            ++nFull;
+            sched_yield();
+        }
+    }
+    atomic_fetch_add(&l_ringFull, nFull);
+    return (void *)0;
+}
+/*..........................................................................*/
+static void report(void) {
+    uint64_t const dt = now_ns() - l_t0;
+    uint32_t nErr = 0U;
+    uint64_t nRecv = 0U;
+    for (uint_fast8_t n = 0U; n < N_PRODUCERS; ++n) {
+        nErr  += l_cons[n].nErr;
+        nRecv += l_cons[n].nRecv;
+    }
+    printf("{\"bench\":\"isr_ring_stress\",\"producers\":%u,"
+           "\"events\":%llu,\"ring_full\":%llu,\"errors\":%u,"
+           "\"evt_per_sec\":%.0f}\n",
+           (unsigned)N_PRODUCERS, (unsigned long long)nRecv,
+           (unsigned long long)atomic_load(&l_ringFull), (unsigned)nErr,
+           (double)nRecv * 1e9 / (double)dt);
+    fflush(stdout);
+}
+
+/*..........................................................................*/
+static QState Consumer_active(Consumer * const me, QEvt const * const e) {
+    QState status;
+    switch (e->sig) {
+        case SAMPLE_SIG: {
+            if (e != &me->seq[me->nRecv % N_SEQ_EVT]) {
+                ++me->nErr; /* lost, duplicated or reordered event */
+            }
+            ++me->nRecv;
+            if (me->nRecv == l_nEvents) {
+                if (++l_nDone == N_PRODUCERS) {
+                    QF_stop();
+                }
+            }
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+static QState Consumer_initial(Consumer * const me, void const * const par) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Consumer_active);
+}
+
+/* QF callbacks ============================================================*/
+void QF_onStartup(void) {
+    QF_setTickRate(0U, 0); /* no ticker thread */
+
+    static pthread_t producer[N_PRODUCERS];
+    l_t0 = now_ns();
+    for (uint_fast8_t n = 0U; n < N_PRODUCERS; ++n) {
+        int const err = pthread_create(&producer[n], (pthread_attr_t *)0,
+                                       &producer_thread, &l_cons[n]);
+        Q_ASSERT(err == 0);
+    }
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+    report();
+    uint32_t nErr = 0U;
+    for (uint_fast8_t n = 0U; n < N_PRODUCERS; ++n) {
+        nErr += l_cons[n].nErr;
+    }
+    exit((nErr == 0U) ? 0 : 1);
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+}
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    if (argc > 1) {
+        l_nEvents = (uint32_t)strtoul(argv[1], (char **)0, 10);
+        Q_ASSERT(l_nEvents > 0U);
+    }
+
+    QF_init();
+    for (uint_fast8_t n = 0U; n < N_PRODUCERS; ++n) {
+        for (uint_fast16_t i = 0U; i < N_SEQ_EVT; ++i) {
+            QEvt_ctor(&l_seqEvt[n][i], SAMPLE_SIG);
+        }
+        QActive_ctor(&l_cons[n].super, Q_STATE_CAST(&Consumer_initial));
+        l_cons[n].seq = &l_seqEvt[n][0];
+        QActive_setIsrRing(&l_cons[n].super,
+                           l_consRing[n], Q_DIM(l_consRing[n]));
+        QACTIVE_START(&l_cons[n].super, n + 1U,
+                      l_consQueue[n], Q_DIM(l_consQueue[n]),
+                      (void *)0, 0U, (void *)0);
+    }
+    return QF_run();
+}
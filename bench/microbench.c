@@ -0,0 +1,353 @@
+/******************************************************************************
+* @file    microbench.c
+* @brief   Per-operation cost of the QEP/QF primitives (regression suite)
+*
+* Measures the average cost of the basic QEP/QF operations, each in
+* a tight loop over a batch and repeated BENCH_REPS times (the fastest
+* repetition is reported, which filters out the host scheduler noise):
+*  - QActive_post_ and QActive_postLIFO_: a batch of posts into an empty
+*    queue, and QActive_get_: draining the batch again;
+*  - QHsm_dispatch_ and QMsm_dispatch_: the TimeBomb script of
+*    bench/timebomb_sm.c through bench/timebomb_qhsm.c and the generated
+*    bench/timebomb_qmsm.c (including the time event armed on entry);
+*  - QTimeEvt_armX + QTimeEvt_disarm pairs, and QTimeEvt_tick_ with
+*    BENCH_TE_ARMED time events armed (none expiring);
+*  - QMPool_get + QMPool_put pairs and QF_newX_ + QF_gc pairs;
+*  - QActive_publish_ of an immutable event to BENCH_SUBSCR subscribers.
+* The AOs are started but QF_run() is never called, so the QK scheduler
+* stays locked and the queues are drained by QActive_get_().
+*
+* The same source is built in four configurations, QS tracing off/on
+* (Q_SPY, with all the QS records enabled and written to /dev/null) and
+* the assertions on/off (Q_UNSAFE), which the "qs" and "unsafe" fields
+* tell apart. tools/microbench.py builds and runs all four and collects
+* the results in one JSON file, which can be compared with the results of
+* an earlier QP/C version (--baseline).
+*
+* Build (from the repository root), e.g. QS on and assertions off:
+*   gcc -O2 -DQ_SPY -DQ_UNSAFE -Iqpc/include -Iqpc/ports/posix/qk \
+*       -IApplication -Ibench \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       qpc/ports/posix/qk/qs_port.c QS/qs*.c \
+*       bench/timebomb_qhsm.c bench/timebomb_qmsm.c bench/microbench.c \
+*       -o microbench_qs_unsafe
+*   (without -DQ_SPY leave out qs_port.c and QS/qs*.c)
+*
+* Usage:
+*   ./microbench_qs_unsafe
+*   python3 tools/microbench.py [--out microbench.json] [--baseline FILE]
+*
+* Output: one JSON object per line, e.g.
+*   {"bench":"microbench","qs":"on","unsafe":"off","op":"QActive_post_",
+*    "n":..,"ns_per_op":..,"mops_per_sec":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bsp.h"
+#include "timebomb_qhsm.h"
+#include "timebomb_qmsm.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("microbench")
+
+#define BENCH_REPS      5U     /* repetitions of every measurement */
+#define BENCH_OPS       (2U * 1000U * 1000U) /* operations per repetition */
+#define BENCH_QLEN      128U   /* posts per batch (queue length) */
+#define BENCH_CYCLES    (BENCH_OPS / 14U) /* TimeBomb script cycles */
+#define BENCH_TE_ARMED  16U    /* armed time events during the ticks */
+#define BENCH_SUBSCR    4U     /* subscribers of the published event */
+
+#ifdef Q_SPY
+    #define BENCH_QS "on"
+#else
+    #define BENCH_QS "off"
+#endif
+#ifdef Q_UNSAFE
+    #define BENCH_UNSAFE "on"
+#else
+    #define BENCH_UNSAFE "off"
+#endif
+
+enum BenchSignals {
+    SAMPLE_SIG = MAX_SIG, /* after the TimeBomb signals */
+    TICK_SIG,
+    PUBLISHED_SIG,
+    BENCH_MAX_SIG
+};
+
+static QActive l_sink; /* receives the posts, owns the time events */
+static QEvt const *l_sinkQueueSto[BENCH_QLEN + 1U];
+static QActive l_subscr[BENCH_SUBSCR];
+static QEvt const *l_subscrQueueSto[BENCH_SUBSCR][BENCH_QLEN + 1U];
+static QSubscrList l_subscrSto[BENCH_MAX_SIG];
+
+static TimeBomb   l_qhsm;
+static TimeBombQM l_qmsm;
+
+static QTimeEvt l_te[BENCH_TE_ARMED + 1U];
+
+static QMPool l_mpool;
+static QF_MPOOL_EL(QEvt) l_mpoolSto[16];
+static QF_MPOOL_EL(QEvt) l_evtPoolSto[16];
+
+static QEvt const l_sampleEvt   = QEVT_INITIALIZER(SAMPLE_SIG);
+static QEvt const l_publishEvt  = QEVT_INITIALIZER(PUBLISHED_SIG);
+static QEvt const l_buttonEvt   = QEVT_INITIALIZER(BUTTON_PRESSED_SIG);
+static QEvt const l_releaseEvt  = QEVT_INITIALIZER(BUTTON_RELEASED_SIG);
+static QEvt const l_button2Evt  = QEVT_INITIALIZER(BUTTON2_PRESSED_SIG);
+static QEvt const l_timeoutEvt  = QEVT_INITIALIZER(TIMEOUT_SIG);
+
+/* stub BSP for the TimeBomb ===============================================*/
+void BSP_ledRedOn(void)    {}
+void BSP_ledRedOff(void)   {}
+void BSP_ledBlueOn(void)   {}
+void BSP_ledBlueOff(void)  {}
+void BSP_ledGreenOn(void)  {}
+void BSP_ledGreenOff(void) {}
+
+/*..........................................................................*/
+static void report(char const *op, uint32_t n, uint64_t dt) {
+    double const ns = (double)dt / (double)n;
+    printf("{\"bench\":\"microbench\",\"qs\":\"%s\",\"unsafe\":\"%s\","
+           "\"op\":\"%s\",\"n\":%u,\"ns_per_op\":%.2f,"
+           "\"mops_per_sec\":%.2f}\n",
+           BENCH_QS, BENCH_UNSAFE, op, (unsigned)n, ns, 1000.0 / ns);
+}
+/*..........................................................................*/
+/* the fastest of BENCH_REPS runs of the statement in the variadic part,
+* which does n_ operations and accumulates its own time into dt_
+*/
+#define BENCH_BEST(op_, n_, dt_, ...) do { \
+    uint64_t best_ = ~(uint64_t)0U; \
+    for (uint_fast8_t rep_ = 0U; rep_ < BENCH_REPS; ++rep_) { \
+        (dt_) = 0U; \
+        __VA_ARGS__; \
+        if ((dt_) < best_) { \
+            best_ = (dt_); \
+        } \
+    } \
+    report((op_), (n_), best_); \
+} while (false)
+
+/* QActive_post_/postLIFO_/get_ ============================================*/
+static void drain(QActive * const me, uint64_t * const dt) {
+    uint64_t const t0 = now_ns();
+    for (uint_fast16_t i = 0U; i < BENCH_QLEN; ++i) {
+        QEvt const * const e = QActive_get_(me);
+        Q_ASSERT(e == &l_sampleEvt);
+    #ifdef Q_UNSAFE
+        Q_UNUSED_PAR(e);
+    #endif
+    }
+    *dt += now_ns() - t0;
+}
+static void bench_post(void) {
+    uint64_t dt;
+    uint64_t dtGet;
+    uint32_t const nBatch = BENCH_OPS / BENCH_QLEN;
+    uint32_t const n = nBatch * BENCH_QLEN;
+
+    uint64_t bestGet = ~(uint64_t)0U;
+    BENCH_BEST("QActive_post_", n, dt, {
+        dtGet = 0U;
+        for (uint32_t k = 0U; k < nBatch; ++k) {
+            uint64_t const t0 = now_ns();
+            for (uint_fast16_t i = 0U; i < BENCH_QLEN; ++i) {
+                QACTIVE_POST(&l_sink, &l_sampleEvt, (void *)0);
+            }
+            dt += now_ns() - t0;
+            drain(&l_sink, &dtGet);
+        }
+        if (dtGet < bestGet) {
+            bestGet = dtGet;
+        }
+    });
+    report("QActive_get_", n, bestGet);
+
+    BENCH_BEST("QActive_postLIFO_", n, dt, {
+        dtGet = 0U;
+        for (uint32_t k = 0U; k < nBatch; ++k) {
+            uint64_t const t0 = now_ns();
+            for (uint_fast16_t i = 0U; i < BENCH_QLEN; ++i) {
+                QACTIVE_POST_LIFO(&l_sink, &l_sampleEvt);
+            }
+            dt += now_ns() - t0;
+            drain(&l_sink, &dtGet);
+        }
+    });
+}
+
+/* QHsm_dispatch_/QMsm_dispatch_ ===========================================*/
+static uint64_t run_script(QAsm * const sm, QTimeEvt * const te) {
+    uint64_t const t0 = now_ns();
+    for (uint32_t k = 0U; k < BENCH_CYCLES; ++k) {
+        QASM_DISPATCH(sm, &l_buttonEvt, 0U);
+        for (uint_fast8_t i = 0U; i < 10U; ++i) {
+            (void)QTimeEvt_disarm(te); /* the time event "expired" */
+            QASM_DISPATCH(sm, &l_timeoutEvt, 0U);
+        }
+        QASM_DISPATCH(sm, &l_releaseEvt, 0U); /* ignored */
+        QASM_DISPATCH(sm, &l_button2Evt, 0U); /* -> defused */
+        QASM_DISPATCH(sm, &l_button2Evt, 0U); /* -> armed/wait4button */
+    }
+    return now_ns() - t0;
+}
+static void bench_dispatch(void) {
+    uint64_t dt;
+    QASM_INIT(&l_qhsm.super.super, (void *)0, 0U);
+    BENCH_BEST("QHsm_dispatch_", BENCH_CYCLES * 14U, dt,
+        dt = run_script(&l_qhsm.super.super, &l_qhsm.te));
+    QASM_INIT(&l_qmsm.super.super.super, (void *)0, 0U);
+    BENCH_BEST("QMsm_dispatch_", BENCH_CYCLES * 14U, dt,
+        dt = run_script(&l_qmsm.super.super.super, &l_qmsm.te));
+    (void)QTimeEvt_disarm(&l_qhsm.te);
+    (void)QTimeEvt_disarm(&l_qmsm.te);
+}
+
+/* QTimeEvt_armX/disarm/tick_ ==============================================*/
+static void bench_timeEvt(void) {
+    uint64_t dt;
+    QTimeEvt * const te = &l_te[BENCH_TE_ARMED];
+    BENCH_BEST("QTimeEvt_armX+disarm", BENCH_OPS, dt, {
+        uint64_t const t0 = now_ns();
+        for (uint32_t k = 0U; k < BENCH_OPS; ++k) {
+            QTimeEvt_armX(te, 100U, 0U);
+            (void)QTimeEvt_disarm(te);
+        }
+        dt = now_ns() - t0;
+    });
+
+    for (uint_fast8_t i = 0U; i < BENCH_TE_ARMED; ++i) {
+        QTimeEvt_armX(&l_te[i], (QTimeEvtCtr)(100000000U + i), 0U);
+    }
+    BENCH_BEST("QTimeEvt_tick_", BENCH_OPS, dt, {
+        uint64_t const t0 = now_ns();
+        for (uint32_t k = 0U; k < BENCH_OPS; ++k) {
+            QTIMEEVT_TICK_X(0U, &l_sink);
+        }
+        dt = now_ns() - t0;
+    });
+    for (uint_fast8_t i = 0U; i < BENCH_TE_ARMED; ++i) {
+        (void)QTimeEvt_disarm(&l_te[i]);
+    }
+}
+
+/* QMPool_get/put and QF_newX_/QF_gc =======================================*/
+static void bench_pool(void) {
+    uint64_t dt;
+    BENCH_BEST("QMPool_get+put", BENCH_OPS, dt, {
+        uint64_t const t0 = now_ns();
+        for (uint32_t k = 0U; k < BENCH_OPS; ++k) {
+            void * const b = QMPool_get(&l_mpool, 0U, 0U);
+            QMPool_put(&l_mpool, b, 0U);
+        }
+        dt = now_ns() - t0;
+    });
+    BENCH_BEST("QF_newX_+QF_gc", BENCH_OPS, dt, {
+        uint64_t const t0 = now_ns();
+        for (uint32_t k = 0U; k < BENCH_OPS; ++k) {
+            QEvt * const e = QF_newX_(sizeof(QEvt), QF_NO_MARGIN, SAMPLE_SIG);
+            QF_gc(e);
+        }
+        dt = now_ns() - t0;
+    });
+}
+
+/* QActive_publish_ ========================================================*/
+static void bench_publish(void) {
+    uint64_t dt;
+    uint32_t const nBatch = BENCH_OPS / BENCH_QLEN / BENCH_SUBSCR;
+    uint32_t const n = nBatch * BENCH_QLEN;
+    BENCH_BEST("QActive_publish_", n, dt, {
+        for (uint32_t k = 0U; k < nBatch; ++k) {
+            uint64_t const t0 = now_ns();
+            for (uint_fast16_t i = 0U; i < BENCH_QLEN; ++i) {
+                QACTIVE_PUBLISH(&l_publishEvt, &l_sink);
+            }
+            dt += now_ns() - t0;
+            for (uint_fast8_t s = 0U; s < BENCH_SUBSCR; ++s) {
+                for (uint_fast16_t i = 0U; i < BENCH_QLEN; ++i) {
+                    (void)QActive_get_(&l_subscr[s]);
+                }
+            }
+        }
+    });
+}
+
+/*..........................................................................*/
+static QState Sink_idle(QActive * const me, QEvt const * const e) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(e);
+    return Q_SUPER(&QHsm_top);
+}
+static QState Sink_initial(QActive * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+    if (me != &l_sink) { /* one of the subscribers? */
+        QActive_subscribe(me, PUBLISHED_SIG);
+    }
+    return Q_TRAN(&Sink_idle);
+}
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+}
+
+#ifdef Q_SPY
+/* QS callbacks ============================================================*/
+void QS_onReset(void) {
+    exit(0);
+}
+/*..........................................................................*/
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    Q_UNUSED_PAR(cmdId);
+    Q_UNUSED_PAR(param1);
+    Q_UNUSED_PAR(param2);
+    Q_UNUSED_PAR(param3);
+}
+#endif /* Q_SPY */
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+#ifdef Q_SPY
+    if (QS_INIT("/dev/null") == 0U) {
+        Q_ERROR();
+    }
+    /* all the QS records of all the objects go to the QS buffer */
+    QS_GLB_FILTER(QS_ALL_RECORDS);
+    QS_LOC_FILTER(QS_ALL_IDS);
+#endif
+    QActive_psInit(l_subscrSto, Q_DIM(l_subscrSto));
+    QF_poolInit(l_evtPoolSto, sizeof(l_evtPoolSto), sizeof(l_evtPoolSto[0]));
+    QMPool_init(&l_mpool, l_mpoolSto, sizeof(l_mpoolSto),
+                sizeof(l_mpoolSto[0]));
+
+    /* the AOs are started, but never run (QF_run() is not called) */
+    QActive_ctor(&l_sink, Q_STATE_CAST(&Sink_initial));
+    QACTIVE_START(&l_sink, 1U, l_sinkQueueSto, Q_DIM(l_sinkQueueSto),
+                  (void *)0, 0U, (void *)0);
+    for (uint_fast8_t s = 0U; s < BENCH_SUBSCR; ++s) {
+        QActive_ctor(&l_subscr[s], Q_STATE_CAST(&Sink_initial));
+        QACTIVE_START(&l_subscr[s], (uint_fast8_t)(s + 2U),
+                      l_subscrQueueSto[s], Q_DIM(l_subscrQueueSto[s]),
+                      (void *)0, 0U, (void *)0);
+    }
+    for (uint_fast8_t i = 0U; i < Q_DIM(l_te); ++i) {
+        QTimeEvt_ctorX(&l_te[i], &l_sink, TICK_SIG, 0U);
+    }
+
+    /* the state machines are dispatched directly */
+    TimeBomb_ctor(&l_qhsm);
+    TimeBombQM_ctor(&l_qmsm);
+
+    bench_post();
+    bench_dispatch();
+    bench_timeEvt();
+    bench_pool();
+    bench_publish();
+    return 0;
+}
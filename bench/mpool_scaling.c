@@ -0,0 +1,140 @@
+/******************************************************************************
+* @file    mpool_scaling.c
+* @brief   Q_NEW()/QF_gc() throughput from 1 to 32 threads, locked vs
+*          lock-free event pool (QF_MPOOL_LOCKFREE)
+*
+* T worker P-threads (T = 1, 2, 4, 8, 16, 32) allocate and recycle dynamic
+* events from one shared event pool of the multi-threaded POSIX port
+* (qpc/ports/posix/mt) as fast as they can: every iteration allocates
+* BENCH_HOLD events with Q_NEW(), stamps them with the thread id, checks
+* the stamps and recycles them with QF_gc(). Without QF_MPOOL_LOCKFREE,
+* every QMPool_get()/QMPool_put() and every QF_gc() takes the global
+* critical-section mutex of the port; with QF_MPOOL_LOCKFREE the pool is
+* a lock-free Treiber stack and QF_gc() counts the references with
+* atomics. The same source is built twice and the "mode" field tells the
+* two apart. The benchmark also checks that no block was ever handed out
+* twice (the stamps), and that all blocks are back in the pool at the end.
+*
+* Build (from the repository root):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/mt \
+*       qpc/src/qf/q*.c qpc/ports/posix/mt/qf_port.c \
+*       bench/mpool_scaling.c -o mpool_locked -lpthread
+*   gcc -O2 -DQF_MPOOL_LOCKFREE -Iqpc/include -Iqpc/ports/posix/mt \
+*       qpc/src/qf/q*.c qpc/ports/posix/mt/qf_port.c \
+*       bench/mpool_scaling.c -o mpool_lockfree -lpthread
+*
+* Usage:
+*   ./mpool_locked; ./mpool_lockfree
+*
+* Output: one JSON object per line, e.g.
+*   {"bench":"mpool_scaling","mode":"lockfree","threads":8,"pairs":..,
+*    "mpairs_per_sec":..,"ns_per_pair":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("mpool_scaling")
+
+#define BENCH_MAX_THREADS 32U
+#define BENCH_PAIRS       (4U * 1000U * 1000U) /* Q_NEW+QF_gc pairs per run */
+#define BENCH_HOLD        4U  /* events held by a thread at a time */
+
+#ifdef QF_MPOOL_LOCKFREE
+    #define BENCH_MODE "lockfree"
+#else
+    #define BENCH_MODE "locked"
+#endif
+
+enum BenchSignals {
+    SAMPLE_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;
+    uint32_t owner; /* stamp of the allocating thread */
+} SampleEvt;
+
+/* every thread can hold BENCH_HOLD events at a time */
+static QF_MPOOL_EL(SampleEvt) l_pool[BENCH_MAX_THREADS * BENCH_HOLD];
+
+static pthread_t l_thread[BENCH_MAX_THREADS];
+static uint32_t  l_pairsPerThread;
+static atomic_bool l_go;
+
+/*..........................................................................*/
+static void *worker(void *arg) {
+    uint32_t const id = (uint32_t)(uintptr_t)arg;
+    SampleEvt *held[BENCH_HOLD];
+
+    while (!atomic_load(&l_go)) {
+        /* wait for the start */
+    }
+    for (uint32_t k = 0U; k < l_pairsPerThread; k += BENCH_HOLD) {
+        for (uint_fast8_t i = 0U; i < BENCH_HOLD; ++i) {
+            held[i] = Q_NEW(SampleEvt, SAMPLE_SIG);
+            held[i]->owner = id;
+        }
+        for (uint_fast8_t i = 0U; i < BENCH_HOLD; ++i) {
+            /* nobody else may have got the same block meanwhile */
+            Q_ASSERT(held[i]->owner == id);
+            QF_gc(&held[i]->super);
+        }
+    }
+    return (void *)0;
+}
+/*..........................................................................*/
+static void bench(uint32_t const nThreads) {
+    l_pairsPerThread = BENCH_PAIRS / nThreads;
+    atomic_store(&l_go, false);
+    for (uint32_t t = 0U; t < nThreads; ++t) {
+        int const err = pthread_create(&l_thread[t], (pthread_attr_t *)0,
+                                       &worker, (void *)(uintptr_t)(t + 1U));
+        Q_ASSERT(err == 0);
+        Q_UNUSED_PAR(err); /* if Q_ASSERT() is disabled (Q_UNSAFE) */
+    }
+    uint64_t const t0 = now_ns();
+    atomic_store(&l_go, true);
+    for (uint32_t t = 0U; t < nThreads; ++t) {
+        (void)pthread_join(l_thread[t], (void **)0);
+    }
+    uint64_t const dt = now_ns() - t0;
+
+    /* all the blocks must be back in the pool */
+    static SampleEvt *all[Q_DIM(l_pool)];
+    for (uint_fast16_t i = 0U; i < Q_DIM(l_pool); ++i) {
+        all[i] = Q_NEW_X(SampleEvt, 0U, SAMPLE_SIG);
+        Q_ASSERT(all[i] != (SampleEvt *)0);
+    }
+    SampleEvt const * const extra = Q_NEW_X(SampleEvt, 0U, SAMPLE_SIG);
+    Q_ASSERT(extra == (SampleEvt *)0);
+    Q_UNUSED_PAR(extra);
+    for (uint_fast16_t i = 0U; i < Q_DIM(l_pool); ++i) {
+        QF_gc(&all[i]->super);
+    }
+
+    uint32_t const pairs = l_pairsPerThread * nThreads;
+    printf("{\"bench\":\"mpool_scaling\",\"mode\":\"%s\",\"threads\":%u,"
+           "\"pairs\":%u,\"mpairs_per_sec\":%.2f,\"ns_per_pair\":%.2f}\n",
+           BENCH_MODE, (unsigned)nThreads, (unsigned)pairs,
+           (double)pairs * 1000.0 / (double)dt, (double)dt / (double)pairs);
+}
+
+/* QF callbacks ============================================================*/
+void QF_onClockTick(void) {
+}
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+    QF_poolInit(l_pool, sizeof(l_pool), sizeof(l_pool[0]));
+
+    for (uint32_t n = 1U; n <= BENCH_MAX_THREADS; n *= 2U) {
+        bench(n);
+    }
+    return 0;
+}
@@ -0,0 +1,220 @@
+/******************************************************************************
+* @file    mt_throughput.c
+* @brief   Throughput and delivery latency of the multi-threaded POSIX port
+*
+* A ring of N "Relay" active objects, each running in its own P-thread
+* (qpc/ports/posix/mt), passes dynamic TOKEN events to the next AO in the
+* ring. Every token carries the time when it was posted, so the receiving
+* AO can measure the post-to-dispatch (delivery) latency. Every run is
+* executed in a separate child process, because QF cannot be restarted.
+*
+* The same benchmark runs on the work-stealing scheduler (qpc/ports/posix/ws)
+* when built with that port instead (-Iqpc/ports/posix/ws and its qf_port.c).
+*
+* Build (from the repository root):
+*   gcc -O2 -DQF_MAX_ACTIVE=64U -DQF_EQUEUE_CTR_SIZE=2U \
+*       -Iqpc/include -Iqpc/ports/posix/mt \
+*       qpc/src/qf/q*.c qpc/ports/posix/mt/qf_port.c bench/mt_throughput.c \
+*       -o mt_throughput -lpthread
+*
+* Usage:
+*   ./mt_throughput [nAO ...]     (default: 2 4 8 16 32 64)
+*
+* Output: one JSON object per line, e.g.
+*   {"bench":"mt_throughput","aos":8,"events":..,"evt_per_sec":..,
+*    "p50_ns":..,"p99_ns":..}
+******************************************************************************/
+#include "qpc.h"
+
+#define BENCH_QF_ON_STARTUP /* starts the ticker and the tokens */
+#include "bench.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+Q_DEFINE_THIS_MODULE("mt_throughput")
+
+#define BENCH_TICKS_PER_SEC 100U
+#define BENCH_DURATION      (2U * BENCH_TICKS_PER_SEC) /* 2 seconds */
+#define BENCH_TOKENS_PER_AO 4U     /* tokens circulating per AO */
+#define BENCH_LAT_SAMPLES   (1U << 15) /* latency samples kept per AO */
+
+#define MAX_AO              QF_MAX_ACTIVE
+#define MAX_TOKENS          (MAX_AO * BENCH_TOKENS_PER_AO)
+
+/* all the tokens might end up in one queue: the front event + the ring */
+#define QUEUE_LEN           (MAX_TOKENS - 1U)
+#if (QUEUE_LEN > 254U) && (QF_EQUEUE_CTR_SIZE == 1U)
+    #error "QUEUE_LEN exceeds the QEQueueCtr range, use QF_EQUEUE_CTR_SIZE=2"
+#endif
+
+enum BenchSignals {
+    TOKEN_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;       /* inherits QEvt */
+    uint64_t t_post;  /* time of posting [ns] */
+} TokenEvt;
+
+typedef struct {
+    QActive super;    /* inherits QActive */
+    uint8_t next;     /* index of the next AO in the ring */
+    atomic_uint_fast64_t nEvt; /* number of tokens received */
+    uint32_t nLat;    /* number of latency samples taken */
+    uint32_t lat[BENCH_LAT_SAMPLES]; /* cyclic buffer of latencies [ns] */
+} Relay;
+
+static Relay l_relay[MAX_AO];
+static QEvt const *l_relayQueue[MAX_AO][QUEUE_LEN];
+static QF_MPOOL_EL(TokenEvt) l_tokenPool[MAX_TOKENS + MAX_AO];
+
+static uint_fast8_t l_nAO;
+static uint32_t     l_ticks;
+static atomic_bool  l_done;
+static uint64_t     l_t0;
+static uint64_t     l_t1;
+
+/*..........................................................................*/
+static void post_token(uint_fast8_t const n) {
+    TokenEvt *te = Q_NEW(TokenEvt, TOKEN_SIG);
+    te->t_post = now_ns();
+    QACTIVE_POST(&l_relay[n].super, &te->super, (void *)0);
+}
+
+/* Relay state machine =====================================================*/
+static QState Relay_active(Relay * const me, QEvt const * const e);
+
+static QState Relay_initial(Relay * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Relay_active);
+}
+
+static QState Relay_active(Relay * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case TOKEN_SIG: {
+            uint64_t const lat = now_ns() - Q_EVT_CAST(TokenEvt)->t_post;
+            me->lat[me->nLat % BENCH_LAT_SAMPLES] = (uint32_t)
+                ((lat < UINT32_MAX) ? lat : UINT32_MAX);
+            ++me->nLat;
+            atomic_fetch_add_explicit(&me->nEvt, 1U, memory_order_relaxed);
+            if (!atomic_load_explicit(&l_done, memory_order_relaxed)) {
+                post_token(me->next); /* pass the token on */
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/* QF callbacks ============================================================*/
+void QF_onStartup(void) {
+    QF_setTickRate(BENCH_TICKS_PER_SEC, 0);
+    l_t0 = now_ns();
+    for (uint_fast8_t n = 0U; n < l_nAO; ++n) {
+        for (uint_fast8_t k = 0U; k < BENCH_TOKENS_PER_AO; ++k) {
+            post_token(n);
+        }
+    }
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    ++l_ticks;
+    if (l_ticks == BENCH_DURATION) {
+        l_t1 = now_ns();
+        atomic_store(&l_done, true); /* stop circulating the tokens */
+        QF_stop();
+    }
+}
+
+/*..........................................................................*/
+static int cmp_u32(void const *a, void const *b) {
+    uint32_t const x = *(uint32_t const *)a;
+    uint32_t const y = *(uint32_t const *)b;
+    return (x > y) - (x < y);
+}
+
+/*..........................................................................*/
+static int run(uint_fast8_t const nAO) {
+    l_nAO = nAO;
+    QF_init();
+    QF_poolInit(l_tokenPool, sizeof(l_tokenPool), sizeof(l_tokenPool[0]));
+
+    for (uint_fast8_t n = 0U; n < nAO; ++n) {
+        Relay * const me = &l_relay[n];
+        QActive_ctor(&me->super, Q_STATE_CAST(&Relay_initial));
+        me->next = (uint8_t)((n + 1U) % nAO);
+        QACTIVE_START(&me->super,
+                      (QPrioSpec)(n + 1U),
+                      l_relayQueue[n],
+                      Q_DIM(l_relayQueue[n]),
+                      (void *)0, 0U,
+                      (void *)0);
+    }
+
+    (void)QF_run(); /* returns after QF_stop() */
+    usleep(20000U); /* let the AOs finish the tokens in flight */
+
+    uint64_t nEvt = 0U;
+    uint32_t nLat = 0U;
+    for (uint_fast8_t n = 0U; n < nAO; ++n) {
+        nEvt += atomic_load(&l_relay[n].nEvt);
+        nLat += ((l_relay[n].nLat < BENCH_LAT_SAMPLES)
+                 ? l_relay[n].nLat : BENCH_LAT_SAMPLES);
+    }
+    uint32_t *lat = malloc((size_t)nLat * sizeof(uint32_t));
+    Q_ASSERT(lat != (uint32_t *)0);
+    uint32_t k = 0U;
+    for (uint_fast8_t n = 0U; n < nAO; ++n) {
+        uint32_t const m = ((l_relay[n].nLat < BENCH_LAT_SAMPLES)
+                            ? l_relay[n].nLat : BENCH_LAT_SAMPLES);
+        memcpy(&lat[k], l_relay[n].lat, (size_t)m * sizeof(uint32_t));
+        k += m;
+    }
+    qsort(lat, nLat, sizeof(uint32_t), &cmp_u32);
+
+    double const secs = (double)(l_t1 - l_t0) / 1e9;
+    printf("{\"bench\":\"mt_throughput\",\"aos\":%u,\"events\":%llu,"
+           "\"evt_per_sec\":%.0f,\"p50_ns\":%u,\"p99_ns\":%u}\n",
+           (unsigned)nAO, (unsigned long long)nEvt,
+           (double)nEvt / secs,
+           (nLat != 0U) ? lat[nLat / 2U] : 0U,
+           (nLat != 0U) ? lat[(uint32_t)(((uint64_t)nLat * 99U) / 100U)] : 0U);
+    fflush(stdout);
+    free(lat);
+    return 0;
+}
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static uint_fast8_t const defaults[] = { 2U, 4U, 8U, 16U, 32U, 64U };
+    int const nRuns = (argc > 1) ? (argc - 1) : (int)Q_DIM(defaults);
+
+    for (int i = 0; i < nRuns; ++i) {
+        unsigned long const nAO = (argc > 1)
+                                  ? strtoul(argv[i + 1], (char **)0, 10)
+                                  : defaults[i];
+        if ((nAO < 2U) || (nAO > MAX_AO)) {
+            fprintf(stderr, "nAO must be in 2..%u\n", (unsigned)MAX_AO);
+            return -1;
+        }
+        pid_t const pid = fork();
+        if (pid == 0) { /* child? */
+            return run((uint_fast8_t)nAO);
+        }
+        int status;
+        (void)waitpid(pid, &status, 0);
+    }
+    return 0;
+}
@@ -0,0 +1,209 @@
+/******************************************************************************
+* @file    multirate.c
+* @brief   Tick interrupts of one fast tick rate vs a gated second tick rate
+*
+* A "Blinker" AO starts a burst of 10 flashes (3 ms on, 7 ms off) every
+* 2 seconds, which needs 1 ms timeouts. The benchmark runs it in virtual
+* time (1 ms steps) in two configurations:
+*  - "single" (QF_MAX_TICK_RATE 1): the whole system ticks at 1 kHz, the
+*    2 s period is 2000 ticks;
+*  - "multi" (built with QF_MAX_TICK_RATE=2U and QF_ON_TICK_ACTIVE): the
+*    2 s period runs on the 100 Hz base rate (tick rate 0) and the flashes
+*    on the 1 kHz rate 1, whose timer (TIMER0A in Application/bsp.c) runs
+*    only while time events of rate 1 are armed: QF_onTickActive() starts
+*    it when the first one is armed and stops it when the last one is gone.
+* The simulated timer interrupts are counted. The stub "LED" folds every
+* flash together with its time [ms] into a checksum, and the two builds
+* must report the same "trace". After every millisecond, the benchmark also
+* checks that the fast timer runs exactly while rate 1 has time events, and
+* at the end, that no flash was lost.
+*
+* Build (from the repository root):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/multirate.c -o multirate_single
+*   gcc -O2 -DQF_MAX_TICK_RATE=2U -DQF_ON_TICK_ACTIVE \
+*       -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/multirate.c -o multirate_multi
+*
+* Usage:
+*   ./multirate_single; ./multirate_multi
+*
+* Output: one JSON object, e.g.
+*   {"bench":"multirate","mode":"multi","ms":..,"flashes":..,
+*    "tick_isrs":..,"tick_isrs_per_sec":..,"trace":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("multirate")
+
+#define BENCH_MS         (600U * 1000U) /* 10 virtual minutes */
+#define BASE_TICKS_PER_SEC 100U
+#define FAST_TICKS_PER_SEC 1000U
+#define BURST_PERIOD_MS  2000U
+#define BURST_FLASHES    10U
+#define FLASH_ON_MS      3U
+#define FLASH_OFF_MS     7U
+
+#if (QF_MAX_TICK_RATE > 1U)
+    #define BENCH_MODE "multi"
+    #define RATE_BASE  0U
+    #define RATE_FAST  1U
+    #define BASE_MS    (FAST_TICKS_PER_SEC / BASE_TICKS_PER_SEC)
+    #ifndef QF_ON_TICK_ACTIVE
+        #error the "multi" build gates the fast rate with QF_ON_TICK_ACTIVE
+    #endif
+#else
+    #define BENCH_MODE "single"
+    #define RATE_BASE  0U
+    #define RATE_FAST  0U
+    #define BASE_MS    1U /* the base rate is the fast rate */
+#endif
+
+enum BenchSignals {
+    BURST_SIG = Q_USER_SIG,
+    FLASH_SIG,
+    MAX_SIG
+};
+
+typedef struct {
+    QActive super;
+    QTimeEvt burstEvt; /* 2 s period, base rate */
+    QTimeEvt flashEvt; /* 1 ms resolution, fast rate */
+    uint32_t flashes;  /* LED toggles left in the burst */
+} Blinker;
+
+static Blinker l_blinker;
+static QEvt const *l_blinkerQueue[4];
+
+static uint32_t l_ms;          /* virtual time [ms] */
+static uint32_t l_tickIsrs;    /* tick interrupts (both rates) */
+static uint32_t l_nFlashes;
+static uint32_t l_trace;       /* checksum of the LED toggles and times */
+#if (QF_MAX_TICK_RATE > 1U)
+static bool     l_fastRunning; /* the fast timer (TIMER0A) runs? */
+#endif
+
+/*..........................................................................*/
+static void led(uint32_t on) {
+    l_trace = (l_trace * 31U) + (l_ms * 2U) + on;
+}
+
+/*..........................................................................*/
+static QState Blinker_active(Blinker * const me, QEvt const * const e) {
+    QState status;
+    switch (e->sig) {
+        case BURST_SIG: {
+            me->flashes = 2U * BURST_FLASHES;
+            led(1U);
+            ++l_nFlashes;
+            QTimeEvt_armX(&me->flashEvt, FLASH_ON_MS, 0U);
+            status = Q_HANDLED();
+            break;
+        }
+        case FLASH_SIG: {
+            --me->flashes;
+            if (me->flashes == 0U) { /* end of the burst */
+                led(0U);
+            }
+            else if ((me->flashes & 1U) != 0U) { /* turn off */
+                led(0U);
+                QTimeEvt_armX(&me->flashEvt, FLASH_OFF_MS, 0U);
+            }
+            else { /* turn on */
+                led(1U);
+                ++l_nFlashes;
+                QTimeEvt_armX(&me->flashEvt, FLASH_ON_MS, 0U);
+            }
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+static QState Blinker_initial(Blinker * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+    QTimeEvt_armX(&me->burstEvt, BURST_PERIOD_MS / BASE_MS,
+                  BURST_PERIOD_MS / BASE_MS);
+    return Q_TRAN(&Blinker_active);
+}
+
+/* QF callbacks ============================================================*/
+#ifdef QF_ON_TICK_ACTIVE
+/* called inside the critical section, as in Application/bsp.c */
+void QF_onTickActive(uint_fast8_t const tickRate, bool const active) {
+    if (tickRate == RATE_FAST) {
+        l_fastRunning = active; /* TIMER0->CTL on the target */
+    }
+}
+#endif
+/*..........................................................................*/
+void QK_onIdle(void) {
+    for (l_ms = 1U; l_ms <= BENCH_MS; ++l_ms) {
+#if (QF_MAX_TICK_RATE > 1U)
+        /* a fast timer started during this millisecond (re)starts with a
+        * full period, so it fires first, before the SysTick
+        */
+        if (l_fastRunning) { /* TIMER0A */
+            ++l_tickIsrs;
+            QK_ISR_ENTRY();
+            QTIMEEVT_TICK_X(RATE_FAST, (void *)0);
+            QK_ISR_EXIT();
+        }
+#endif
+        if ((l_ms % BASE_MS) == 0U) { /* SysTick */
+            ++l_tickIsrs;
+            QK_ISR_ENTRY();
+            QTIMEEVT_TICK_X(RATE_BASE, (void *)0);
+            QK_ISR_EXIT();
+        }
+#if (QF_MAX_TICK_RATE > 1U)
+        /* the fast timer runs exactly while rate 1 has time events */
+        Q_ASSERT(l_fastRunning == !QTimeEvt_noActive(RATE_FAST));
+#endif
+    }
+    --l_ms;
+
+    /* no lost timeouts: all the bursts are complete, except the one that
+    * started in the last millisecond and has flashed only once so far
+    */
+    Q_ASSERT(l_nFlashes
+             == ((((BENCH_MS / BURST_PERIOD_MS) - 1U) * BURST_FLASHES) + 1U));
+
+    printf("{\"bench\":\"multirate\",\"mode\":\"%s\",\"ms\":%u,"
+           "\"flashes\":%u,\"tick_isrs\":%u,\"tick_isrs_per_sec\":%.1f,"
+           "\"trace\":%u}\n",
+           BENCH_MODE, (unsigned)l_ms, (unsigned)l_nFlashes,
+           (unsigned)l_tickIsrs,
+           (double)l_tickIsrs * 1000.0 / (double)l_ms, (unsigned)l_trace);
+    exit(0);
+}
+/*..........................................................................*/
+static void error_ctx(void) { /* context of the error report */
+    fprintf(stderr, "  at %u ms\n", (unsigned)l_ms);
+}
+
+/*..........................................................................*/
+int main(void) {
+    BENCH_onErrorCtx = &error_ctx;
+    QF_init();
+
+    QActive_ctor(&l_blinker.super, Q_STATE_CAST(&Blinker_initial));
+    QTimeEvt_ctorX(&l_blinker.burstEvt, &l_blinker.super, BURST_SIG,
+                   RATE_BASE);
+    QTimeEvt_ctorX(&l_blinker.flashEvt, &l_blinker.super, FLASH_SIG,
+                   RATE_FAST);
+    QACTIVE_START(&l_blinker.super, 1U,
+                  l_blinkerQueue, Q_DIM(l_blinkerQueue),
+                  (void *)0, 0U, (void *)0);
+    return QF_run();
+}
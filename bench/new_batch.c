@@ -0,0 +1,145 @@
+/******************************************************************************
+* @file    new_batch.c
+* @brief   Batch allocation and recycling of dynamic events, one by one
+*          (Q_NEW()/QF_gc()) vs in bulk (Q_NEW_N()/QF_gcN())
+*
+* A producer builds batches of B = 4, 16 and 64 dynamic SAMPLE events, as
+* it would for every clock tick, fills them, checks them and recycles the
+* whole batch:
+*  - "single": B x Q_NEW() and B x QF_gc(), i.e., one critical section
+*    and one QS_QF_MPOOL_GET/PUT record per block;
+*  - "batch": one Q_NEW_N() and one QF_gcN(), i.e., one critical section
+*    and one QS_QF_MPOOL_GET/PUT record per batch.
+* The benchmark builds on any of the POSIX ports; the critical section of
+* the single-threaded QK simulation (qpc/ports/posix/qk) costs next to
+* nothing, while the multi-threaded port (qpc/ports/posix/mt) takes a
+* mutex, as a real critical section is not free either. At the end, the
+* benchmark checks that all the blocks are back in the pool.
+*
+* Build (from the repository root):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/new_batch.c -o new_batch_qk
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/mt \
+*       qpc/src/qf/q*.c qpc/ports/posix/mt/qf_port.c \
+*       bench/new_batch.c -o new_batch_mt -lpthread
+*
+* Usage:
+*   ./new_batch_qk; ./new_batch_mt
+*
+* Output: one JSON object per mode and batch size, e.g.
+*   {"bench":"new_batch","port":"qk","mode":"batch","batch":16,
+*    "events":..,"ns_per_event":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("new_batch")
+
+#ifdef QK_H_ /* QK kernel (posix/qk)? */
+    #define BENCH_PORT "qk"
+#else
+    #define BENCH_PORT "mt"
+#endif
+
+#define BENCH_EVENTS     (8U * 1024U * 1024U) /* events per run */
+#define BENCH_MAX_BATCH  64U
+
+enum BenchSignals {
+    SAMPLE_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+enum BenchModes {
+    MODE_SINGLE,
+    MODE_BATCH,
+    MODE_MAX
+};
+
+typedef struct {
+    QEvt super;
+    uint32_t value;
+} SampleEvt;
+
+static char const * const l_modeNames[MODE_MAX] = {
+    "single", "batch"
+};
+
+static QF_MPOOL_EL(SampleEvt) l_pool[BENCH_MAX_BATCH];
+static SampleEvt *l_batch[BENCH_MAX_BATCH];
+
+/*..........................................................................*/
+static void fill_check(uint_fast16_t const n, uint32_t const k) {
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        l_batch[i]->value = k + i;
+    }
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        Q_ASSERT((l_batch[i]->super.sig == SAMPLE_SIG)
+                 && (l_batch[i]->value == (k + i)));
+    }
+}
+/*..........................................................................*/
+static void bench(uint_fast8_t const mode, uint_fast16_t const n) {
+    uint32_t const batches = BENCH_EVENTS / n;
+    uint64_t const t0 = now_ns();
+    if (mode == MODE_SINGLE) {
+        for (uint32_t k = 0U; k < batches; ++k) {
+            for (uint_fast16_t i = 0U; i < n; ++i) {
+                l_batch[i] = Q_NEW(SampleEvt, SAMPLE_SIG);
+            }
+            fill_check(n, k);
+            for (uint_fast16_t i = 0U; i < n; ++i) {
+                QF_gc(&l_batch[i]->super);
+            }
+        }
+    }
+    else {
+        for (uint32_t k = 0U; k < batches; ++k) {
+            Q_NEW_N(SampleEvt, l_batch, n, SAMPLE_SIG);
+            fill_check(n, k);
+            QF_gcN((QEvt const **)l_batch, n);
+        }
+    }
+    uint64_t const dt = now_ns() - t0;
+
+    uint32_t const events = batches * n;
+    printf("{\"bench\":\"new_batch\",\"port\":\"%s\",\"mode\":\"%s\","
+           "\"batch\":%u,\"events\":%u,\"ns_per_event\":%.2f}\n",
+           BENCH_PORT, l_modeNames[mode], (unsigned)n, (unsigned)events,
+           (double)dt / (double)events);
+}
+/*..........................................................................*/
+static void check_pool(void) {
+    /* all the blocks must be back in the pool */
+    uint_fast16_t const n
+        = Q_NEW_N_X(SampleEvt, l_batch, BENCH_MAX_BATCH + 1U, 0U,
+                    SAMPLE_SIG);
+    Q_ASSERT(n == BENCH_MAX_BATCH);
+    QF_gcN((QEvt const **)l_batch, n);
+}
+
+/* QF callbacks ============================================================*/
+#ifdef QK_H_
+void QK_onIdle(void) { /* not used, no QF_run() */
+}
+#else
+void QF_onClockTick(void) {
+}
+#endif
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+    QF_poolInit(l_pool, sizeof(l_pool), sizeof(l_pool[0]));
+
+    for (uint_fast16_t n = 4U; n <= BENCH_MAX_BATCH; n *= 4U) {
+        for (uint_fast8_t m = 0U; m < MODE_MAX; ++m) {
+            bench(m, n);
+        }
+    }
+    check_pool();
+    return 0;
+}
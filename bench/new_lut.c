@@ -0,0 +1,146 @@
+/******************************************************************************
+* @file    new_lut.c
+* @brief   Cost of dynamic event allocation: pool scan vs size-class table
+*
+* Measures the average time of one Q_NEW()+QF_gc() pair for events that
+* come from each of the registered event pools, and of one QF_newX_() with
+* a run-time event size (as used by QS-RX). Without QF_EPOOL_LUT, the pool
+* is found by scanning the pools from the smallest; with QF_EPOOL_LUT, the
+* pool is taken from the size-class table built in QF_poolInit(), and for
+* Q_NEW() the table index is a compile-time constant. The same source is
+* built twice and the "mode" field tells the two apart. The benchmark also
+* checks that both modes pick exactly the same pool for every event size.
+*
+* The benchmark uses the single-threaded QK simulation (qpc/ports/posix/qk),
+* whose critical section is only a counter, so that the numbers reflect
+* the pool selection rather than the cost of a host mutex.
+*
+* Build (from the repository root):
+*   gcc -O2 -DQF_MAX_EPOOL=6U -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/new_lut.c -o new_scan
+*   gcc -O2 -DQF_MAX_EPOOL=6U -DQF_EPOOL_LUT -Iqpc/include \
+*       -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/new_lut.c -o new_lut
+*
+* Usage:
+*   ./new_scan; ./new_lut
+*
+* Output: one JSON object per line, e.g.
+*   {"bench":"new_lut","mode":"lut","alloc":"Q_NEW","pool":6,
+*    "ns_per_pair":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("new_lut")
+
+#define BENCH_PAIRS  (4U * 1000U * 1000U) /* Q_NEW+QF_gc pairs per run */
+
+#ifdef QF_EPOOL_LUT
+    #define BENCH_MODE "lut"
+#else
+    #define BENCH_MODE "scan"
+#endif
+
+#if (QF_MAX_EPOOL < 6U)
+    #error "new_lut requires QF_MAX_EPOOL >= 6U"
+#endif
+
+enum BenchSignals {
+    SAMPLE_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+/* event types of increasing size, one per event pool (the pool block
+* sizes are multiples of sizeof(QFreeBlock), which is 16 bytes on a 64-bit
+* host, so every type below lands in a pool of its own)
+*/
+typedef struct { QEvt super; uint8_t data[12];  } Evt1;
+typedef struct { QEvt super; uint8_t data[28];  } Evt2;
+typedef struct { QEvt super; uint8_t data[60];  } Evt3;
+typedef struct { QEvt super; uint8_t data[124]; } Evt4;
+typedef struct { QEvt super; uint8_t data[252]; } Evt5; /* beyond table */
+typedef struct { QEvt super; uint8_t data[508]; } Evt6; /* beyond table */
+
+static QF_MPOOL_EL(Evt1) l_pool1[4];
+static QF_MPOOL_EL(Evt2) l_pool2[4];
+static QF_MPOOL_EL(Evt3) l_pool3[4];
+static QF_MPOOL_EL(Evt4) l_pool4[4];
+static QF_MPOOL_EL(Evt5) l_pool5[4];
+static QF_MPOOL_EL(Evt6) l_pool6[4];
+
+static uint_fast16_t volatile l_rtSize; /* run-time event size */
+
+/*..........................................................................*/
+static void report(char const *alloc, unsigned pool, uint64_t dt) {
+    printf("{\"bench\":\"new_lut\",\"mode\":\"%s\",\"alloc\":\"%s\","
+           "\"pool\":%u,\"ns_per_pair\":%.2f}\n",
+           BENCH_MODE, alloc, pool, (double)dt / (double)BENCH_PAIRS);
+}
+/*..........................................................................*/
+#define BENCH_Q_NEW(evtT_, pool_) do { \
+    uint64_t const t0_ = now_ns(); \
+    for (uint32_t k_ = 0U; k_ < BENCH_PAIRS; ++k_) { \
+        evtT_ *e_ = Q_NEW(evtT_, SAMPLE_SIG); \
+        QF_gc(&e_->super); \
+    } \
+    report("Q_NEW", (pool_), now_ns() - t0_); \
+} while (false)
+
+/*..........................................................................*/
+static void bench_newX(unsigned pool, uint_fast16_t evtSize) {
+    l_rtSize = evtSize;
+    uint64_t const t0 = now_ns();
+    for (uint32_t k = 0U; k < BENCH_PAIRS; ++k) {
+        QEvt *e = QF_newX_(l_rtSize, QF_NO_MARGIN, SAMPLE_SIG);
+        QF_gc(e);
+    }
+    report("QF_newX_", pool, now_ns() - t0);
+}
+/*..........................................................................*/
+/* the pool must be the smallest that fits, exactly as the scan picks it */
+static void check_pool_selection(void) {
+    static uint_fast16_t const blockSize[] = {
+        sizeof(l_pool1[0]), sizeof(l_pool2[0]), sizeof(l_pool3[0]),
+        sizeof(l_pool4[0]), sizeof(l_pool5[0]), sizeof(l_pool6[0])
+    };
+    Q_ASSERT(QF_poolGetMaxBlockSize() == blockSize[Q_DIM(blockSize) - 1U]);
+    for (uint_fast16_t size = sizeof(QEvt);
+         size <= blockSize[Q_DIM(blockSize) - 1U]; ++size)
+    {
+        QEvt *e = QF_newX_(size, QF_NO_MARGIN, SAMPLE_SIG);
+        uint_fast8_t const poolId = QEvt_getPoolId_(e);
+        Q_ASSERT(size <= blockSize[poolId - 1U]);
+        Q_ASSERT((poolId == 1U) || (size > blockSize[poolId - 2U]));
+        QF_gc(e);
+    }
+}
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+}
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+    QF_poolInit(l_pool1, sizeof(l_pool1), sizeof(l_pool1[0]));
+    QF_poolInit(l_pool2, sizeof(l_pool2), sizeof(l_pool2[0]));
+    QF_poolInit(l_pool3, sizeof(l_pool3), sizeof(l_pool3[0]));
+    QF_poolInit(l_pool4, sizeof(l_pool4), sizeof(l_pool4[0]));
+    QF_poolInit(l_pool5, sizeof(l_pool5), sizeof(l_pool5[0]));
+    QF_poolInit(l_pool6, sizeof(l_pool6), sizeof(l_pool6[0]));
+
+    check_pool_selection();
+
+    BENCH_Q_NEW(Evt1, 1U);
+    BENCH_Q_NEW(Evt4, 4U);
+    BENCH_Q_NEW(Evt6, 6U);
+    bench_newX(1U, sizeof(Evt1));
+    bench_newX(4U, sizeof(Evt4));
+    return 0;
+}
@@ -0,0 +1,122 @@
+/******************************************************************************
+* @file    post_batch.c
+* @brief   Cost of posting a burst of events: QACTIVE_POST loop vs postN
+*
+* A burst of n immutable events is posted to one active object either with
+* a loop of n QACTIVE_POST() calls (n critical sections) or with a single
+* QACTIVE_POST_N() (one critical section). Only the posting is timed; the
+* queue is drained outside of the measurement with QActive_get_(), because
+* the AO never runs (QF_run() is not called). The benchmark uses the POSIX
+* QV port, where the QF critical section is a pthread mutex.
+*
+* Build (from the repository root):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qv \
+*       qpc/src/qf/q*.c qpc/src/qv/qv.c qpc/ports/posix/qv/qv_port.c \
+*       bench/post_batch.c -o post_batch -lpthread
+*
+* Usage:
+*   ./post_batch [n ...]          (default: 1 4 16 64)
+*
+* Output: one JSON object per line, e.g.
+*   {"bench":"post_batch","n":16,"loop_ns_per_evt":..,
+*    "postN_ns_per_evt":..,"speedup":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("post_batch")
+
+#define BENCH_ITER   20000U /* bursts per measurement */
+#define MAX_BURST    128U   /* maximum burst size */
+
+enum BenchSignals {
+    SAMPLE_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+static QActive l_sink;
+static QEvt const *l_sinkQueue[MAX_BURST];
+
+static QEvt const l_sampleEvt = QEVT_INITIALIZER(SAMPLE_SIG);
+static QEvt const *l_burst[MAX_BURST];
+
+/*..........................................................................*/
+static void drain(uint_fast16_t n) {
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        (void)QActive_get_(&l_sink);
+    }
+}
+/*..........................................................................*/
+static double bench_loop(uint_fast16_t n) {
+    uint64_t total = 0U;
+    for (uint32_t k = 0U; k < BENCH_ITER; ++k) {
+        uint64_t const t0 = now_ns();
+        for (uint_fast16_t i = 0U; i < n; ++i) {
+            QACTIVE_POST(&l_sink, l_burst[i], (void *)0);
+        }
+        total += now_ns() - t0;
+        drain(n);
+    }
+    return (double)total / ((double)BENCH_ITER * n);
+}
+/*..........................................................................*/
+static double bench_postN(uint_fast16_t n) {
+    uint64_t total = 0U;
+    for (uint32_t k = 0U; k < BENCH_ITER; ++k) {
+        uint64_t const t0 = now_ns();
+        QACTIVE_POST_N(&l_sink, l_burst, n, (void *)0);
+        total += now_ns() - t0;
+        drain(n);
+    }
+    return (double)total / ((double)BENCH_ITER * n);
+}
+
+/*..........................................................................*/
+static QState Sink_idle(QActive * const me, QEvt const * const e) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(e);
+    return Q_SUPER(&QHsm_top);
+}
+static QState Sink_initial(QActive * const me, void const * const par) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Sink_idle);
+}
+
+/* QF callbacks ============================================================*/
+void QF_onClockTick(void) {
+}
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static uint_fast16_t const defBursts[] = { 1U, 4U, 16U, 64U };
+
+    QF_init();
+    QActive_ctor(&l_sink, Q_STATE_CAST(&Sink_initial));
+    QACTIVE_START(&l_sink, 1U, l_sinkQueue, Q_DIM(l_sinkQueue),
+                  (void *)0, 0U, (void *)0);
+
+    for (uint_fast16_t i = 0U; i < MAX_BURST; ++i) {
+        l_burst[i] = &l_sampleEvt;
+    }
+
+    int const nRuns = (argc > 1) ? (argc - 1) : (int)Q_DIM(defBursts);
+    for (int r = 0; r < nRuns; ++r) {
+        uint_fast16_t n = (argc > 1)
+            ? (uint_fast16_t)strtoul(argv[r + 1], (char **)0, 10)
+            : defBursts[r];
+        Q_ASSERT((0U < n) && (n <= MAX_BURST));
+
+        (void)bench_loop(n); /* warm-up */
+        double const loop  = bench_loop(n);
+        double const postN = bench_postN(n);
+        printf("{\"bench\":\"post_batch\",\"n\":%u,"
+               "\"loop_ns_per_evt\":%.1f,\"postN_ns_per_evt\":%.1f,"
+               "\"speedup\":%.2f}\n",
+               (unsigned)n, loop, postN, loop / postN);
+    }
+    return 0;
+}
@@ -0,0 +1,237 @@
+/******************************************************************************
+* @file    qv_qk_latency.c
+* @brief   Worst-case event-to-dispatch delay under the QV and QK kernels
+*
+* A low-priority "Worker" AO runs long RTC steps of a given number of work
+* units, re-posting a WORK event to itself after every step, so the CPU is
+* never idle. Every work unit advances a virtual clock by one and, on a
+* pseudo-random schedule, invokes a simulated interrupt, which posts an
+* URGENT event stamped with the virtual time to the high-priority "Urgent"
+* AO. The Urgent AO records the delay between posting and dispatching.
+*
+* Under the cooperative QV kernel the URGENT event waits until the current
+* Worker RTC step completes, so the worst-case delay approaches the RTC
+* step length. Under the preemptive QK kernel the Urgent AO preempts the
+* Worker at the exit from the interrupt. The virtual clock makes the result
+* deterministic and independent of the host load.
+*
+* Build (from the repository root), QV kernel:
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qv \
+*       qpc/src/qf/q*.c qpc/src/qv/qv.c qpc/ports/posix/qv/qv_port.c \
+*       bench/qv_qk_latency.c -o qv_latency -lpthread
+*
+* QK kernel (single-threaded host simulation of QK):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/qv_qk_latency.c -o qk_latency
+*
+* Usage:
+*   ./qv_latency [rtc_units]      (default: 1000 work units per RTC step)
+*   ./qk_latency [rtc_units]
+*
+* Output: one JSON object per line, all the delays in virtual work units:
+*   {"bench":"qv_qk_latency","kernel":"QK","rtc_units":1000,
+*    "samples":..,"mean":..,"p99":..,"max":..}
+******************************************************************************/
+#include "qpc.h"
+
+#define BENCH_QF_ON_STARTUP /* stops the QV ticker thread */
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+Q_DEFINE_THIS_MODULE("qv_qk_latency")
+
+#define BENCH_SAMPLES   10000U /* number of URGENT events to measure */
+#define BENCH_URGENT_WORK  10U /* work units of the Urgent RTC step */
+
+#ifdef QK_H_
+    #define BENCH_KERNEL   "QK"
+    #define BENCH_ISR_ENTRY() QK_ISR_ENTRY()
+    #define BENCH_ISR_EXIT()  QK_ISR_EXIT()
+#else
+    #define BENCH_KERNEL   "QV"
+    #define BENCH_ISR_ENTRY() ((void)0)
+    #define BENCH_ISR_EXIT()  ((void)0)
+#endif
+
+enum BenchSignals {
+    WORK_SIG = Q_USER_SIG,
+    URGENT_SIG,
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;       /* inherits QEvt */
+    uint32_t t_post;  /* virtual time of posting */
+} UrgentEvt;
+
+typedef struct {
+    QActive super;    /* inherits QActive */
+} Worker;
+
+typedef struct {
+    QActive super;    /* inherits QActive */
+    uint32_t nLat;    /* number of latency samples taken */
+    uint32_t lat[BENCH_SAMPLES]; /* latencies [virtual work units] */
+} Urgent;
+
+static Worker l_worker;
+static Urgent l_urgent;
+static QEvt const *l_workerQueue[4];
+static QEvt const *l_urgentQueue[32];
+static QF_MPOOL_EL(UrgentEvt) l_urgentPool[32];
+
+static QEvt const l_workEvt = QEVT_INITIALIZER(WORK_SIG);
+
+static uint32_t l_rtcUnits = 1000U; /* work units of the Worker RTC step */
+static uint32_t l_vclock;           /* virtual clock [work units] */
+static uint32_t l_nextIrq;          /* virtual time of the next interrupt */
+static uint32_t l_rnd = 12345U;     /* pseudo-random generator state */
+
+/*..........................................................................*/
+static uint32_t random_gap(void) {
+    l_rnd = (l_rnd * 1664525U) + 1013904223U; /* LCG (Numerical Recipes) */
+    return 1U + ((l_rnd >> 8) % (2U * l_rtcUnits)); /* 1..2*rtcUnits */
+}
+/*..........................................................................*/
+static void simulated_isr(void) {
+    BENCH_ISR_ENTRY();
+
+    UrgentEvt *ue = Q_NEW(UrgentEvt, URGENT_SIG);
+    ue->t_post = l_vclock;
+    QACTIVE_POST(&l_urgent.super, &ue->super, (void *)0);
+
+    BENCH_ISR_EXIT();
+}
+/*..........................................................................*/
+static void do_work(uint32_t units) {
+    for (uint32_t i = 0U; i < units; ++i) {
+        ++l_vclock;
+        if (l_vclock == l_nextIrq) {
+            l_nextIrq = l_vclock + random_gap();
+            simulated_isr();
+        }
+    }
+}
+/*..........................................................................*/
+static int cmp_u32(void const *a, void const *b) {
+    uint32_t const x = *(uint32_t const *)a;
+    uint32_t const y = *(uint32_t const *)b;
+    return (x > y) - (x < y);
+}
+/*..........................................................................*/
+static void report(void) {
+    uint64_t sum = 0U;
+    for (uint32_t i = 0U; i < l_urgent.nLat; ++i) {
+        sum += l_urgent.lat[i];
+    }
+    qsort(l_urgent.lat, l_urgent.nLat, sizeof(l_urgent.lat[0]), &cmp_u32);
+    printf("{\"bench\":\"qv_qk_latency\",\"kernel\":\"%s\","
+           "\"rtc_units\":%u,\"samples\":%u,\"mean\":%.1f,"
+           "\"p99\":%u,\"max\":%u}\n",
+           BENCH_KERNEL, (unsigned)l_rtcUnits, (unsigned)l_urgent.nLat,
+           (double)sum / l_urgent.nLat,
+           (unsigned)l_urgent.lat[(l_urgent.nLat * 99U) / 100U],
+           (unsigned)l_urgent.lat[l_urgent.nLat - 1U]);
+    fflush(stdout);
+}
+
+/*..........................................................................*/
+static QState Worker_busy(Worker * const me, QEvt const * const e);
+static QState Urgent_active(Urgent * const me, QEvt const * const e);
+
+static QState Worker_initial(Worker * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+    QACTIVE_POST(&me->super, &l_workEvt, me);
+    return Q_TRAN(&Worker_busy);
+}
+static QState Worker_busy(Worker * const me, QEvt const * const e) {
+    QState status;
+    switch (e->sig) {
+        case WORK_SIG: {
+            do_work(l_rtcUnits); /* one long RTC step */
+            QACTIVE_POST(&me->super, &l_workEvt, me);
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+/*..........................................................................*/
+static QState Urgent_initial(Urgent * const me, void const * const par) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Urgent_active);
+}
+static QState Urgent_active(Urgent * const me, QEvt const * const e) {
+    QState status;
+    switch (e->sig) {
+        case URGENT_SIG: {
+            Q_ASSERT(me->nLat < BENCH_SAMPLES);
+            me->lat[me->nLat] =
+                l_vclock - Q_EVT_CAST(UrgentEvt)->t_post;
+            ++me->nLat;
+            if (me->nLat == BENCH_SAMPLES) {
+                report();
+                exit(0);
+            }
+            do_work(BENCH_URGENT_WORK);
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+
+/* QF callbacks ============================================================*/
+void QF_onStartup(void) {
+#ifndef QK_H_
+    QF_setTickRate(0U, 0); /* no ticker thread, the clock is virtual */
+#endif
+}
+/*..........................................................................*/
+#ifdef QK_H_
+void QK_onIdle(void) {
+    /* not reached, the Worker AO is always ready to run */
+}
+#else
+void QF_onClockTick(void) {
+}
+#endif
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    if (argc > 1) {
+        l_rtcUnits = (uint32_t)strtoul(argv[1], (char **)0, 10);
+        if (l_rtcUnits == 0U) {
+            l_rtcUnits = 1U;
+        }
+    }
+    l_nextIrq = random_gap();
+
+    QF_init();
+    QF_poolInit(l_urgentPool, sizeof(l_urgentPool), sizeof(l_urgentPool[0]));
+
+    QActive_ctor(&l_worker.super, Q_STATE_CAST(&Worker_initial));
+    QACTIVE_START(&l_worker.super, 1U,
+                  l_workerQueue, Q_DIM(l_workerQueue),
+                  (void *)0, 0U, (void *)0);
+
+    QActive_ctor(&l_urgent.super, Q_STATE_CAST(&Urgent_initial));
+    QACTIVE_START(&l_urgent.super, 2U,
+                  l_urgentQueue, Q_DIM(l_urgentQueue),
+                  (void *)0, 0U, (void *)0);
+
+    return QF_run();
+}
@@ -0,0 +1,180 @@
+/******************************************************************************
+* @file    rtc_hist.c
+* @brief   Cost of the per-AO/per-signal RTC-step histograms (QS_RTC_HIST)
+*
+* A "Worker" AO processes two signals: FAST (a short RTC step) and SLOW
+* (an RTC step about 100 times longer). The events are posted in bursts
+* with the QK scheduler locked, so that the events in a burst wait in the
+* queue behind each other. The benchmark reports the average cost of one
+* post+dispatch, which is built twice: with QS_RTC_HIST and without it
+* (both with Q_SPY), and the "mode" field tells the two apart.
+*
+* With QS_RTC_HIST, the benchmark finally invokes the same report as the
+* QS-RX command QS_RTC_HIST_CMD and writes the binary QS output to the file
+* rtc_hist.qs, which can be decoded by QSPY (the report records are the
+* application-specific records QS_USER+24).
+*
+* The benchmark uses the single-threaded QK simulation (qpc/ports/posix/qk),
+* whose QS_onGetTime() returns a 32-bit monotonic nanosecond time stamp.
+*
+* Build (from the repository root):
+*   gcc -O2 -DQ_SPY -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       qpc/ports/posix/qk/qs_port.c QS/qs*.c \
+*       bench/rtc_hist.c -o rtc_off
+*   gcc -O2 -DQ_SPY -DQS_RTC_HIST -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       qpc/ports/posix/qk/qs_port.c QS/qs*.c \
+*       bench/rtc_hist.c -o rtc_hist
+*
+* Usage:
+*   ./rtc_off; ./rtc_hist
+*
+* Output: one JSON object per line, e.g.
+*   {"bench":"rtc_hist","mode":"hist","steps":..,"ns_per_step":..,
+*    "qs_bytes":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("rtc_hist")
+
+#define BENCH_BURSTS  100000U /* number of bursts */
+#define BENCH_BURST   8U      /* events per burst */
+#define FAST_WORK     10U     /* work units of the FAST RTC step */
+#define SLOW_WORK     1000U   /* work units of the SLOW RTC step */
+
+#ifdef QS_RTC_HIST
+    #define BENCH_MODE "hist"
+#else
+    #define BENCH_MODE "off"
+#endif
+
+enum BenchSignals {
+    FAST_SIG = Q_USER_SIG,
+    SLOW_SIG,
+    MAX_SIG
+};
+
+static QActive l_worker;
+static QEvt const *l_workerQueue[BENCH_BURST];
+#ifdef QS_RTC_HIST
+static uint32_t l_workerStamps[BENCH_BURST];
+#endif
+
+static QEvt const l_fastEvt = QEVT_INITIALIZER(FAST_SIG);
+static QEvt const l_slowEvt = QEVT_INITIALIZER(SLOW_SIG);
+
+static uint32_t volatile l_sink; /* defeats optimizing the work away */
+static uint32_t l_nSteps;
+
+/*..........................................................................*/
+static void do_work(uint32_t units) {
+    for (uint32_t i = 0U; i < units; ++i) {
+        l_sink = l_sink + i;
+    }
+}
+
+/*..........................................................................*/
+static QState Worker_active(QActive * const me, QEvt const * const e) {
+    Q_UNUSED_PAR(me);
+    QState status;
+    switch (e->sig) {
+        case FAST_SIG: {
+            do_work(FAST_WORK);
+            ++l_nSteps;
+            status = Q_HANDLED();
+            break;
+        }
+        case SLOW_SIG: {
+            do_work(SLOW_WORK);
+            ++l_nSteps;
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+static QState Worker_initial(QActive * const me, void const * const par) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Worker_active);
+}
+
+/*..........................................................................*/
+static void bench(void) {
+    uint64_t const t0 = now_ns();
+    for (uint32_t k = 0U; k < BENCH_BURSTS; ++k) {
+        QSchedStatus const lockStat = QK_schedLock(1U);
+        for (uint_fast8_t i = 0U; i < BENCH_BURST; ++i) {
+            QACTIVE_POST(&l_worker,
+                         ((i & 3U) == 3U) ? &l_slowEvt : &l_fastEvt,
+                         (void *)0);
+        }
+        QK_schedUnlock(lockStat); /* runs the whole burst */
+    }
+    uint64_t const dt = now_ns() - t0;
+    Q_ASSERT(l_nSteps == (BENCH_BURSTS * BENCH_BURST));
+
+#ifdef QS_RTC_HIST
+    QS_GLB_FILTER(QS_U4_RECORDS); /* the report records only */
+    QS_rtcHistReport_(0U, false);
+#endif
+    QS_onCleanup(); /* flush and close the QS output file */
+
+    long qsBytes = 0; /* size of the QS output file */
+    FILE * const f = fopen("rtc_hist.qs", "rb");
+    if (f != (FILE *)0) {
+        (void)fseek(f, 0L, SEEK_END);
+        qsBytes = ftell(f);
+        (void)fclose(f);
+    }
+    printf("{\"bench\":\"rtc_hist\",\"mode\":\"%s\",\"steps\":%u,"
+           "\"ns_per_step\":%.1f,\"qs_bytes\":%ld}\n",
+           BENCH_MODE, (unsigned)l_nSteps,
+           (double)dt / (double)l_nSteps, qsBytes);
+}
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+    bench();
+    exit(0);
+}
+
+/* QS callbacks ============================================================*/
+void QS_onReset(void) {
+    exit(0);
+}
+/*..........................................................................*/
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    Q_UNUSED_PAR(cmdId);
+    Q_UNUSED_PAR(param1);
+    Q_UNUSED_PAR(param2);
+    Q_UNUSED_PAR(param3);
+}
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+    if (QS_INIT("rtc_hist.qs") == 0U) {
+        Q_ERROR();
+    }
+    QS_GLB_FILTER(-QS_ALL_RECORDS); /* no tracing during the measurement */
+
+    QActive_ctor(&l_worker, Q_STATE_CAST(&Worker_initial));
+    QACTIVE_START(&l_worker, 1U, l_workerQueue, Q_DIM(l_workerQueue),
+                  (void *)0, 0U, (void *)0);
+#ifdef QS_RTC_HIST
+    QActive_setStampSto(&l_worker, l_workerStamps, Q_DIM(l_workerStamps));
+#endif
+    return QF_run();
+}
@@ -0,0 +1,233 @@
+/******************************************************************************
+* @file    tickless.c
+* @brief   CPU wakeups of periodic vs tickless idle (QF_TICKLESS)
+*
+* Runs the TimeBomb AO (the hand-written QHsm in bench/timebomb_qhsm.c)
+* and a Heartbeat AO with a periodic time event in virtual time, driven by
+* a seeded script of debounced button events (press/release, defuse and
+* re-arm with random gaps). The idle callback plays the role of QV_onIdle()
+* in Application/bsp.c:
+*  - "periodic": the CPU wakes up at every clock tick and calls
+*    QTIMEEVT_TICK_X();
+*  - "tickless" (built with QF_TICKLESS): the idle callback sleeps until
+*    the next time-event expiry (QTimeEvt_nextExpiry()), at most
+*    BENCH_MAX_SLEEP ticks (the 24-bit SysTick at 16 MHz and 100 Hz), or
+*    until the next button event, and then catches up the elapsed ticks
+*    at once with QTIMEEVT_TICKN_X(). With no time event armed, it sleeps
+*    until the next button event (the SysTick is stopped).
+* The button events are posted at tick boundaries in both modes, as the
+* debouncing in SysTick_Handler() does. The stub BSP folds every LED
+* operation together with the tick at which it happened into a checksum,
+* and the two builds must report the same "trace".
+*
+* Build (from the repository root):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qk -IApplication -Ibench \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/timebomb_qhsm.c bench/tickless.c -o tickless_off
+*   gcc -O2 -DQF_TICKLESS -Iqpc/include -Iqpc/ports/posix/qk \
+*       -IApplication -Ibench \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/timebomb_qhsm.c bench/tickless.c -o tickless_on
+*
+* Usage:
+*   ./tickless_off; ./tickless_on
+*
+* Output: one JSON object, e.g.
+*   {"bench":"tickless","mode":"tickless","ticks":..,"events":..,
+*    "wakeups":..,"wakeups_per_sec":..,"trace":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bsp.h"
+#include "timebomb_qhsm.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("tickless")
+
+#define BENCH_TICKS      (3600U * BSP_TICKS_PER_SEC) /* one virtual hour */
+#define BENCH_SEED       12345U
+#define BENCH_MAX_SLEEP  104U  /* 0xFFFFFF / (16 MHz / BSP_TICKS_PER_SEC) */
+#define HEARTBEAT_TICKS  (5U * BSP_TICKS_PER_SEC) /* period of Heartbeat */
+
+#ifdef QF_TICKLESS
+    #define BENCH_MODE "tickless"
+#else
+    #define BENCH_MODE "periodic"
+#endif
+
+enum BenchSignals {
+    HEARTBEAT_SIG = MAX_SIG
+};
+
+/* Heartbeat AO: a periodic time event toggling "LED" 7 */
+typedef struct {
+    QActive super;
+    QTimeEvt te;
+} Heartbeat;
+
+static TimeBomb  l_timeBomb;
+static Heartbeat l_heartbeat;
+static QEvt const *l_timeBombQueue[10];
+static QEvt const *l_heartbeatQueue[4];
+
+static QEvt const l_button1PressedEvt  = QEVT_INITIALIZER(BUTTON_PRESSED_SIG);
+static QEvt const l_button1ReleasedEvt = QEVT_INITIALIZER(BUTTON_RELEASED_SIG);
+static QEvt const l_button2PressedEvt  = QEVT_INITIALIZER(BUTTON2_PRESSED_SIG);
+static QEvt const l_button2ReleasedEvt
+    = QEVT_INITIALIZER(BUTTON2_RELEASED_SIG);
+
+static uint32_t l_tick;    /* current virtual tick */
+static uint32_t l_wakeups; /* CPU wakeups from the idle sleep */
+static uint32_t l_nEvts;   /* posted button events */
+static uint32_t l_trace;   /* checksum of the LED operations and ticks */
+
+static uint32_t   l_rnd = BENCH_SEED;
+static uint32_t   l_btnTick; /* tick of the next button event */
+static QEvt const *l_btnEvt; /* the next button event */
+static uint_fast8_t l_btnStep; /* step in the button script */
+
+/* stub BSP ================================================================*/
+static void led(uint32_t op) {
+    l_trace = (l_trace * 31U) + (l_tick * 8U) + op;
+}
+void BSP_ledRedOn(void)    { led(1U); }
+void BSP_ledRedOff(void)   { led(2U); }
+void BSP_ledBlueOn(void)   { led(3U); }
+void BSP_ledBlueOff(void)  { led(4U); }
+void BSP_ledGreenOn(void)  { led(5U); }
+void BSP_ledGreenOff(void) { led(6U); }
+
+/*..........................................................................*/
+static QState Heartbeat_active(Heartbeat * const me, QEvt const * const e) {
+    Q_UNUSED_PAR(me);
+    QState status;
+    switch (e->sig) {
+        case HEARTBEAT_SIG: {
+            led(7U);
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+static QState Heartbeat_initial(Heartbeat * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+    QTimeEvt_armX(&me->te, HEARTBEAT_TICKS, HEARTBEAT_TICKS);
+    return Q_TRAN(&Heartbeat_active);
+}
+
+/* the button script =======================================================*/
+static uint32_t rnd(uint32_t range) { /* xorshift32 */
+    l_rnd ^= l_rnd << 13;
+    l_rnd ^= l_rnd >> 17;
+    l_rnd ^= l_rnd << 5;
+    return l_rnd % range;
+}
+/*..........................................................................*/
+/* arm (SW1), defuse (SW2) after a random time (sometimes after "boom") and
+* re-arm (SW2). The gaps after SW2 are at least a second long, because the
+* TimeBomb does not disarm its time event when defused.
+*/
+static void nextButton(void) {
+    static struct {
+        QEvt const *e;
+        uint32_t minGap;
+        uint32_t rndGap;
+    } const script[] = {
+        { &l_button1PressedEvt,  100U, 500U },
+        { &l_button1ReleasedEvt,   2U,  30U },
+        { &l_button2PressedEvt,   50U, 700U },
+        { &l_button2ReleasedEvt,   2U,  30U },
+        { &l_button2PressedEvt,  100U, 300U },
+        { &l_button2ReleasedEvt,   2U,  30U }
+    };
+    l_btnTick += script[l_btnStep].minGap + rnd(script[l_btnStep].rndGap);
+    l_btnEvt = script[l_btnStep].e;
+    l_btnStep = (l_btnStep + 1U) % Q_DIM(script);
+}
+
+/* the simulated SysTick/GPIO interrupt ====================================*/
+static void wakeup(uint32_t const nTicks) {
+    ++l_wakeups;
+    l_tick += nTicks;
+
+    QK_ISR_ENTRY();
+#ifdef QF_TICKLESS
+    QTIMEEVT_TICKN_X(0U, (QTimeEvtCtr)nTicks, (void *)0);
+#else
+    Q_ASSERT(nTicks == 1U);
+    QTIMEEVT_TICK_X(0U, (void *)0);
+#endif
+    if (l_tick == l_btnTick) { /* debounced button edge at this tick? */
+        QACTIVE_POST(&l_timeBomb.super, l_btnEvt, (void *)0);
+        ++l_nEvts;
+        nextButton();
+    }
+    QK_ISR_EXIT(); /* runs the AOs */
+}
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+    if (l_tick >= BENCH_TICKS) {
+        printf("{\"bench\":\"tickless\",\"mode\":\"%s\",\"ticks\":%u,"
+               "\"events\":%u,\"wakeups\":%u,\"wakeups_per_sec\":%.2f,"
+               "\"trace\":%u}\n",
+               BENCH_MODE, (unsigned)l_tick, (unsigned)l_nEvts,
+               (unsigned)l_wakeups,
+               (double)l_wakeups * BSP_TICKS_PER_SEC / (double)l_tick,
+               (unsigned)l_trace);
+        exit(0);
+    }
+
+#ifdef QF_TICKLESS
+    /* as QV_onIdle() in Application/bsp.c: the sleep is programmed with
+    * interrupts disabled, so that no time event can get armed meanwhile
+    */
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    uint32_t n = (uint32_t)QTimeEvt_nextExpiry(0U);
+    QF_CRIT_EXIT();
+    if (n > BENCH_MAX_SLEEP) {
+        n = BENCH_MAX_SLEEP;
+    }
+    uint32_t const toButton = l_btnTick - l_tick;
+    if ((n == 0U) || (n > toButton)) { /* the button comes first? */
+        n = toButton;                  /* woken up by the GPIO interrupt */
+    }
+    Q_ASSERT(n != 0U); /* every wakeup advances the virtual time */
+    wakeup(n);
+#else
+    wakeup(1U);
+#endif
+}
+/*..........................................................................*/
+static void error_ctx(void) { /* context of the error report */
+    fprintf(stderr, "  at tick %u\n", (unsigned)l_tick);
+}
+
+/*..........................................................................*/
+int main(void) {
+    BENCH_onErrorCtx = &error_ctx;
+    QF_init();
+
+    nextButton();
+
+    TimeBomb_ctor(&l_timeBomb);
+    QACTIVE_START(&l_timeBomb.super, 2U,
+                  l_timeBombQueue, Q_DIM(l_timeBombQueue),
+                  (void *)0, 0U, (void *)0);
+
+    QActive_ctor(&l_heartbeat.super, Q_STATE_CAST(&Heartbeat_initial));
+    QTimeEvt_ctorX(&l_heartbeat.te, &l_heartbeat.super, HEARTBEAT_SIG, 0U);
+    QACTIVE_START(&l_heartbeat.super, 1U,
+                  l_heartbeatQueue, Q_DIM(l_heartbeatQueue),
+                  (void *)0, 0U, (void *)0);
+
+    return QF_run();
+}
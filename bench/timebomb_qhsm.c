@@ -0,0 +1,241 @@
+/******************************************************************************
+* @file    timebomb_qhsm.c
+* @brief   Hand-written TimeBomb QHsm of Application/main.c (for benchmarks)
+*
+* The state handlers are a verbatim copy of Application/main.c, so that the
+* benchmarks can run them on the host next to the flattened QMsm generated
+* by tools/qmsmgen.py from bench/timebomb.json (bench/timebomb_qmsm.c).
+* The constructor registers the same handled-signal masks as main.c when
+* built with QHSM_SIG_MASK.
+******************************************************************************/
+#include "qpc.h"
+#include "bsp.h"
+#include "timebomb_qhsm.h"
+
+/* State handlers */
+static QState TimeBomb_initial(TimeBomb * const me, void const * const par);
+static QState TimeBomb_defused(TimeBomb * const me, QEvt const * const e);
+static QState TimeBomb_armed(TimeBomb * const me, QEvt const * const e);
+static QState TimeBomb_wait4button(TimeBomb * const me, QEvt const * const e);
+static QState TimeBomb_blink(TimeBomb * const me, QEvt const * const e);
+static QState TimeBomb_pause(TimeBomb * const me, QEvt const * const e);
+static QState TimeBomb_boom(TimeBomb * const me, QEvt const * const e);
+
+/* State machine =========================================================*/
+/* Initial transition for the TimeBomb AO */
+static QState TimeBomb_initial(TimeBomb * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+
+    /* QS dictionaries for tracing*/
+    QS_OBJ_DICTIONARY(&me->te);
+    QS_FUN_DICTIONARY(&TimeBomb_defused);
+    QS_FUN_DICTIONARY(&TimeBomb_armed);
+    QS_FUN_DICTIONARY(&TimeBomb_wait4button);
+    QS_FUN_DICTIONARY(&TimeBomb_blink);
+    QS_FUN_DICTIONARY(&TimeBomb_pause);
+    QS_FUN_DICTIONARY(&TimeBomb_boom);
+
+    return Q_TRAN(&TimeBomb_wait4button);
+}
+
+/*
+ * Superstate “armed”
+ * Superstate for normal arming/blinking sequence.
+ */
+static QState TimeBomb_armed(TimeBomb * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case Q_EXIT_SIG: {
+            BSP_ledRedOff();
+            BSP_ledGreenOff();
+            BSP_ledBlueOff();
+            status_ = Q_HANDLED();
+            break;
+        }
+        case Q_INIT_SIG: {
+            status_ = Q_TRAN(&TimeBomb_wait4button);
+            break;
+        }
+        case BUTTON2_PRESSED_SIG: {
+            status_ = Q_TRAN(&TimeBomb_defused);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*
+ * Idle (waiting) state
+ * Entry: green ON. On BUTTON_PRESSED → blink (set blink_ctr=5).
+ */
+static QState TimeBomb_wait4button(TimeBomb * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: {
+            BSP_ledGreenOn();
+            status_ = Q_HANDLED();
+            break;
+        }
+        case Q_EXIT_SIG: {
+            BSP_ledGreenOff();
+            status_ = Q_HANDLED();
+            break;
+        }
+        case BUTTON_PRESSED_SIG: {
+            me->blink_ctr = 5U;
+            status_ = Q_TRAN(&TimeBomb_blink);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&TimeBomb_armed);
+            break;
+        }
+    }
+    return status_;
+}
+
+/**
+ * Active blinking state
+ *
+ * Entry: red ON; arm one-shot 0.5 s timer → TIMEOUT → pause.
+ */
+static QState TimeBomb_blink(TimeBomb * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: {
+            BSP_ledRedOn();
+            QTimeEvt_armX(&me->te, BSP_TICKS_PER_SEC/2, 0U);
+            status_ = Q_HANDLED();
+            break;
+        }
+        case Q_EXIT_SIG: {
+            BSP_ledRedOff();
+            status_ = Q_HANDLED();
+            break;
+        }
+        case TIMEOUT_SIG: {
+            status_ = Q_TRAN(&TimeBomb_pause);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&TimeBomb_armed);
+            break;
+        }
+    }
+    return status_;
+}
+
+/**
+ * Pause state
+ *
+ * Entry: arm one-shot 0.5 s; TIMEOUT → decrement, loop blink/pause until 0;
+ * when count hits 0 → boom.
+ */
+static QState TimeBomb_pause(TimeBomb * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: {
+            QTimeEvt_armX(&me->te, BSP_TICKS_PER_SEC/2, 0U);
+            status_ = Q_HANDLED();
+            break;
+        }
+        case TIMEOUT_SIG: {
+            --me->blink_ctr;
+            if (me->blink_ctr > 0U) {
+                status_ = Q_TRAN(&TimeBomb_blink);
+            }
+            else {
+                status_ = Q_TRAN(&TimeBomb_boom);
+            }
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&TimeBomb_armed);
+            break;
+        }
+    }
+    return status_;
+}
+
+/**
+ * Final “explosion” state
+ *
+ * Entry: all LEDs ON; no transitions (other than via superstate).
+ */
+static QState TimeBomb_boom(TimeBomb * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: {
+            BSP_ledRedOn();
+            BSP_ledGreenOn();
+            BSP_ledBlueOn();
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&TimeBomb_armed);
+            break;
+        }
+    }
+    return status_;
+}
+
+/**
+ * Defused state (sibling of armed)
+ *
+ * Entry: blue ON; BUTTON2_PRESSED → back to armed (all LEDs off via armed EXIT).
+ */
+static QState TimeBomb_defused(TimeBomb * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: {
+            BSP_ledBlueOn();
+            status_ = Q_HANDLED();
+            break;
+        }
+        case Q_EXIT_SIG: {
+            BSP_ledBlueOff();
+            status_ = Q_HANDLED();
+            break;
+        }
+        case BUTTON2_PRESSED_SIG: {
+            status_ = Q_TRAN(&TimeBomb_armed);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/* Constructor =========================================================*/
+#ifdef QHSM_SIG_MASK
+/* signals handled in each TimeBomb state (BUTTON_RELEASED in none) */
+static QSignal const timeBomb_armedSigs[]   = { BUTTON2_PRESSED_SIG, 0U };
+static QSignal const timeBomb_buttonSigs[]  = { BUTTON_PRESSED_SIG, 0U };
+static QSignal const timeBomb_timeoutSigs[] = { TIMEOUT_SIG, 0U };
+static QHsmSigMask timeBomb_sigMasks[] = { /* shared by all instances */
+    { .state = (QStateHandler)&TimeBomb_armed, .sigs = timeBomb_armedSigs },
+    { .state = (QStateHandler)&TimeBomb_wait4button,
+      .sigs = timeBomb_buttonSigs },
+    { .state = (QStateHandler)&TimeBomb_blink, .sigs = timeBomb_timeoutSigs },
+    { .state = (QStateHandler)&TimeBomb_pause, .sigs = timeBomb_timeoutSigs },
+    { .state = (QStateHandler)&TimeBomb_boom, .sigs = (QSignal const *)0 },
+    { .state = (QStateHandler)&TimeBomb_defused, .sigs = timeBomb_armedSigs }
+};
+#endif
+
+void TimeBomb_ctor(TimeBomb * const me) {
+    QActive_ctor(&me->super, (QStateHandler)&TimeBomb_initial);
+    QTimeEvt_ctorX(&me->te, &me->super, TIMEOUT_SIG, 0U);
+#ifdef QHSM_SIG_MASK
+    QHsm_setSigMasks((QHsm *)&me->super,
+                     timeBomb_sigMasks, Q_DIM(timeBomb_sigMasks));
+#endif
+}
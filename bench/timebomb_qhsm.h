@@ -0,0 +1,18 @@
+/******************************************************************************
+* @file    timebomb_qhsm.h
+* @brief   Hand-written TimeBomb QHsm of Application/main.c (for benchmarks)
+******************************************************************************/
+#ifndef TIMEBOMB_QHSM_H
+#define TIMEBOMB_QHSM_H
+
+/* The TimeBomb AO =========================================================*/
+typedef struct {
+    QActive super; /* base class */
+
+    QTimeEvt te; /* Time event (TIMEOUT_SIG) */
+    uint32_t blink_ctr; /* remaining blinks before "boom" */
+} TimeBomb;
+
+void TimeBomb_ctor(TimeBomb * const me);
+
+#endif /* TIMEBOMB_QHSM_H */
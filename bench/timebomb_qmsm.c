@@ -0,0 +1,495 @@
+/******************************************************************************
+* @file    timebomb_qmsm.c
+* @brief   generated by tools/qmsmgen.py from bench/timebomb.json
+*
+* DO NOT EDIT: change the model and regenerate this file instead.
+******************************************************************************/
+#include "qpc.h"
+#include "bsp.h"
+#include "timebomb_qmsm.h"
+
+/* event function of one state for one signal */
+typedef QState (*TimeBombQM_EvtFun)(TimeBombQM * const me,
+    QEvt const * const e);
+
+/* states, actions and event functions */
+static QState TimeBombQM_initial(TimeBombQM * const me,
+    void const * const par);
+static QState TimeBombQM_armed(TimeBombQM * const me, QEvt const * const e);
+static QState TimeBombQM_armed_x(TimeBombQM * const me);
+static QState TimeBombQM_armed_i(TimeBombQM * const me);
+static QState TimeBombQM_armed_BUTTON2_PRESSED(TimeBombQM * const me,
+    QEvt const * const e);
+static QMState const TimeBombQM_armed_s;
+static QState TimeBombQM_wait4button(TimeBombQM * const me,
+    QEvt const * const e);
+static QState TimeBombQM_wait4button_e(TimeBombQM * const me);
+static QState TimeBombQM_wait4button_x(TimeBombQM * const me);
+static QState TimeBombQM_wait4button_BUTTON_PRESSED(TimeBombQM * const me,
+    QEvt const * const e);
+static QState TimeBombQM_wait4button_BUTTON2_PRESSED(TimeBombQM * const me,
+    QEvt const * const e);
+static QMState const TimeBombQM_wait4button_s;
+static QState TimeBombQM_blink(TimeBombQM * const me, QEvt const * const e);
+static QState TimeBombQM_blink_e(TimeBombQM * const me);
+static QState TimeBombQM_blink_x(TimeBombQM * const me);
+static QState TimeBombQM_blink_TIMEOUT(TimeBombQM * const me,
+    QEvt const * const e);
+static QState TimeBombQM_blink_BUTTON2_PRESSED(TimeBombQM * const me,
+    QEvt const * const e);
+static QMState const TimeBombQM_blink_s;
+static QState TimeBombQM_pause(TimeBombQM * const me, QEvt const * const e);
+static QState TimeBombQM_pause_e(TimeBombQM * const me);
+static QState TimeBombQM_pause_TIMEOUT(TimeBombQM * const me,
+    QEvt const * const e);
+static QState TimeBombQM_pause_BUTTON2_PRESSED(TimeBombQM * const me,
+    QEvt const * const e);
+static QMState const TimeBombQM_pause_s;
+static QState TimeBombQM_boom(TimeBombQM * const me, QEvt const * const e);
+static QState TimeBombQM_boom_e(TimeBombQM * const me);
+static QState TimeBombQM_boom_BUTTON2_PRESSED(TimeBombQM * const me,
+    QEvt const * const e);
+static QMState const TimeBombQM_boom_s;
+static QState TimeBombQM_defused(TimeBombQM * const me, QEvt const * const e);
+static QState TimeBombQM_defused_e(TimeBombQM * const me);
+static QState TimeBombQM_defused_x(TimeBombQM * const me);
+static QState TimeBombQM_defused_BUTTON2_PRESSED(TimeBombQM * const me,
+    QEvt const * const e);
+static QMState const TimeBombQM_defused_s;
+
+/*${TimeBombQM::SM::armed} .................................................*/
+static QMState const TimeBombQM_armed_s = {
+    QM_STATE_NULL, /* superstate (top) */
+    Q_STATE_CAST(&TimeBombQM_armed),
+    Q_ACTION_NULL, /* no entry action */
+    Q_ACTION_CAST(&TimeBombQM_armed_x),
+    Q_ACTION_CAST(&TimeBombQM_armed_i)
+};
+/*${TimeBombQM::SM::wait4button} ...........................................*/
+static QMState const TimeBombQM_wait4button_s = {
+    &TimeBombQM_armed_s, /* superstate */
+    Q_STATE_CAST(&TimeBombQM_wait4button),
+    Q_ACTION_CAST(&TimeBombQM_wait4button_e),
+    Q_ACTION_CAST(&TimeBombQM_wait4button_x),
+    Q_ACTION_NULL /* no initial tran. */
+};
+/*${TimeBombQM::SM::blink} .................................................*/
+static QMState const TimeBombQM_blink_s = {
+    &TimeBombQM_armed_s, /* superstate */
+    Q_STATE_CAST(&TimeBombQM_blink),
+    Q_ACTION_CAST(&TimeBombQM_blink_e),
+    Q_ACTION_CAST(&TimeBombQM_blink_x),
+    Q_ACTION_NULL /* no initial tran. */
+};
+/*${TimeBombQM::SM::pause} .................................................*/
+static QMState const TimeBombQM_pause_s = {
+    &TimeBombQM_armed_s, /* superstate */
+    Q_STATE_CAST(&TimeBombQM_pause),
+    Q_ACTION_CAST(&TimeBombQM_pause_e),
+    Q_ACTION_NULL, /* no exit action */
+    Q_ACTION_NULL /* no initial tran. */
+};
+/*${TimeBombQM::SM::boom} ..................................................*/
+static QMState const TimeBombQM_boom_s = {
+    &TimeBombQM_armed_s, /* superstate */
+    Q_STATE_CAST(&TimeBombQM_boom),
+    Q_ACTION_CAST(&TimeBombQM_boom_e),
+    Q_ACTION_NULL, /* no exit action */
+    Q_ACTION_NULL /* no initial tran. */
+};
+/*${TimeBombQM::SM::defused} ...............................................*/
+static QMState const TimeBombQM_defused_s = {
+    QM_STATE_NULL, /* superstate (top) */
+    Q_STATE_CAST(&TimeBombQM_defused),
+    Q_ACTION_CAST(&TimeBombQM_defused_e),
+    Q_ACTION_CAST(&TimeBombQM_defused_x),
+    Q_ACTION_NULL /* no initial tran. */
+};
+
+/* dispatches the event through the signal-indexed table of a state */
+static inline QState TimeBombQM_dispatch_(TimeBombQM * const me,
+    QEvt const * const e, TimeBombQM_EvtFun const * const tbl)
+{
+    QSignal const idx = (QSignal)(e->sig - (QSignal)Q_USER_SIG);
+    QState status_;
+    if ((idx < (QSignal)(MAX_SIG - Q_USER_SIG))
+        && (tbl[idx] != (TimeBombQM_EvtFun)0))
+    {
+        status_ = (*tbl[idx])(me, e);
+    }
+    else {
+        status_ = QM_SUPER();
+    }
+    return status_;
+}
+
+/*${TimeBombQM::SM} ........................................................*/
+static QState TimeBombQM_initial(TimeBombQM * const me,
+    void const * const par)
+{
+    Q_UNUSED_PAR(par);
+    QState status_;
+
+    QS_FUN_DICTIONARY(&TimeBombQM_armed);
+    QS_FUN_DICTIONARY(&TimeBombQM_wait4button);
+    QS_FUN_DICTIONARY(&TimeBombQM_blink);
+    QS_FUN_DICTIONARY(&TimeBombQM_pause);
+    QS_FUN_DICTIONARY(&TimeBombQM_boom);
+    QS_FUN_DICTIONARY(&TimeBombQM_defused);
+
+    static struct {
+        QMState const *target;
+        QActionHandler act[2];
+    } const tatbl_ = { /* tran-action table */
+        &TimeBombQM_wait4button_s, /* target state */
+        {
+            Q_ACTION_CAST(&TimeBombQM_wait4button_e),
+            Q_ACTION_NULL /* zero terminator */
+        }
+    };
+    status_ = QM_TRAN_INIT(&tatbl_);
+    return status_;
+}
+
+/*${TimeBombQM::SM::armed} .................................................*/
+static QState TimeBombQM_armed(TimeBombQM * const me, QEvt const * const e) {
+    static TimeBombQM_EvtFun const tbl_[MAX_SIG - Q_USER_SIG] = {
+        [BUTTON2_PRESSED_SIG - Q_USER_SIG] =
+            &TimeBombQM_armed_BUTTON2_PRESSED
+    };
+    return TimeBombQM_dispatch_(me, e, &tbl_[0]);
+}
+/* exit action */
+static QState TimeBombQM_armed_x(TimeBombQM * const me) {
+    Q_UNUSED_PAR(me);
+    BSP_ledRedOff();
+    BSP_ledGreenOff();
+    BSP_ledBlueOff();
+    return QM_EXIT(&TimeBombQM_armed_s);
+}
+/* initial transition */
+static QState TimeBombQM_armed_i(TimeBombQM * const me) {
+    QState status_;
+    static struct {
+        QMState const *target;
+        QActionHandler act[2];
+    } const tatbl_ = { /* tran-action table */
+        &TimeBombQM_wait4button_s, /* target state */
+        {
+            Q_ACTION_CAST(&TimeBombQM_wait4button_e),
+            Q_ACTION_NULL /* zero terminator */
+        }
+    };
+    status_ = QM_TRAN_INIT(&tatbl_);
+    return status_;
+}
+/* BUTTON2_PRESSED_SIG */
+static QState TimeBombQM_armed_BUTTON2_PRESSED(TimeBombQM * const me,
+    QEvt const * const e)
+{
+    Q_UNUSED_PAR(e);
+    QState status_;
+    static struct {
+        QMState const *target;
+        QActionHandler act[3];
+    } const tatbl_ = { /* tran-action table */
+        &TimeBombQM_defused_s, /* target state */
+        {
+            Q_ACTION_CAST(&TimeBombQM_armed_x),
+            Q_ACTION_CAST(&TimeBombQM_defused_e),
+            Q_ACTION_NULL /* zero terminator */
+        }
+    };
+    status_ = QM_TRAN(&tatbl_);
+    return status_;
+}
+
+/*${TimeBombQM::SM::wait4button} ...........................................*/
+static QState TimeBombQM_wait4button(TimeBombQM * const me,
+    QEvt const * const e)
+{
+    static TimeBombQM_EvtFun const tbl_[MAX_SIG - Q_USER_SIG] = {
+        [BUTTON_PRESSED_SIG - Q_USER_SIG] =
+            &TimeBombQM_wait4button_BUTTON_PRESSED,
+        /* inherited from armed */
+        [BUTTON2_PRESSED_SIG - Q_USER_SIG] =
+            &TimeBombQM_wait4button_BUTTON2_PRESSED
+    };
+    return TimeBombQM_dispatch_(me, e, &tbl_[0]);
+}
+/* entry action */
+static QState TimeBombQM_wait4button_e(TimeBombQM * const me) {
+    Q_UNUSED_PAR(me);
+    BSP_ledGreenOn();
+    return QM_ENTRY(&TimeBombQM_wait4button_s);
+}
+/* exit action */
+static QState TimeBombQM_wait4button_x(TimeBombQM * const me) {
+    Q_UNUSED_PAR(me);
+    BSP_ledGreenOff();
+    return QM_EXIT(&TimeBombQM_wait4button_s);
+}
+/* BUTTON_PRESSED_SIG */
+static QState TimeBombQM_wait4button_BUTTON_PRESSED(TimeBombQM * const me,
+    QEvt const * const e)
+{
+    Q_UNUSED_PAR(e);
+    QState status_;
+    me->blink_ctr = 5U;
+    static struct {
+        QMState const *target;
+        QActionHandler act[3];
+    } const tatbl_ = { /* tran-action table */
+        &TimeBombQM_blink_s, /* target state */
+        {
+            Q_ACTION_CAST(&TimeBombQM_wait4button_x),
+            Q_ACTION_CAST(&TimeBombQM_blink_e),
+            Q_ACTION_NULL /* zero terminator */
+        }
+    };
+    status_ = QM_TRAN(&tatbl_);
+    return status_;
+}
+/* BUTTON2_PRESSED_SIG (inherited from armed) */
+static QState TimeBombQM_wait4button_BUTTON2_PRESSED(TimeBombQM * const me,
+    QEvt const * const e)
+{
+    Q_UNUSED_PAR(e);
+    QState status_;
+    static struct {
+        QMState const *target;
+        QActionHandler act[4];
+    } const tatbl_ = { /* tran-action table */
+        &TimeBombQM_defused_s, /* target state */
+        {
+            Q_ACTION_CAST(&TimeBombQM_wait4button_x),
+            Q_ACTION_CAST(&TimeBombQM_armed_x),
+            Q_ACTION_CAST(&TimeBombQM_defused_e),
+            Q_ACTION_NULL /* zero terminator */
+        }
+    };
+    status_ = QM_TRAN(&tatbl_);
+    return status_;
+}
+
+/*${TimeBombQM::SM::blink} .................................................*/
+static QState TimeBombQM_blink(TimeBombQM * const me, QEvt const * const e) {
+    static TimeBombQM_EvtFun const tbl_[MAX_SIG - Q_USER_SIG] = {
+        [TIMEOUT_SIG - Q_USER_SIG] =
+            &TimeBombQM_blink_TIMEOUT,
+        /* inherited from armed */
+        [BUTTON2_PRESSED_SIG - Q_USER_SIG] =
+            &TimeBombQM_blink_BUTTON2_PRESSED
+    };
+    return TimeBombQM_dispatch_(me, e, &tbl_[0]);
+}
+/* entry action */
+static QState TimeBombQM_blink_e(TimeBombQM * const me) {
+    BSP_ledRedOn();
+    QTimeEvt_armX(&me->te, BSP_TICKS_PER_SEC/2, 0U);
+    return QM_ENTRY(&TimeBombQM_blink_s);
+}
+/* exit action */
+static QState TimeBombQM_blink_x(TimeBombQM * const me) {
+    Q_UNUSED_PAR(me);
+    BSP_ledRedOff();
+    return QM_EXIT(&TimeBombQM_blink_s);
+}
+/* TIMEOUT_SIG */
+static QState TimeBombQM_blink_TIMEOUT(TimeBombQM * const me,
+    QEvt const * const e)
+{
+    Q_UNUSED_PAR(e);
+    QState status_;
+    static struct {
+        QMState const *target;
+        QActionHandler act[3];
+    } const tatbl_ = { /* tran-action table */
+        &TimeBombQM_pause_s, /* target state */
+        {
+            Q_ACTION_CAST(&TimeBombQM_blink_x),
+            Q_ACTION_CAST(&TimeBombQM_pause_e),
+            Q_ACTION_NULL /* zero terminator */
+        }
+    };
+    status_ = QM_TRAN(&tatbl_);
+    return status_;
+}
+/* BUTTON2_PRESSED_SIG (inherited from armed) */
+static QState TimeBombQM_blink_BUTTON2_PRESSED(TimeBombQM * const me,
+    QEvt const * const e)
+{
+    Q_UNUSED_PAR(e);
+    QState status_;
+    static struct {
+        QMState const *target;
+        QActionHandler act[4];
+    } const tatbl_ = { /* tran-action table */
+        &TimeBombQM_defused_s, /* target state */
+        {
+            Q_ACTION_CAST(&TimeBombQM_blink_x),
+            Q_ACTION_CAST(&TimeBombQM_armed_x),
+            Q_ACTION_CAST(&TimeBombQM_defused_e),
+            Q_ACTION_NULL /* zero terminator */
+        }
+    };
+    status_ = QM_TRAN(&tatbl_);
+    return status_;
+}
+
+/*${TimeBombQM::SM::pause} .................................................*/
+static QState TimeBombQM_pause(TimeBombQM * const me, QEvt const * const e) {
+    static TimeBombQM_EvtFun const tbl_[MAX_SIG - Q_USER_SIG] = {
+        [TIMEOUT_SIG - Q_USER_SIG] =
+            &TimeBombQM_pause_TIMEOUT,
+        /* inherited from armed */
+        [BUTTON2_PRESSED_SIG - Q_USER_SIG] =
+            &TimeBombQM_pause_BUTTON2_PRESSED
+    };
+    return TimeBombQM_dispatch_(me, e, &tbl_[0]);
+}
+/* entry action */
+static QState TimeBombQM_pause_e(TimeBombQM * const me) {
+    QTimeEvt_armX(&me->te, BSP_TICKS_PER_SEC/2, 0U);
+    return QM_ENTRY(&TimeBombQM_pause_s);
+}
+/* TIMEOUT_SIG */
+static QState TimeBombQM_pause_TIMEOUT(TimeBombQM * const me,
+    QEvt const * const e)
+{
+    Q_UNUSED_PAR(e);
+    QState status_;
+    --me->blink_ctr;
+    if (me->blink_ctr > 0U) {
+        static struct {
+            QMState const *target;
+            QActionHandler act[2];
+        } const tatbl_ = { /* tran-action table */
+            &TimeBombQM_blink_s, /* target state */
+            {
+                Q_ACTION_CAST(&TimeBombQM_blink_e),
+                Q_ACTION_NULL /* zero terminator */
+            }
+        };
+        status_ = QM_TRAN(&tatbl_);
+    }
+    else {
+        static struct {
+            QMState const *target;
+            QActionHandler act[2];
+        } const tatbl_ = { /* tran-action table */
+            &TimeBombQM_boom_s, /* target state */
+            {
+                Q_ACTION_CAST(&TimeBombQM_boom_e),
+                Q_ACTION_NULL /* zero terminator */
+            }
+        };
+        status_ = QM_TRAN(&tatbl_);
+    }
+    return status_;
+}
+/* BUTTON2_PRESSED_SIG (inherited from armed) */
+static QState TimeBombQM_pause_BUTTON2_PRESSED(TimeBombQM * const me,
+    QEvt const * const e)
+{
+    Q_UNUSED_PAR(e);
+    QState status_;
+    static struct {
+        QMState const *target;
+        QActionHandler act[3];
+    } const tatbl_ = { /* tran-action table */
+        &TimeBombQM_defused_s, /* target state */
+        {
+            Q_ACTION_CAST(&TimeBombQM_armed_x),
+            Q_ACTION_CAST(&TimeBombQM_defused_e),
+            Q_ACTION_NULL /* zero terminator */
+        }
+    };
+    status_ = QM_TRAN(&tatbl_);
+    return status_;
+}
+
+/*${TimeBombQM::SM::boom} ..................................................*/
+static QState TimeBombQM_boom(TimeBombQM * const me, QEvt const * const e) {
+    static TimeBombQM_EvtFun const tbl_[MAX_SIG - Q_USER_SIG] = {
+        /* inherited from armed */
+        [BUTTON2_PRESSED_SIG - Q_USER_SIG] =
+            &TimeBombQM_boom_BUTTON2_PRESSED
+    };
+    return TimeBombQM_dispatch_(me, e, &tbl_[0]);
+}
+/* entry action */
+static QState TimeBombQM_boom_e(TimeBombQM * const me) {
+    Q_UNUSED_PAR(me);
+    BSP_ledRedOn();
+    BSP_ledGreenOn();
+    BSP_ledBlueOn();
+    return QM_ENTRY(&TimeBombQM_boom_s);
+}
+/* BUTTON2_PRESSED_SIG (inherited from armed) */
+static QState TimeBombQM_boom_BUTTON2_PRESSED(TimeBombQM * const me,
+    QEvt const * const e)
+{
+    Q_UNUSED_PAR(e);
+    QState status_;
+    static struct {
+        QMState const *target;
+        QActionHandler act[3];
+    } const tatbl_ = { /* tran-action table */
+        &TimeBombQM_defused_s, /* target state */
+        {
+            Q_ACTION_CAST(&TimeBombQM_armed_x),
+            Q_ACTION_CAST(&TimeBombQM_defused_e),
+            Q_ACTION_NULL /* zero terminator */
+        }
+    };
+    status_ = QM_TRAN(&tatbl_);
+    return status_;
+}
+
+/*${TimeBombQM::SM::defused} ...............................................*/
+static QState TimeBombQM_defused(TimeBombQM * const me, QEvt const * const e) {
+    static TimeBombQM_EvtFun const tbl_[MAX_SIG - Q_USER_SIG] = {
+        [BUTTON2_PRESSED_SIG - Q_USER_SIG] =
+            &TimeBombQM_defused_BUTTON2_PRESSED
+    };
+    return TimeBombQM_dispatch_(me, e, &tbl_[0]);
+}
+/* entry action */
+static QState TimeBombQM_defused_e(TimeBombQM * const me) {
+    Q_UNUSED_PAR(me);
+    BSP_ledBlueOn();
+    return QM_ENTRY(&TimeBombQM_defused_s);
+}
+/* exit action */
+static QState TimeBombQM_defused_x(TimeBombQM * const me) {
+    Q_UNUSED_PAR(me);
+    BSP_ledBlueOff();
+    return QM_EXIT(&TimeBombQM_defused_s);
+}
+/* BUTTON2_PRESSED_SIG */
+static QState TimeBombQM_defused_BUTTON2_PRESSED(TimeBombQM * const me,
+    QEvt const * const e)
+{
+    Q_UNUSED_PAR(e);
+    QState status_;
+    static struct {
+        QMState const *target;
+        QActionHandler act[3];
+    } const tatbl_ = { /* tran-action table */
+        &TimeBombQM_armed_s, /* target state */
+        {
+            Q_ACTION_CAST(&TimeBombQM_defused_x),
+            Q_ACTION_CAST(&TimeBombQM_armed_i),
+            Q_ACTION_NULL /* zero terminator */
+        }
+    };
+    status_ = QM_TRAN(&tatbl_);
+    return status_;
+}
+
+/*${TimeBombQM::ctor} ......................................................*/
+void TimeBombQM_ctor(TimeBombQM * const me) {
+    QMActive_ctor(&me->super, Q_STATE_CAST(&TimeBombQM_initial));
+    QTimeEvt_ctorX(&me->te, &me->super.super, TIMEOUT_SIG, 0U);
+}
@@ -0,0 +1,19 @@
+/******************************************************************************
+* @file    timebomb_qmsm.h
+* @brief   generated by tools/qmsmgen.py from bench/timebomb.json
+*
+* DO NOT EDIT: change the model and regenerate this file instead.
+******************************************************************************/
+#ifndef TIMEBOMB_QMSM_H
+#define TIMEBOMB_QMSM_H
+
+/* TimeBomb state machine of Application/main.c as a flattened QMsm */
+typedef struct {
+    QMActive super; /* inherits QMActive */
+    QTimeEvt te; /* Time event (TIMEOUT_SIG) */
+    uint32_t blink_ctr; /* remaining blinks before "boom" */
+} TimeBombQM;
+
+void TimeBombQM_ctor(TimeBombQM * const me);
+
+#endif /* TIMEBOMB_QMSM_H */
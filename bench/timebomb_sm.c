@@ -0,0 +1,115 @@
+/******************************************************************************
+* @file    timebomb_sm.c
+* @brief   Dispatch throughput: hand-written TimeBomb QHsm vs generated QMsm
+*
+* Runs the same scripted event sequence through two implementations of the
+* TimeBomb state machine of Application/main.c:
+*  - "qhsm": the hand-written switch-based QHsm (bench/timebomb_qhsm.c),
+*    which QEP probes with Q_EMPTY_SIG, Q_ENTRY_SIG and Q_EXIT_SIG;
+*  - "qmsm": the flattened QMsm generated by tools/qmsmgen.py from the model
+*    bench/timebomb.json (bench/timebomb_qmsm.c), with precomputed
+*    transition-action tables and a signal-indexed table per state.
+*
+* One cycle of the script arms the bomb, lets it blink down to "boom"
+* (10 TIMEOUTs), sends an ignored event, defuses it and re-arms it
+* (14 events). The events are dispatched directly with QASM_DISPATCH();
+* the time event is disarmed before every TIMEOUT, as if it had expired.
+* The stub BSP folds every LED operation into a checksum, and both
+* implementations must report the same "trace".
+*
+* Code size: compare the text sizes of the two state-machine objects, e.g.
+*   gcc -O2 -c ... bench/timebomb_qhsm.c bench/timebomb_qmsm.c
+*   size timebomb_qhsm.o timebomb_qmsm.o
+*
+* Build (from the repository root):
+*   python3 tools/qmsmgen.py bench/timebomb.json bench/timebomb_qmsm
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qk -IApplication -Ibench \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/timebomb_qhsm.c bench/timebomb_qmsm.c bench/timebomb_sm.c \
+*       -o timebomb_sm
+*
+* Usage:
+*   ./timebomb_sm
+*
+* Output: one JSON object per line, e.g.
+*   {"bench":"timebomb_sm","sm":"qmsm","events":..,"ns_per_evt":..,
+*    "trace":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bsp.h"
+#include "timebomb_qhsm.h"
+#include "timebomb_qmsm.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("timebomb_sm")
+
+#define BENCH_CYCLES  (500U * 1000U) /* script cycles per run */
+
+static TimeBomb   l_qhsm;
+static TimeBombQM l_qmsm;
+
+static QEvt const l_buttonEvt   = QEVT_INITIALIZER(BUTTON_PRESSED_SIG);
+static QEvt const l_releaseEvt  = QEVT_INITIALIZER(BUTTON_RELEASED_SIG);
+static QEvt const l_button2Evt  = QEVT_INITIALIZER(BUTTON2_PRESSED_SIG);
+static QEvt const l_timeoutEvt  = QEVT_INITIALIZER(TIMEOUT_SIG);
+
+static uint32_t l_trace; /* checksum of the LED operations */
+
+/* stub BSP ================================================================*/
+static void led(uint32_t op) {
+    l_trace = (l_trace * 31U) + op;
+}
+void BSP_ledRedOn(void)    { led(1U); }
+void BSP_ledRedOff(void)   { led(2U); }
+void BSP_ledBlueOn(void)   { led(3U); }
+void BSP_ledBlueOff(void)  { led(4U); }
+void BSP_ledGreenOn(void)  { led(5U); }
+void BSP_ledGreenOff(void) { led(6U); }
+
+/*..........................................................................*/
+static void bench(char const *name, QAsm * const sm, QTimeEvt * const te) {
+    l_trace = 0U;
+    QASM_INIT(sm, (void *)0, 0U);
+
+    uint32_t nEvt = 0U;
+    uint64_t const t0 = now_ns();
+    for (uint32_t k = 0U; k < BENCH_CYCLES; ++k) {
+        QASM_DISPATCH(sm, &l_buttonEvt, 0U);
+        for (uint_fast8_t i = 0U; i < 10U; ++i) {
+            (void)QTimeEvt_disarm(te); /* the time event "expired" */
+            QASM_DISPATCH(sm, &l_timeoutEvt, 0U);
+        }
+        QASM_DISPATCH(sm, &l_releaseEvt, 0U); /* ignored */
+        QASM_DISPATCH(sm, &l_button2Evt, 0U); /* -> defused */
+        QASM_DISPATCH(sm, &l_button2Evt, 0U); /* -> armed/wait4button */
+        nEvt += 14U;
+    }
+    uint64_t const dt = now_ns() - t0;
+
+    printf("{\"bench\":\"timebomb_sm\",\"sm\":\"%s\",\"events\":%u,"
+           "\"ns_per_evt\":%.2f,\"trace\":%u}\n",
+           name, (unsigned)nEvt, (double)dt / (double)nEvt,
+           (unsigned)l_trace);
+}
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+}
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+
+    /* the state machines are dispatched directly, the AOs are not started */
+    TimeBomb_ctor(&l_qhsm);
+    TimeBombQM_ctor(&l_qmsm);
+
+    bench("qhsm", &l_qhsm.super.super, &l_qhsm.te);
+    uint32_t const trace = l_trace;
+    bench("qmsm", &l_qmsm.super.super.super, &l_qmsm.te);
+    Q_ASSERT(l_trace == trace); /* the same LED operations */
+    return 0;
+}
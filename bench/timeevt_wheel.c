@@ -0,0 +1,202 @@
+/******************************************************************************
+* @file    timeevt_wheel.c
+* @brief   Cost of QTimeEvt_tick_() with 10 to 10k armed time events,
+*          linked list vs hierarchical timing wheel (QF_TIMEEVT_WHEEL)
+*
+* 10, 100, 1k and 10k time events of a Sink AO are armed with pseudo-random
+* delays of 1..BENCH_SPAN ticks and kept armed for BENCH_TICKS ticks:
+*  - every 8th time event is periodic, with an interval of
+*    BENCH_BATCH..BENCH_SPAN ticks;
+*  - the other ones are one-shots, re-armed after they expire with a new
+*    delay, which is a hash of the time event and of the tick (so it does
+*    not depend on the order, in which the time events expiring at the same
+*    tick are posted).
+* The ticks are timed in batches of BENCH_BATCH back-to-back
+* QTIMEEVT_TICK_X() calls, which also post the expired time events to the
+* Sink's queue. Between the batches, the queue is drained (the Sink AO is
+* started, but QF_run() is never called) and every time event is checked
+* to have expired exactly at the tick it was due. The same source is built
+* twice and the "mode" field tells the two apart:
+*  - "list": the default linked list of the armed time events, which
+*    QTimeEvt_tick_() scans on every tick;
+*  - "wheel": QF_TIMEEVT_WHEEL, which touches only the time events that
+*    expire or cascade down a level at the tick.
+* Both builds fold every expiry together with its tick into a checksum,
+* which does not depend on the order within the tick, and must report the
+* same "fired" and "trace" for every number of armed time events.
+*
+* Build (from the repository root):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/timeevt_wheel.c -o timeevt_list
+*   gcc -O2 -DQF_TIMEEVT_WHEEL -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/timeevt_wheel.c -o timeevt_wheel
+*
+* Usage:
+*   ./timeevt_list; ./timeevt_wheel
+*
+* Output: one JSON object per number of armed time events, e.g.
+*   {"bench":"timeevt_wheel","mode":"wheel","armed":10000,"ticks":..,
+*    "fired":..,"ns_per_tick":..,"trace":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("timeevt_wheel")
+
+#define BENCH_MAX_ARMED  10000U
+#define BENCH_TICKS      32768U /* ticks per number of armed time events */
+#define BENCH_BATCH      32U    /* ticks timed back-to-back */
+#define BENCH_SPAN       16384U /* longest delay/interval [ticks] */
+#define BENCH_QLEN       250U   /* Sink queue (8-bit QEQueueCtr) */
+
+#ifdef QF_TIMEEVT_WHEEL
+    #define BENCH_MODE "wheel"
+#else
+    #define BENCH_MODE "list"
+#endif
+
+enum BenchSignals {
+    TIMEOUT_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+static QActive l_sink; /* owns the time events, never runs */
+static QEvt const *l_sinkQueueSto[BENCH_QLEN];
+
+static QTimeEvt l_te[BENCH_MAX_ARMED];
+static uint32_t l_due[BENCH_MAX_ARMED]; /* tick of the next expiry */
+
+static uint32_t l_tick;   /* ticks so far */
+static uint32_t l_fired;  /* expiries in the current run */
+static uint32_t l_trace;  /* checksum of the expiries and their ticks */
+static uint16_t l_queued[BENCH_BATCH]; /* queued events after every tick */
+
+/*..........................................................................*/
+static uint32_t mix(uint32_t x) { /* 32-bit hash finalizer */
+    x ^= x >> 16;
+    x *= 0x7FEB352DU;
+    x ^= x >> 15;
+    x *= 0x846CA68BU;
+    x ^= x >> 16;
+    return x;
+}
+/*..........................................................................*/
+static uint32_t delay_of(uint32_t const id, uint32_t const tick) {
+    return 1U + (mix((id * 0x9E3779B9U) ^ tick) % BENCH_SPAN);
+}
+/*..........................................................................*/
+static uint32_t interval_of(uint32_t const id) { /* 0 for one-shots */
+    return ((id % 8U) == 0U)
+           ? (BENCH_BATCH + (mix(id + 1U) % (BENCH_SPAN - BENCH_BATCH)))
+           : 0U;
+}
+/*..........................................................................*/
+static uint_fast16_t queued(void) {
+    return (uint_fast16_t)((BENCH_QLEN + 1U) - l_sink.eQueue.nFree);
+}
+
+/*..........................................................................*/
+static void arm(uint32_t const id) {
+    uint32_t const delay = delay_of(id, l_tick);
+    QTimeEvt_armX(&l_te[id], (QTimeEvtCtr)delay,
+                  (QTimeEvtCtr)interval_of(id));
+    l_due[id] = l_tick + delay;
+}
+/*..........................................................................*/
+static void drain(void) {
+    uint_fast8_t b = 0U; /* the tick of the batch that posted event i */
+    uint_fast16_t const n = queued();
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        while (i >= l_queued[b]) {
+            ++b;
+        }
+        uint32_t const tick = (l_tick - BENCH_BATCH) + b + 1U;
+
+        QTimeEvt const * const te = (QTimeEvt const *)QActive_get_(&l_sink);
+        uint32_t const id = (uint32_t)(te - &l_te[0]);
+        Q_ASSERT((id < BENCH_MAX_ARMED) && (l_due[id] == tick));
+
+        ++l_fired;
+        l_trace += mix(id ^ (tick * 0x85EBCA6BU));
+        if (interval_of(id) != 0U) { /* periodic? */
+            l_due[id] = tick + interval_of(id);
+        }
+        else {
+            arm(id); /* from the current tick */
+        }
+    }
+}
+/*..........................................................................*/
+static void bench(uint32_t const nArmed) {
+    l_fired = 0U;
+    l_trace = 0U;
+    for (uint32_t id = 0U; id < nArmed; ++id) {
+        arm(id);
+    }
+
+    uint64_t dt = 0U;
+    for (uint32_t k = 0U; k < (BENCH_TICKS / BENCH_BATCH); ++k) {
+        uint64_t const t0 = now_ns();
+        for (uint_fast8_t b = 0U; b < BENCH_BATCH; ++b) {
+            QTIMEEVT_TICK_X(0U, (void *)0);
+            l_queued[b] = (uint16_t)queued();
+        }
+        dt += now_ns() - t0;
+        l_tick += BENCH_BATCH;
+        drain();
+    }
+
+    for (uint32_t id = 0U; id < nArmed; ++id) {
+        (void)QTimeEvt_disarm(&l_te[id]);
+    }
+    /* the list unlinks the disarmed time events at the next tick */
+    QTIMEEVT_TICK_X(0U, (void *)0);
+    ++l_tick;
+    Q_ASSERT(QTimeEvt_noActive(0U) && (queued() == 0U));
+
+    printf("{\"bench\":\"timeevt_wheel\",\"mode\":\"%s\",\"armed\":%u,"
+           "\"ticks\":%u,\"fired\":%u,\"ns_per_tick\":%.1f,"
+           "\"trace\":%u}\n",
+           BENCH_MODE, (unsigned)nArmed, (unsigned)BENCH_TICKS,
+           (unsigned)l_fired, (double)dt / (double)BENCH_TICKS,
+           (unsigned)l_trace);
+}
+
+/*..........................................................................*/
+static QState Sink_idle(QActive * const me, QEvt const * const e) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(e);
+    return Q_SUPER(&QHsm_top);
+}
+static QState Sink_initial(QActive * const me, void const * const par) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Sink_idle);
+}
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+}
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+
+    /* the Sink AO is started, but never runs (QF_run() is not called) */
+    QActive_ctor(&l_sink, Q_STATE_CAST(&Sink_initial));
+    QACTIVE_START(&l_sink, 1U, l_sinkQueueSto, Q_DIM(l_sinkQueueSto),
+                  (void *)0, 0U, (void *)0);
+    for (uint32_t id = 0U; id < BENCH_MAX_ARMED; ++id) {
+        QTimeEvt_ctorX(&l_te[id], &l_sink, TIMEOUT_SIG, 0U);
+    }
+
+    for (uint32_t n = 10U; n <= BENCH_MAX_ARMED; n *= 10U) {
+        bench(n);
+    }
+    return 0;
+}
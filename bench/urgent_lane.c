@@ -0,0 +1,222 @@
+/******************************************************************************
+* @file    urgent_lane.c
+* @brief   Response to a critical event behind a backlog (QACTIVE_URGENT_LANE)
+*
+* A "Device" AO with a 32-entry queue (as timeBomb_queue) processes
+* TELEMETRY events (an RTC step of about TELEMETRY_WORK work units each).
+* With the QK scheduler locked, the benchmark posts a backlog of
+* TELEMETRY events, then a DEFUSE event and two more critical events
+* (ALARM1, ALARM2), and unlocks the scheduler. It measures how many RTC steps
+* run before DEFUSE and how long DEFUSE takes from post to dispatch.
+*  - "fifo": the critical events are posted with QACTIVE_POST() and wait
+*    behind the whole backlog;
+*  - "lifo": the critical events are posted with QACTIVE_POST_LIFO(), which
+*    jumps the queue, but reverses their order (ALARM2, ALARM1, DEFUSE);
+*  - "urgent": the critical events are posted with QACTIVE_POST_URGENT()
+*    to the urgent lane (built with QACTIVE_URGENT_LANE), which is checked
+*    before eQueue and keeps their FIFO order;
+*  - "urgent_lifo": DEFUSE and ALARM1 are posted urgent to the empty queue
+*    (DEFUSE becomes the front event, ahead of the urgent lane), ALARM2 is
+*    posted LIFO and the backlog follows. ALARM2 must not displace DEFUSE
+*    from the front of the queue, so the order stays DEFUSE, ALARM1, ALARM2.
+* The "order_ok" field tells if the critical events were processed in the
+* order of posting; "urgent_min" is the QF_getUrgentMin() watermark.
+*
+* Build (from the repository root):
+*   gcc -O2 -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/urgent_lane.c -o urgent_off
+*   gcc -O2 -DQACTIVE_URGENT_LANE -Iqpc/include -Iqpc/ports/posix/qk \
+*       qpc/src/qf/q*.c qpc/src/qk/qk.c qpc/ports/posix/qk/qk_port.c \
+*       bench/urgent_lane.c -o urgent_on
+*
+* Usage:
+*   ./urgent_off; ./urgent_on
+*
+* Output: one JSON object per line, e.g.
+*   {"bench":"urgent_lane","mode":"urgent","backlog":..,"steps_before":..,
+*    "ns_to_defuse":..,"order_ok":1,"urgent_min":..}
+******************************************************************************/
+#include "qpc.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_MODULE("urgent_lane")
+
+#define BENCH_ROUNDS    20000U /* backlog rounds per mode */
+#define BENCH_BACKLOG   28U    /* TELEMETRY events in the backlog */
+#define TELEMETRY_WORK  200U   /* work units of the TELEMETRY RTC step */
+
+enum BenchSignals {
+    TELEMETRY_SIG = Q_USER_SIG,
+    DEFUSE_SIG,
+    ALARM1_SIG,
+    ALARM2_SIG,
+    MAX_SIG
+};
+
+static QActive l_device;
+static QEvt const *l_deviceQueue[32];
+#ifdef QACTIVE_URGENT_LANE
+static QEvt const *l_deviceUrgent[4];
+#endif
+
+static QEvt const l_telemetryEvt = QEVT_INITIALIZER(TELEMETRY_SIG);
+static QEvt const l_defuseEvt    = QEVT_INITIALIZER(DEFUSE_SIG);
+static QEvt const l_alarm1Evt    = QEVT_INITIALIZER(ALARM1_SIG);
+static QEvt const l_alarm2Evt    = QEVT_INITIALIZER(ALARM2_SIG);
+
+static uint32_t volatile l_sink; /* defeats optimizing the work away */
+static uint32_t l_nSteps;        /* RTC steps in the current round */
+static uint32_t l_defuseStep;    /* RTC step that processed DEFUSE */
+static uint64_t l_defuseTime;    /* time when DEFUSE was processed */
+static uint8_t  l_order[3];      /* order of the critical events */
+static uint8_t  l_nOrder;
+
+/*..........................................................................*/
+static void do_work(uint32_t units) {
+    for (uint32_t i = 0U; i < units; ++i) {
+        l_sink = l_sink + i;
+    }
+}
+
+/*..........................................................................*/
+static QState Device_active(QActive * const me, QEvt const * const e) {
+    Q_UNUSED_PAR(me);
+    QState status;
+    ++l_nSteps;
+    switch (e->sig) {
+        case TELEMETRY_SIG: {
+            do_work(TELEMETRY_WORK);
+            status = Q_HANDLED();
+            break;
+        }
+        case DEFUSE_SIG: {
+            l_defuseTime = now_ns();
+            l_defuseStep = l_nSteps;
+            l_order[l_nOrder++] = 0U;
+            status = Q_HANDLED();
+            break;
+        }
+        case ALARM1_SIG: {
+            l_order[l_nOrder++] = 1U;
+            status = Q_HANDLED();
+            break;
+        }
+        case ALARM2_SIG: {
+            l_order[l_nOrder++] = 2U;
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            --l_nSteps; /* not an RTC step (init, entry, ...) */
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+static QState Device_initial(QActive * const me, void const * const par) {
+    Q_UNUSED_PAR(me);
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Device_active);
+}
+
+/*..........................................................................*/
+typedef enum { MODE_FIFO, MODE_LIFO, MODE_URGENT, MODE_URGENT_LIFO } Mode;
+
+static void postCritical(Mode mode, QEvt const * const e) {
+    switch (mode) {
+        case MODE_LIFO: {
+            QACTIVE_POST_LIFO(&l_device, e);
+            break;
+        }
+#ifdef QACTIVE_URGENT_LANE
+        case MODE_URGENT: {
+            QACTIVE_POST_URGENT(&l_device, e, (void *)0);
+            break;
+        }
+#endif
+        default: {
+            QACTIVE_POST(&l_device, e, (void *)0);
+            break;
+        }
+    }
+}
+/*..........................................................................*/
+static void postBacklog(void) {
+    for (uint_fast8_t i = 0U; i < BENCH_BACKLOG; ++i) {
+        QACTIVE_POST(&l_device, &l_telemetryEvt, (void *)0);
+    }
+}
+/*..........................................................................*/
+static void bench(Mode mode, char const *name) {
+    uint64_t stepsBefore = 0U;
+    uint64_t nsToDefuse = 0U;
+    bool orderOk = true;
+    for (uint32_t k = 0U; k < BENCH_ROUNDS; ++k) {
+        l_nSteps = 0U;
+        l_nOrder = 0U;
+        QSchedStatus const lockStat = QK_schedLock(1U);
+        if (mode != MODE_URGENT_LIFO) {
+            postBacklog();
+        }
+        uint64_t const t0 = now_ns();
+        if (mode == MODE_URGENT_LIFO) {
+            postCritical(MODE_URGENT, &l_defuseEvt); /* the front event */
+            postCritical(MODE_URGENT, &l_alarm1Evt);
+            postCritical(MODE_LIFO, &l_alarm2Evt);
+            postBacklog();
+        }
+        else {
+            postCritical(mode, &l_defuseEvt);
+            postCritical(mode, &l_alarm1Evt);
+            postCritical(mode, &l_alarm2Evt);
+        }
+        QK_schedUnlock(lockStat); /* runs the whole backlog */
+
+        Q_ASSERT(l_nOrder == 3U);
+        stepsBefore += l_defuseStep - 1U;
+        nsToDefuse += l_defuseTime - t0;
+        orderOk = orderOk && (l_order[0] == 0U) && (l_order[1] == 1U)
+                  && (l_order[2] == 2U);
+    }
+
+    unsigned urgentMin = 0U;
+#ifdef QACTIVE_URGENT_LANE
+    urgentMin = (unsigned)QF_getUrgentMin(l_device.prio);
+#endif
+    printf("{\"bench\":\"urgent_lane\",\"mode\":\"%s\",\"backlog\":%u,"
+           "\"steps_before\":%.1f,\"ns_to_defuse\":%.0f,\"order_ok\":%d,"
+           "\"urgent_min\":%u}\n",
+           name, (unsigned)BENCH_BACKLOG,
+           (double)stepsBefore / (double)BENCH_ROUNDS,
+           (double)nsToDefuse / (double)BENCH_ROUNDS,
+           orderOk ? 1 : 0, urgentMin);
+}
+
+/* QF callbacks ============================================================*/
+void QK_onIdle(void) {
+    bench(MODE_FIFO, "fifo");
+    bench(MODE_LIFO, "lifo");
+#ifdef QACTIVE_URGENT_LANE
+    bench(MODE_URGENT, "urgent");
+    bench(MODE_URGENT_LIFO, "urgent_lifo");
+#endif
+    exit(0);
+}
+
+/*..........................................................................*/
+int main(void) {
+    QF_init();
+
+    QActive_ctor(&l_device, Q_STATE_CAST(&Device_initial));
+#ifdef QACTIVE_URGENT_LANE
+    QActive_setUrgentLane(&l_device, l_deviceUrgent, Q_DIM(l_deviceUrgent));
+#endif
+    QACTIVE_START(&l_device, 1U, l_deviceQueue, Q_DIM(l_deviceQueue),
+                  (void *)0, 0U, (void *)0);
+    return QF_run();
+}
@@ -57,6 +57,10 @@
     #error "QF_EQUEUE_CTR_SIZE defined incorrectly, expected 1U, 2U, or 4U"
 #endif
 
+// QF_EQUEUE_POW2 (optional) requires power-of-two ring-buffer lengths,
+// so that the free-running head and tail counters index the ring with
+// a bitmask instead of the explicit wrap-around branches
+
 struct QEvt; // forward declaration
 
 //$declare${QF::QEQueue} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
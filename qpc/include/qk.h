@@ -43,6 +43,11 @@
 #ifndef QK_H_
 #define QK_H_
 
+#ifdef QACTIVE_ISR_RING
+// only the QV event loop drains the ISR rings (QActive_drainIsrRings_())
+#error QACTIVE_ISR_RING requires the QV kernel;
+#endif
+
 //$declare${QK::QK} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 
 //${QK::QK} ..................................................................
@@ -176,6 +181,15 @@ void QK_activate_(void);
     } \
 } while (false)
 #endif // def Q_UNSAFE
+
+#ifdef QF_EPOOL_MAG
+//${QK-impl::QF_MAG_ACT_} ....................................................
+// the AO running at QK_priv_.actPrio (none in ISRs and in the idle loop)
+#define QF_MAG_ACT_() \
+    ((QK_ISR_CONTEXT_() || (QK_priv_.actPrio == 0U) \
+      || (QK_priv_.actPrio > QF_MAX_ACTIVE)) \
+     ? (QActive *)0 : QActive_registry_[QK_priv_.actPrio])
+#endif // def QF_EPOOL_MAG
 //$enddecl${QK-impl} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
 //$declare${QF_EPOOL-impl} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
@@ -70,6 +70,13 @@
     #error "QF_MPOOL_CTR_SIZE defined incorrectly, expected 1U, 2U, or 4U"
 #endif
 
+#ifdef QF_MPOOL_LOCKFREE
+    // the lock-free free list swaps a tagged 64-bit head with one CAS
+    #if (__GCC_ATOMIC_LLONG_LOCK_FREE != 2)
+        #error "QF_MPOOL_LOCKFREE needs lock-free 64-bit atomics"
+    #endif
+#endif
+
 #define QF_MPOOL_EL(evType_) struct { \
     QFreeBlock sto_[((sizeof(evType_) - 1U) \
                       / sizeof(QFreeBlock)) + 1U]; }
@@ -104,8 +111,16 @@ typedef struct {
     //! @private @memberof QMPool
     QFreeBlock * end;
 
+#ifdef QF_MPOOL_LOCKFREE
+    //! @private @memberof QMPool
+    //! Tagged head of the free list: the modification count in the upper
+    //! 32 bits (against ABA) and the offset of the head block from start
+    //! plus one in the lower 32 bits (0 for the empty list).
+    uint64_t volatile free_head;
+#else
     //! @private @memberof QMPool
     QFreeBlock * volatile free_head;
+#endif // def QF_MPOOL_LOCKFREE
 
     //! @private @memberof QMPool
     QMPoolSize blockSize;
@@ -137,6 +152,28 @@ void * QMPool_get(QMPool * const me,
 void QMPool_put(QMPool * const me,
     void * const block,
     uint_fast8_t const qs_id);
+
+//! @public @memberof QMPool
+//!
+//! @details
+//! Gets up to `n` blocks into `blocks[]` at once (one critical section and
+//! one QS record), as long as the pool keeps more than `margin` free
+//! blocks. Returns the number of blocks actually obtained.
+uint_fast16_t QMPool_getN(QMPool * const me,
+    void ** const blocks,
+    uint_fast16_t const n,
+    uint_fast16_t const margin,
+    uint_fast8_t const qs_id);
+
+//! @public @memberof QMPool
+//!
+//! @details
+//! Returns the `n` blocks in `blocks[]` to the pool at once (one critical
+//! section and one QS record).
+void QMPool_putN(QMPool * const me,
+    void * const * const blocks,
+    uint_fast16_t const n,
+    uint_fast8_t const qs_id);
 //$enddecl${QF::QMPool} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
 #endif  // QMPOOL_H_
@@ -97,6 +97,116 @@
 #error QF_EVENT_SIZ_SIZE defined incorrectly, expected 1U, 2U, or 4U;
 #endif
 
+#ifdef QF_TIMEEVT_WHEEL
+
+#ifndef QF_TIMEEVT_WHEEL_BITS
+#define QF_TIMEEVT_WHEEL_BITS 6U
+#endif
+
+#ifndef QF_TIMEEVT_WHEEL_LEVELS
+#define QF_TIMEEVT_WHEEL_LEVELS 4U
+#endif
+
+#if ((QF_TIMEEVT_WHEEL_BITS * QF_TIMEEVT_WHEEL_LEVELS) > 32U)
+#error QF_TIMEEVT_WHEEL_BITS * QF_TIMEEVT_WHEEL_LEVELS exceeds 32U;
+#endif
+
+#endif // QF_TIMEEVT_WHEEL
+
+#ifdef QACTIVE_ISR_RING
+
+#ifndef QF_ISR_RING_BARRIER
+// memory barrier between the ring entries and the ring indices
+#define QF_ISR_RING_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#endif // QACTIVE_ISR_RING
+
+#ifdef QF_EPOOL_LUT
+
+#ifndef QF_EPOOL_LUT_SHIFT
+// log2 of the size-class granularity [bytes] of the event-pool lookup table
+// (the pool selection stays exactly "smallest pool that fits" as long as
+// 1 << QF_EPOOL_LUT_SHIFT divides sizeof(QFreeBlock); otherwise the table
+// may pick the next larger pool)
+#define QF_EPOOL_LUT_SHIFT 2U
+#endif
+
+#ifndef QF_EPOOL_LUT_SIZE
+// number of size classes covered by the event-pool lookup table
+#define QF_EPOOL_LUT_SIZE 32U
+#endif
+
+#if (QF_MAX_EPOOL == 0U) || (QF_EPOOL_LUT_SIZE == 0U)
+#error QF_EPOOL_LUT requires QF_MAX_EPOOL > 0U and QF_EPOOL_LUT_SIZE > 0U;
+#endif
+
+#endif // QF_EPOOL_LUT
+
+#ifdef QF_EPOOL_MAG
+
+// QF_EPOOL_MAG is the capacity [blocks] of the magazine of every AO for
+// every event pool (refilled and flushed by QF_EPOOL_MAG/2 blocks at once)
+#if (QF_MAX_EPOOL == 0U) || (QF_EPOOL_MAG < 2U) || (QF_EPOOL_MAG > 254U)
+#error QF_EPOOL_MAG requires QF_MAX_EPOOL > 0U and 2U <= QF_EPOOL_MAG <= 254U;
+#endif
+
+#endif // QF_EPOOL_MAG
+
+#ifdef QF_EVT_BUF
+
+#ifndef QF_MAX_BUFPOOL
+// maximum number of buffer pools for the external payloads (QEvtBuf)
+#define QF_MAX_BUFPOOL 2U
+#endif
+
+#if (QF_MAX_EPOOL == 0U) || (QF_MAX_BUFPOOL == 0U) || (QF_MAX_BUFPOOL > 15U)
+#error QF_EVT_BUF requires QF_MAX_EPOOL > 0U and 0U < QF_MAX_BUFPOOL <= 15U;
+#endif
+
+#endif // QF_EVT_BUF
+
+#ifdef QF_EPOOL_TRACK
+#if (QF_MAX_EPOOL == 0U)
+#error QF_EPOOL_TRACK requires QF_MAX_EPOOL > 0U;
+#endif
+#endif // QF_EPOOL_TRACK
+
+#if (defined QS_RTC_HIST) && !(defined Q_SPY)
+#undef QS_RTC_HIST // the RTC-step histograms need the QS time stamps
+#endif
+
+#ifdef QHSM_TRAN_CACHE
+
+#ifndef QHSM_TRAN_CACHE_SIZE
+// number of entries in one transition-path cache (QTranCache)
+#define QHSM_TRAN_CACHE_SIZE 8U
+#endif
+
+#if (QHSM_TRAN_CACHE_SIZE == 0U)
+#error QHSM_TRAN_CACHE requires QHSM_TRAN_CACHE_SIZE > 0U;
+#endif
+
+// maximum number of states exited or entered in one cached transition
+// (must match the maximum state nesting depth supported by QHsm)
+#define QHSM_TRAN_CACHE_DEPTH 6U
+
+#endif // QHSM_TRAN_CACHE
+
+#if (defined QHSM_SIG_MASK) || (defined QACTIVE_COALESCE)
+
+#ifndef QF_MAX_SIG
+// number of signals covered by the signal bitmasks
+// (QHsmSigMask and the coalesced signals of QActive)
+#define QF_MAX_SIG 64U
+#endif
+
+#if (QF_MAX_SIG <= 4U)
+#error QF_MAX_SIG must be larger than Q_USER_SIG
+#endif
+
+#endif // QHSM_SIG_MASK || QACTIVE_COALESCE
+
 //! @endcond
 //============================================================================
 
@@ -139,6 +249,12 @@ typedef uint32_t QSignal;
 //${QEP::QEVT_MARKER} ........................................................
 #define QEVT_MARKER 0xE0U
 
+#ifdef QF_EVT_BUF
+//${QEP::QEVT_XBUF} ..........................................................
+//! evtTag_ bit of the events that own an external buffer (::QEvtBuf)
+#define QEVT_XBUF 0x10U
+#endif // def QF_EVT_BUF
+
 //${QEP::QEVT_DYNAMIC} .......................................................
 #define QEVT_DYNAMIC 0U
 
@@ -179,8 +295,13 @@ static inline QEvt * QEvt_ctor(QEvt * const me,
 
 //! @private @memberof QEvt
 static inline bool QEvt_verify_(QEvt const * const me) {
+#ifdef QF_EVT_BUF
+    return (me != (QEvt const *)0)
+           && ((me->evtTag_ & (0xF0U & ~QEVT_XBUF)) == QEVT_MARKER);
+#else
     return (me != (QEvt const *)0)
            && ((me->evtTag_ & 0xF0U) == QEVT_MARKER);
+#endif // def QF_EVT_BUF
 }
 
 //! @private @memberof QEvt
@@ -188,6 +309,34 @@ static inline uint_fast8_t QEvt_getPoolId_(QEvt const * const me) {
     return (uint_fast8_t)me->evtTag_ & 0x0FU;
 }
 
+#ifdef QF_EVT_BUF
+//${QEP::QEvtBuf} ............................................................
+//! Dynamic event with an external payload buffer (zero-copy)
+//!
+//! @details
+//! The buffer comes from one of the buffer pools (QF_bufPoolInit()) and
+//! lives as long as the event: it is returned to its pool by QF_gc()
+//! together with the last reference to the event, so the payload can be
+//! posted or published to any number of AOs without copying. Application
+//! events with external buffers derive from QEvtBuf and are allocated
+//! with Q_NEW_BUF().
+typedef struct {
+    QEvt super; //!< @protected @memberof QEvtBuf
+
+    //! @public @memberof QEvtBuf
+    //! the external buffer (at least `size` bytes)
+    void * buf;
+
+    //! @public @memberof QEvtBuf
+    //! requested size of the buffer [bytes]
+    uint_fast16_t size;
+
+    //! @private @memberof QEvtBuf
+    //! buffer pool of the buffer (1-based)
+    uint8_t bufPoolId_;
+} QEvtBuf;
+#endif // def QF_EVT_BUF
+
 //${QEP::QStateRet} ..........................................................
 //! All possible values returned from state/action handlers
 //! @note
@@ -287,6 +436,22 @@ typedef struct {
 
     //! @protected @memberof QAsm
     union QAsmAttr temp;
+
+#ifdef QHSM_TRAN_CACHE
+    //! @private @memberof QAsm
+    struct QTranCache * tranCache;
+#endif // def QHSM_TRAN_CACHE
+
+#ifdef QHSM_SIG_MASK
+    //! @private @memberof QAsm
+    struct QHsmSigMask const * sigMasks;
+
+    //! @private @memberof QAsm
+    struct QHsmSigMask const * sigMask;
+
+    //! @private @memberof QAsm
+    uint8_t nSigMasks;
+#endif // def QHSM_SIG_MASK
 } QAsm;
 
 // protected:
@@ -361,12 +526,94 @@ int_fast8_t QHsm_tran_(
     QStateHandler * const path,
     uint_fast8_t const qs_id);
 
+#ifdef QHSM_TRAN_CACHE
+//! @private @memberof QHsm
+int_fast8_t QHsm_tranCached_(
+    QAsm * const me,
+    QStateHandler * const path,
+    uint_fast8_t const qs_id);
+
+// public:
+
+//! @public @memberof QHsm
+void QHsm_setTranCache(QHsm * const me,
+    struct QTranCache * const cache);
+#endif // def QHSM_TRAN_CACHE
+
+#ifdef QHSM_SIG_MASK
+//! @public @memberof QHsm
+void QHsm_setSigMasks(QHsm * const me,
+    struct QHsmSigMask * const masks,
+    uint_fast8_t const nMasks);
+#endif // def QHSM_SIG_MASK
+
 // protected:
 
 //! @protected @memberof QAsm
 QState QHsm_top(QHsm const * const me,
     QEvt const * const e);
 
+#ifdef QHSM_TRAN_CACHE
+//${QEP::QTranCache} .........................................................
+//! @class QTranCache
+//!
+//! @details
+//! Transition-path cache shared by all instances of one QHsm subclass.
+//! Every entry memoizes the states exited and entered by one transition
+//! (current state, source, target), so that QHsm_dispatch_() can repeat
+//! the transition without discovering the least common ancestor with the
+//! ::Q_EMPTY_SIG calls. The cache must be zero-initialized (e.g., a static
+//! object) and attached to the state machines with QHsm_setTranCache().
+typedef struct QTranCache {
+// private:
+
+    //! @private @memberof QTranCache
+    struct QTranCacheEntry {
+        QStateHandler leaf;   //!< current state when the event arrived
+        QStateHandler source; //!< source of the transition
+        QStateHandler target; //!< target of the transition
+        QStateHandler exitPath[QHSM_TRAN_CACHE_DEPTH];  //!< bottom-up
+        QStateHandler entryPath[QHSM_TRAN_CACHE_DEPTH]; //!< target first
+        uint8_t nExit; //!< number of states in exitPath[]
+        int8_t  ip;    //!< index of the first state to enter (-1: none)
+    } entry[QHSM_TRAN_CACHE_SIZE];
+} QTranCache;
+#endif // def QHSM_TRAN_CACHE
+
+#ifdef QHSM_SIG_MASK
+//${QEP::QHsmSigMask} ........................................................
+//! @class QHsmSigMask
+//!
+//! @details
+//! Signals handled by one state of a QHsm subclass. The application
+//! provides one entry for every state of the class (a table shared by all
+//! instances) with the state handler and the zero-terminated list of the
+//! signals that the state handler handles itself (including signals handled
+//! only conditionally, with a guard). QHsm_setSigMasks() fills in the rest,
+//! so that QHsm_dispatch_() can skip the states that do not handle a signal
+//! and drop the events that no state in the hierarchy handles.
+typedef struct QHsmSigMask {
+// public:
+
+    //! @public @memberof QHsmSigMask
+    QStateHandler state;
+
+    //! @public @memberof QHsmSigMask
+    QSignal const * sigs;
+
+// private:
+
+    //! @private @memberof QHsmSigMask
+    struct QHsmSigMask const * super;
+
+    //! @private @memberof QHsmSigMask
+    uint8_t own[(QF_MAX_SIG + 7U) / 8U];
+
+    //! @private @memberof QHsmSigMask
+    uint8_t any[(QF_MAX_SIG + 7U) / 8U];
+} QHsmSigMask;
+#endif // def QHSM_SIG_MASK
+
 //${QEP::QMsm} ...............................................................
 //! @class QMsm
 //! @extends QAsm
@@ -778,6 +1025,56 @@ typedef struct {
 
 //${QF::types::QEQueue} ......................................................
 struct QEQueue;
+
+//${QF::types::QIsrRing} .....................................................
+#ifdef QACTIVE_ISR_RING
+// @struct QIsrRing
+typedef struct {
+// private:
+
+    //! @private @memberof QIsrRing
+    QEvt const * volatile * ring;
+
+    //! @private @memberof QIsrRing
+    uint16_t end;
+
+    //! @private @memberof QIsrRing
+    uint16_t volatile head;
+
+    //! @private @memberof QIsrRing
+    uint16_t volatile tail;
+} QIsrRing;
+#endif // def QACTIVE_ISR_RING
+
+//${QF::types::QUrgentLane} ..................................................
+#ifdef QACTIVE_URGENT_LANE
+// @struct QUrgentLane
+typedef struct {
+// private:
+
+    //! @private @memberof QUrgentLane
+    QEvt const * * ring;
+
+    //! @private @memberof QUrgentLane
+    uint16_t end;
+
+    //! @private @memberof QUrgentLane
+    uint16_t head;
+
+    //! @private @memberof QUrgentLane
+    uint16_t tail;
+
+    //! @private @memberof QUrgentLane
+    uint16_t nFree;
+
+    //! @private @memberof QUrgentLane
+    uint16_t nMin;
+
+    //! @private @memberof QUrgentLane
+    //! the front event of eQueue is an urgent event (ahead of the lane)
+    bool inFront;
+} QUrgentLane;
+#endif // def QACTIVE_URGENT_LANE
 //$enddecl${QF::types} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
 //$declare${QF::QActive} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
@@ -810,6 +1107,52 @@ typedef struct QActive {
     //! @private @memberof QActive
     uint8_t pthre;
 
+#ifdef QACTIVE_ISR_RING
+    //! @private @memberof QActive
+    QIsrRing isrRing;
+#endif // def QACTIVE_ISR_RING
+
+#ifdef QS_RTC_HIST
+    //! @private @memberof QActive
+    //! post time stamps of the events in the ring buffer (parallel to it)
+    uint32_t * stampSto;
+
+    //! @private @memberof QActive
+    //! post time stamp of the front event
+    uint32_t frontStamp;
+
+    //! @private @memberof QActive
+    //! time stamp when the current event was taken from the queue
+    uint32_t rtcStart;
+
+    //! @private @memberof QActive
+    //! time the current event has waited in the queue
+    uint32_t rtcWait;
+#endif // def QS_RTC_HIST
+
+#ifdef QACTIVE_COALESCE
+    //! @private @memberof QActive
+    //! bitmask of the "latest-wins" signals (see QActive_setCoalesce())
+    uint8_t coalesce[(QF_MAX_SIG + 7U) / 8U];
+#endif // def QACTIVE_COALESCE
+
+#ifdef QACTIVE_URGENT_LANE
+    //! @private @memberof QActive
+    //! urgent events, delivered before the events in eQueue
+    QUrgentLane urgent;
+#endif // def QACTIVE_URGENT_LANE
+
+#ifdef QF_EPOOL_MAG
+    //! @private @memberof QActive
+    //! magazines: LIFO caches of free blocks of every event pool, used
+    //! without a critical section in the context of this AO only
+    void * magSto[QF_MAX_EPOOL][QF_EPOOL_MAG];
+
+    //! @private @memberof QActive
+    //! number of the free blocks in every magazine
+    uint8_t magCtr[QF_MAX_EPOOL];
+#endif // def QF_EPOOL_MAG
+
 // private:
 } QActive;
 
@@ -822,6 +1165,11 @@ extern QSubscrList * QActive_subscrList_;
 //! @static @private @memberof QActive
 extern enum_t QActive_maxPubSignal_;
 
+#ifdef QACTIVE_ISR_RING
+//! @static @private @memberof QActive
+extern uint8_t volatile QActive_isrRingPending_;
+#endif // def QACTIVE_ISR_RING
+
 // protected:
 
 //! @protected @memberof QActive
@@ -835,6 +1183,33 @@ void QActive_setAttr(QActive * const me,
     uint32_t attr1,
     void const * attr2);
 
+#ifdef QACTIVE_ISR_RING
+//! @public @memberof QActive
+void QActive_setIsrRing(QActive * const me,
+    QEvt const * * const ringSto,
+    uint_fast16_t const ringLen);
+#endif // def QACTIVE_ISR_RING
+
+#ifdef QS_RTC_HIST
+//! @public @memberof QActive
+void QActive_setStampSto(QActive * const me,
+    uint32_t * const stampSto,
+    uint_fast16_t const stampLen);
+#endif // def QS_RTC_HIST
+
+#ifdef QACTIVE_COALESCE
+//! @public @memberof QActive
+void QActive_setCoalesce(QActive * const me,
+    QSignal const * const sigs);
+#endif // def QACTIVE_COALESCE
+
+#ifdef QACTIVE_URGENT_LANE
+//! @public @memberof QActive
+void QActive_setUrgentLane(QActive * const me,
+    QEvt const * * const laneSto,
+    uint_fast16_t const laneLen);
+#endif // def QACTIVE_URGENT_LANE
+
 // private:
 
 //! @private @memberof QActive
@@ -867,10 +1242,34 @@ bool QActive_post_(QActive * const me,
     uint_fast16_t const margin,
     void const * const sender);
 
+//! @private @memberof QActive
+bool QActive_postN_(QActive * const me,
+    QEvt const * const * const events,
+    uint_fast16_t const n,
+    uint_fast16_t const margin,
+    void const * const sender);
+
 //! @private @memberof QActive
 void QActive_postLIFO_(QActive * const me,
     QEvt const * const e);
 
+#ifdef QACTIVE_URGENT_LANE
+//! @private @memberof QActive
+bool QActive_postUrgent_(QActive * const me,
+    QEvt const * const e,
+    uint_fast16_t const margin,
+    void const * const sender);
+#endif // def QACTIVE_URGENT_LANE
+
+#ifdef QACTIVE_ISR_RING
+//! @private @memberof QActive
+bool QActive_postFromISR_(QActive * const me,
+    QEvt const * const e);
+
+//! @static @private @memberof QActive
+void QActive_drainIsrRings_(void);
+#endif // def QACTIVE_ISR_RING
+
 //! @private @memberof QActive
 QEvt const * QActive_get_(QActive * const me);
 
@@ -960,6 +1359,14 @@ typedef struct QTimeEvt {
 
     //! @private @memberof QTimeEvt
     QTimeEvtCtr interval;
+
+#ifdef QF_TIMEEVT_WHEEL
+    //! @private @memberof QTimeEvt
+    struct QTimeEvt * volatile * pprev;
+
+    //! @private @memberof QTimeEvt
+    QTimeEvtCtr expiry;
+#endif // def QF_TIMEEVT_WHEEL
 } QTimeEvt;
 
 //! @static @private @memberof QTimeEvt
@@ -996,6 +1403,30 @@ void QTimeEvt_tick_(
     uint_fast8_t const tickRate,
     void const * const sender);
 
+#ifdef QF_TICKLESS
+//! @static @private @memberof QTimeEvt
+void QTimeEvt_tickN_(
+    uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks,
+    void const * const sender);
+
+//! @static @public @memberof QTimeEvt
+QTimeEvtCtr QTimeEvt_nextExpiry(uint_fast8_t const tickRate);
+#endif // def QF_TICKLESS
+
+#ifdef QF_TIMEEVT_ABS
+//! @static @private @memberof QTimeEvt
+extern uint64_t QTimeEvt_tickCtr_[QF_MAX_TICK_RATE];
+
+//! @static @public @memberof QTimeEvt
+uint64_t QTimeEvt_getTick(uint_fast8_t const tickRate);
+
+//! @public @memberof QTimeEvt
+void QTimeEvt_armAt(QTimeEvt * const me,
+    uint64_t const deadline,
+    QTimeEvtCtr const interval);
+#endif // def QF_TIMEEVT_ABS
+
 // private:
 
 #ifdef Q_UTEST
@@ -1065,6 +1496,12 @@ int_t QF_run(void);
 //! @static @public @memberof QF
 uint_fast16_t QF_getQueueMin(uint_fast8_t const prio);
 
+#ifdef QACTIVE_URGENT_LANE
+//${QF::QF-base::getUrgentMin} ...............................................
+//! @static @public @memberof QF
+uint_fast16_t QF_getUrgentMin(uint_fast8_t const prio);
+#endif // def QACTIVE_URGENT_LANE
+
 //${QF::QF-base::onStartup} ..................................................
 //! @static @public @memberof QF
 void QF_onStartup(void);
@@ -1080,10 +1517,43 @@ void QF_onContextSw(
     QActive * prev,
     QActive * next);
 #endif // def QF_ON_CONTEXT_SW
+
+//${QF::QF-base::onTickActive} ...............................................
+#ifdef QF_ON_TICK_ACTIVE
+//! @static @public @memberof QF
+void QF_onTickActive(
+    uint_fast8_t const tickRate,
+    bool const active);
+#endif // def QF_ON_TICK_ACTIVE
 //$enddecl${QF::QF-base} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
 //$declare${QF::QF-dyn} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 
+#ifdef QF_EPOOL_TRACK
+//${QF::QF-dyn::QEvtSite} ....................................................
+//! Allocation record of one block of an event pool (QF_EPOOL_TRACK)
+//!
+//! @details
+//! The application provides one QEvtSite per block of the tracked event
+//! pools (QF_poolSetSiteSto()). The record is filled when the block is
+//! allocated as an event and cleared when the event is recycled, so the
+//! records with a non-NULL `file` are the outstanding events.
+typedef struct {
+    //! source file of the allocation (NULL for a free block, "?" for an
+    //! allocation without a Q_NEW...() site, e.g., QF_newX_())
+    char const * file;
+
+    //! time stamp of the allocation (see QF_EPOOL_TRACK_TIME())
+    uint32_t time;
+
+    //! source line of the allocation
+    uint16_t line;
+
+    //! signal of the event at the allocation
+    QSignal sig;
+} QEvtSite;
+#endif // def QF_EPOOL_TRACK
+
 //${QF::QF-dyn::poolInit} ....................................................
 //! @static @public @memberof QF
 void QF_poolInit(
@@ -1099,6 +1569,71 @@ uint_fast16_t QF_poolGetMaxBlockSize(void);
 //! @static @public @memberof QF
 uint_fast16_t QF_getPoolMin(uint_fast8_t const poolId);
 
+#ifdef QF_EPOOL_TRACK
+//${QF::QF-dyn::poolSetSiteSto} ..............................................
+//! @static @public @memberof QF
+//!
+//! @details
+//! Starts tracking the allocations of the event pool `poolId` (1-based)
+//! in the side table `siteSto[]`, one record per block of the pool, so
+//! `siteLen` must be at least the number of blocks in the pool. The
+//! events allocated before this call are not tracked.
+void QF_poolSetSiteSto(
+    uint_fast8_t const poolId,
+    QEvtSite * const siteSto,
+    uint_fast16_t const siteLen);
+
+//${QF::QF-dyn::poolForEachLive} .............................................
+//! @static @public @memberof QF
+//!
+//! @details
+//! Calls `visit()` with a snapshot of the allocation record of every
+//! outstanding event of the tracked event pool `poolId` (every tracked
+//! pool for `poolId` == 0) and returns the number of such events. Meant
+//! for dumping the suspected leaks, e.g., from Q_onError() on the host.
+uint_fast16_t QF_poolForEachLive(
+    uint_fast8_t const poolId,
+    void (* const visit)(uint_fast8_t poolId, uint_fast16_t block,
+                         QEvtSite const * site));
+
+//${QF::QF-dyn::evtSite_} ....................................................
+//! @static @private @memberof QF
+//!
+//! @details
+//! Stores the allocation site in the record of the `n` events `evts[]`
+//! just allocated by Q_NEW...(); returns `n`.
+uint_fast16_t QF_evtSite_(
+    QEvt * const * const evts,
+    uint_fast16_t const n,
+    char const * const file,
+    int_t const line);
+
+//${QF::QF-dyn::evtSite1_} ...................................................
+//! @static @private @memberof QF
+//! QF_evtSite_() for a single event `e` (possibly NULL); returns `e`
+static inline QEvt * QF_evtSite1_(QEvt * const e,
+    char const * const file,
+    int_t const line)
+{
+    if (e != (QEvt *)0) {
+        (void)QF_evtSite_(&e, 1U, file, line);
+    }
+    return e;
+}
+
+#ifdef Q_SPY
+//${QF::QF-dyn::poolTrackReport_} ............................................
+//! @static @private @memberof QF
+//!
+//! @details
+//! Reports the outstanding events of the tracked event pool `poolId`
+//! (every tracked pool for `poolId` == 0) as #QS_EPOOL_TRACK_REC records.
+//! Invoked by the QS-RX command #QS_EPOOL_TRACK_CMD and before the
+//! assertion of a failed allocation with QF_NO_MARGIN.
+void QF_poolTrackReport_(uint_fast8_t const poolId);
+#endif // def Q_SPY
+#endif // def QF_EPOOL_TRACK
+
 //${QF::QF-dyn::newX_} .......................................................
 //! @static @private @memberof QF
 QEvt * QF_newX_(
@@ -1106,6 +1641,31 @@ QEvt * QF_newX_(
     uint_fast16_t const margin,
     enum_t const sig);
 
+//${QF::QF-dyn::newP_} .......................................................
+//! @static @private @memberof QF
+//!
+//! @details
+//! Same as QF_newX_(), but with the event pool possibly already resolved
+//! by QF_EPOOL_ID_(). The `lutPoolId` of 0 means that the pool is not known
+//! and must be found by scanning the registered pools.
+QEvt * QF_newP_(
+    uint_fast8_t const lutPoolId,
+    uint_fast16_t const evtSize,
+    uint_fast16_t const margin,
+    enum_t const sig);
+
+#ifdef QF_EPOOL_LUT
+//${QF::QF-dyn::ePoolLut_} ...................................................
+//! @static @private @memberof QF
+//!
+//! @details
+//! Maps the event-size class `(evtSize - 1) >> QF_EPOOL_LUT_SHIFT` to the
+//! 1-based id of the smallest event pool that fits all the sizes in that
+//! class (0 if no pool fits). The table is rebuilt in QF_poolInit() and
+//! is only read afterwards, so it can be read outside of a critical section.
+extern uint8_t QF_ePoolLut_[QF_EPOOL_LUT_SIZE];
+#endif // def QF_EPOOL_LUT
+
 //${QF::QF-dyn::gc} ..........................................................
 //! @static @public @memberof QF
 void QF_gc(QEvt const * const e);
@@ -1123,6 +1683,63 @@ void QF_deleteRef_(void const * const evtRef);
 //${QF::QF-dyn::gcFromISR} ...................................................
 //! @static @public @memberof QF
 void QF_gcFromISR(QEvt const * const e);
+
+//${QF::QF-dyn::newN} ........................................................
+//! @static @public @memberof QF
+//!
+//! @details
+//! Allocates up to `n` dynamic events of the size `evtSize` and the
+//! signal `sig` into `evts[]`, all from the same event pool and in one
+//! critical section. Returns the number of events allocated, which can
+//! be less than `n` only when the pool runs down to the `margin`; with
+//! QF_NO_MARGIN, anything less than `n` is an error.
+uint_fast16_t QF_newN(
+    QEvt ** const evts,
+    uint_fast16_t const n,
+    uint_fast16_t const evtSize,
+    uint_fast16_t const margin,
+    enum_t const sig);
+
+//${QF::QF-dyn::gcN} .........................................................
+//! @static @public @memberof QF
+//!
+//! @details
+//! QF_gc() for the `n` > 0 events in `evts[]`, which must all come from
+//! the same event pool (e.g., from one QF_newN()). The events recycled
+//! by this call go back to the pool in one critical section. The order
+//! of `evts[]` is not preserved.
+void QF_gcN(
+    QEvt const ** const evts,
+    uint_fast16_t const n);
+
+#ifdef QF_EVT_BUF
+//${QF::QF-dyn::bufPoolInit} .................................................
+//! @static @public @memberof QF
+//!
+//! @details
+//! Initializes a buffer pool for the external payloads of ::QEvtBuf
+//! events. Like the event pools, the buffer pools must be initialized in
+//! the ascending order of their buffer sizes.
+void QF_bufPoolInit(
+    void * const poolSto,
+    uint_fast32_t const poolSize,
+    uint_fast16_t const bufSize);
+
+//${QF::QF-dyn::newBuf_} .....................................................
+//! @static @private @memberof QF
+//!
+//! @details
+//! Allocates a dynamic event of the size `evtSize` (::QEvtBuf or its
+//! subclass) from the event pools, together with a buffer of at least
+//! `bufSize` bytes from the smallest buffer pool that fits. Returns NULL
+//! when either allocation would break the `margin` (both, or neither,
+//! are allocated); with QF_NO_MARGIN, a failed allocation is an error.
+QEvtBuf * QF_newBuf_(
+    uint_fast16_t const evtSize,
+    uint_fast16_t const bufSize,
+    uint_fast16_t const margin,
+    enum_t const sig);
+#endif // def QF_EVT_BUF
 //$enddecl${QF::QF-dyn} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
 //$declare${QF-macros} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
@@ -1133,33 +1750,110 @@ void QF_gcFromISR(QEvt const * const e);
 //${QF-macros::Q_PRIO} .......................................................
 #define Q_PRIO(prio_, pthre_) ((QPrioSpec)((prio_) | ((pthre_) << 8U)))
 
+//${QF-macros::QF_EPOOL_ID_} .................................................
+#ifdef QF_EPOOL_LUT
+//! 1-based id of the event pool for the given event size (0 if the size
+//! is beyond the lookup table). For a compile-time constant size, such as
+//! `sizeof(evtT_)` in Q_NEW(), the size class and the range check fold into
+//! constants and only a single table load remains. (The modulo only keeps
+//! the index of the not-taken branch within the table bounds.)
+#define QF_EPOOL_ID_(size_) \
+    ((((uint_fast16_t)(size_) - 1U) >> QF_EPOOL_LUT_SHIFT) < QF_EPOOL_LUT_SIZE \
+     ? (uint_fast8_t)QF_ePoolLut_[(((uint_fast16_t)(size_) - 1U) \
+           >> QF_EPOOL_LUT_SHIFT) % QF_EPOOL_LUT_SIZE] \
+     : 0U)
+#endif // def QF_EPOOL_LUT
+
+//${QF-macros::QF_NEW_} ......................................................
+//! allocate a dynamic event of a compile-time size, without a pool scan
+//! when the size is covered by the event-pool lookup table
+#ifdef QF_EPOOL_LUT
+#define QF_NEW_(size_, margin_, sig_) \
+    QF_SITE_(QF_newP_(QF_EPOOL_ID_(size_), (uint_fast16_t)(size_), \
+                      (margin_), (sig_)))
+#else
+#define QF_NEW_(size_, margin_, sig_) \
+    QF_SITE_(QF_newP_(0U, (uint_fast16_t)(size_), (margin_), (sig_)))
+#endif // def QF_EPOOL_LUT
+
+//${QF-macros::QF_SITE_} .....................................................
+//! record the allocation site of the event `e_` (QF_EPOOL_TRACK)
+#ifdef QF_EPOOL_TRACK
+#define QF_SITE_(e_) QF_evtSite1_((e_), __FILE__, (int_t)__LINE__)
+#else
+#define QF_SITE_(e_) (e_)
+#endif // def QF_EPOOL_TRACK
+
 //${QF-macros::Q_NEW} ........................................................
 #ifndef QEVT_DYN_CTOR
-#define Q_NEW(evtT_, sig_) ((evtT_ *)QF_newX_((uint_fast16_t)sizeof(evtT_), \
+#define Q_NEW(evtT_, sig_) ((evtT_ *)QF_NEW_(sizeof(evtT_), \
                            QF_NO_MARGIN, (enum_t)(sig_)))
 #endif // ndef QEVT_DYN_CTOR
 
 //${QF-macros::Q_NEW} ........................................................
 #ifdef QEVT_DYN_CTOR
 #define Q_NEW(evtT_, sig_, ...) \
-    (evtT_##_ctor((evtT_ *)QF_newX_((uint_fast16_t)sizeof(evtT_), \
+    (evtT_##_ctor((evtT_ *)QF_NEW_(sizeof(evtT_), \
                   QF_NO_MARGIN, (sig_)), __VA_ARGS__))
 #endif // def QEVT_DYN_CTOR
 
 //${QF-macros::Q_NEW_X} ......................................................
 #ifndef QEVT_DYN_CTOR
 #define Q_NEW_X(evtT_, margin_, sig_) \
-    ((evtT_ *)QF_newX_((uint_fast16_t)sizeof(evtT_), \
+    ((evtT_ *)QF_NEW_(sizeof(evtT_), \
                       (margin_), (enum_t)(sig_)))
 #endif // ndef QEVT_DYN_CTOR
 
 //${QF-macros::Q_NEW_X} ......................................................
 #ifdef QEVT_DYN_CTOR
 #define Q_NEW_X(evtT_, margin_, sig_, ...) \
-    (evtT_##_ctor((evtT_ *)QF_newX_((uint_fast16_t)sizeof(evtT_), \
+    (evtT_##_ctor((evtT_ *)QF_NEW_(sizeof(evtT_), \
                   (margin_), (sig_)), __VA_ARGS__))
 #endif // def QEVT_DYN_CTOR
 
+//${QF-macros::Q_NEW_N} ......................................................
+//! allocate `n_` dynamic events of the type `evtT_` into the array `evts_`
+//! at once (no constructor arguments, see QF_newN())
+#ifndef QF_EPOOL_TRACK
+#define Q_NEW_N(evtT_, evts_, n_, sig_) \
+    ((void)QF_newN((QEvt **)(evts_), (uint_fast16_t)(n_), \
+        (uint_fast16_t)sizeof(evtT_), QF_NO_MARGIN, (enum_t)(sig_)))
+#else
+#define Q_NEW_N(evtT_, evts_, n_, sig_) \
+    ((void)QF_evtSite_((QEvt **)(evts_), \
+        QF_newN((QEvt **)(evts_), (uint_fast16_t)(n_), \
+            (uint_fast16_t)sizeof(evtT_), QF_NO_MARGIN, (enum_t)(sig_)), \
+        __FILE__, (int_t)__LINE__))
+#endif // ndef QF_EPOOL_TRACK
+
+//${QF-macros::Q_NEW_N_X} ....................................................
+//! allocate up to `n_` dynamic events (the number allocated is returned)
+#ifndef QF_EPOOL_TRACK
+#define Q_NEW_N_X(evtT_, evts_, n_, margin_, sig_) \
+    (QF_newN((QEvt **)(evts_), (uint_fast16_t)(n_), \
+        (uint_fast16_t)sizeof(evtT_), (margin_), (enum_t)(sig_)))
+#else
+#define Q_NEW_N_X(evtT_, evts_, n_, margin_, sig_) \
+    (QF_evtSite_((QEvt **)(evts_), \
+        QF_newN((QEvt **)(evts_), (uint_fast16_t)(n_), \
+            (uint_fast16_t)sizeof(evtT_), (margin_), (enum_t)(sig_)), \
+        __FILE__, (int_t)__LINE__))
+#endif // ndef QF_EPOOL_TRACK
+
+#ifdef QF_EVT_BUF
+//${QF-macros::Q_NEW_BUF} ....................................................
+//! allocate a dynamic event of the type `evtT_` (::QEvtBuf or subclass)
+//! with an external buffer of `size_` bytes (the event's `buf`)
+#define Q_NEW_BUF(evtT_, size_, sig_) \
+    ((evtT_ *)QF_SITE_((QEvt *)QF_newBuf_((uint_fast16_t)sizeof(evtT_), \
+        (uint_fast16_t)(size_), QF_NO_MARGIN, (enum_t)(sig_))))
+
+//${QF-macros::Q_NEW_BUF_X} ..................................................
+#define Q_NEW_BUF_X(evtT_, size_, margin_, sig_) \
+    ((evtT_ *)QF_SITE_((QEvt *)QF_newBuf_((uint_fast16_t)sizeof(evtT_), \
+        (uint_fast16_t)(size_), (margin_), (enum_t)(sig_))))
+#endif // def QF_EVT_BUF
+
 //${QF-macros::Q_NEW_REF} ....................................................
 #define Q_NEW_REF(evtRef_, evtT_) \
     ((evtRef_) = (evtT_ const *)QF_newRef_(e, (evtRef_)))
@@ -1199,6 +1893,58 @@ void QF_gcFromISR(QEvt const * const e);
     (QActive_post_((me_), (e_), (margin_), (void *)0))
 #endif // ndef Q_SPY
 
+//${QF-macros::QACTIVE_POST_N} ...............................................
+#ifdef Q_SPY
+#define QACTIVE_POST_N(me_, events_, n_, sender_) \
+    ((void)QActive_postN_((me_), (events_), (n_), QF_NO_MARGIN, (sender_)))
+#endif // def Q_SPY
+
+//${QF-macros::QACTIVE_POST_N} ...............................................
+#ifndef Q_SPY
+#define QACTIVE_POST_N(me_, events_, n_, dummy) \
+    ((void)QActive_postN_((me_), (events_), (n_), QF_NO_MARGIN, (void *)0))
+#endif // ndef Q_SPY
+
+//${QF-macros::QACTIVE_POST_N_X} .............................................
+#ifdef Q_SPY
+#define QACTIVE_POST_N_X(me_, events_, n_, margin_, sender_) \
+    (QActive_postN_((me_), (events_), (n_), (margin_), (sender_)))
+#endif // def Q_SPY
+
+//${QF-macros::QACTIVE_POST_N_X} .............................................
+#ifndef Q_SPY
+#define QACTIVE_POST_N_X(me_, events_, n_, margin_, dummy) \
+    (QActive_postN_((me_), (events_), (n_), (margin_), (void *)0))
+#endif // ndef Q_SPY
+
+//${QF-macros::QACTIVE_POST_FROM_ISR} ........................................
+#ifdef QACTIVE_ISR_RING
+#define QACTIVE_POST_FROM_ISR(me_, e_) \
+    (QActive_postFromISR_((me_), (e_)))
+#endif // def QACTIVE_ISR_RING
+
+//${QF-macros::QACTIVE_POST_URGENT} ..........................................
+#ifdef QACTIVE_URGENT_LANE
+#ifdef Q_SPY
+#define QACTIVE_POST_URGENT(me_, e_, sender_) \
+    ((void)QActive_postUrgent_((me_), (e_), QF_NO_MARGIN, (sender_)))
+#else
+#define QACTIVE_POST_URGENT(me_, e_, dummy) \
+    ((void)QActive_postUrgent_((me_), (e_), QF_NO_MARGIN, (void *)0))
+#endif // def Q_SPY
+#endif // def QACTIVE_URGENT_LANE
+
+//${QF-macros::QACTIVE_POST_URGENT_X} ........................................
+#ifdef QACTIVE_URGENT_LANE
+#ifdef Q_SPY
+#define QACTIVE_POST_URGENT_X(me_, e_, margin_, sender_) \
+    (QActive_postUrgent_((me_), (e_), (margin_), (sender_)))
+#else
+#define QACTIVE_POST_URGENT_X(me_, e_, margin_, dummy) \
+    (QActive_postUrgent_((me_), (e_), (margin_), (void *)0))
+#endif // def Q_SPY
+#endif // def QACTIVE_URGENT_LANE
+
 //${QF-macros::QACTIVE_POST_LIFO} ............................................
 #define QACTIVE_POST_LIFO(me_, e_) \
     (QActive_postLIFO_((me_), (e_)))
@@ -1227,6 +1973,20 @@ void QF_gcFromISR(QEvt const * const e);
 //${QF-macros::QTIMEEVT_TICK} ................................................
 #define QTIMEEVT_TICK(sender_) QTIMEEVT_TICK_X(0U, (sender_))
 
+#ifdef QF_TICKLESS
+//${QF-macros::QTIMEEVT_TICKN_X} .............................................
+#ifdef Q_SPY
+#define QTIMEEVT_TICKN_X(tickRate_, nTicks_, sender_) \
+    (QTimeEvt_tickN_((tickRate_), (nTicks_), (sender_)))
+#endif // def Q_SPY
+
+//${QF-macros::QTIMEEVT_TICKN_X} .............................................
+#ifndef Q_SPY
+#define QTIMEEVT_TICKN_X(tickRate_, nTicks_, dummy) \
+    (QTimeEvt_tickN_((tickRate_), (nTicks_), (void *)0))
+#endif // ndef Q_SPY
+#endif // def QF_TICKLESS
+
 //${QF-macros::QTICKER_TRIG} .................................................
 #ifdef Q_SPY
 #define QTICKER_TRIG(ticker_, sender_) (QTicker_trig_((ticker_), (sender_)))
@@ -60,6 +60,21 @@ typedef struct {
     uint_fast8_t maxPool_;
 #endif //  (QF_MAX_EPOOL > 0U)
 
+#ifdef QF_EVT_BUF
+    //! @private @memberof QF_Attr
+    //! buffer pools of the external payloads (::QEvtBuf)
+    QF_EPOOL_TYPE_ bufPool_[QF_MAX_BUFPOOL];
+
+    //! @private @memberof QF_Attr
+    uint_fast8_t maxBufPool_;
+#endif // def QF_EVT_BUF
+
+#ifdef QF_EPOOL_TRACK
+    //! @private @memberof QF_Attr
+    //! allocation records of the tracked event pools (NULL if not tracked)
+    QEvtSite * siteSto_[QF_MAX_EPOOL];
+#endif // def QF_EPOOL_TRACK
+
 #if (QF_MAX_EPOOL == 0U)
     //! @private @memberof QF_Attr
     uint8_t dummy;
@@ -77,12 +92,70 @@ void QF_bzero_(
     uint_fast16_t const len);
 //$enddecl${QF::QF-pkg} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
+#ifdef QF_TIMEEVT_WHEEL
+
+//! number of slots in one level of the time-event wheel
+#define QTE_WHEEL_SIZE     (1U << QF_TIMEEVT_WHEEL_BITS)
+
+//! @class QTimeWheel
+//! Hierarchical timing wheel holding the armed time events of one tick rate
+typedef struct {
+// private:
+
+    //! @private @memberof QTimeWheel
+    QTimeEvt * volatile slot[QF_TIMEEVT_WHEEL_LEVELS][QTE_WHEEL_SIZE];
+
+    //! @private @memberof QTimeWheel
+    QTimeEvt * volatile pending; // slot detached by QTimeEvt_tick_()
+
+    //! @private @memberof QTimeWheel
+    QTimeEvtCtr now; // current tick of this rate
+
+    //! @private @memberof QTimeWheel
+    uint_fast16_t nLinked; // # time events linked into the wheel
+} QTimeWheel;
+
+//! @static @private @memberof QTimeEvt
+extern QTimeWheel QTimeEvt_wheel_[QF_MAX_TICK_RATE];
+
+#endif // def QF_TIMEEVT_WHEEL
+
 // Bitmasks are for the QTimeEvt::refCtr_ attribute (inherited from ::QEvt).
 // In ::QTimeEvt this attribute is NOT used for reference counting.
 #define QTE_IS_LINKED      (1U << 7U)
 #define QTE_WAS_DISARMED   (1U << 6U)
 #define QTE_TICK_RATE      0x0FU
 
+#ifdef QF_MPOOL_LOCKFREE
+
+// QF_gc() drops the references without the critical section
+//! @private @memberof QEvt
+static inline void QEvt_refCtr_inc_(QEvt const *me) {
+    (void)__atomic_fetch_add(&((QEvt *)me)->refCtr_, 1U, __ATOMIC_RELAXED);
+}
+
+//! @private @memberof QEvt
+static inline void QEvt_refCtr_dec_(QEvt const *me) {
+    (void)__atomic_fetch_sub(&((QEvt *)me)->refCtr_, 1U, __ATOMIC_ACQ_REL);
+}
+
+// checks on the lock-free paths enter the critical section only to report
+// the failure
+#ifndef Q_UNSAFE
+#define QF_ASSERT_LF_(id_, expr_) do { \
+    if (!(expr_)) { \
+        QF_CRIT_STAT \
+        QF_CRIT_ENTRY(); \
+        Q_ERROR_INCRIT(id_); \
+        QF_CRIT_EXIT(); \
+    } \
+} while (false)
+#else
+#define QF_ASSERT_LF_(id_, expr_) ((void)0)
+#endif // ndef Q_UNSAFE
+
+#else
+
 //! @private @memberof QEvt
 static inline void QEvt_refCtr_inc_(QEvt const *me) {
     ++((QEvt *)me)->refCtr_;
@@ -93,6 +166,23 @@ static inline void QEvt_refCtr_dec_(QEvt const *me) {
     --((QEvt *)me)->refCtr_;
 }
 
+#endif // def QF_MPOOL_LOCKFREE
+
+#ifdef QF_EPOOL_MAG
+
+// QF_MAG_ACT_() is provided by the kernel or the port: the AO whose
+// magazines the caller may use without a critical section, or NULL
+// (e.g., in ISRs and in other threads than the AO's)
+#ifndef QF_MAG_ACT_
+#error QF_EPOOL_MAG is not supported by this kernel/port (no QF_MAG_ACT_());
+#endif
+
+//! @static @private @memberof QF
+//! returns all the blocks in the magazines of the AO `act` to the pools
+void QF_magFlush_(QActive * const act);
+
+#endif // def QF_EPOOL_MAG
+
 #define QACTIVE_CAST_(ptr_) ((QActive *)(ptr_))
 #define Q_UINTPTR_CAST_(ptr_) ((uintptr_t)(ptr_))
 
@@ -58,6 +58,53 @@
 #define QS_TIME_SIZE 4U
 #endif
 
+#ifdef QS_RTC_HIST
+
+#ifndef QS_RTC_HIST_SLOTS
+// number of the (active object, signal) histogram slots
+#define QS_RTC_HIST_SLOTS 16U
+#endif
+
+#ifndef QS_RTC_HIST_BINS
+// number of the log2 bins per histogram (the last bin is open-ended)
+#define QS_RTC_HIST_BINS 16U
+#endif
+
+#ifndef QS_RTC_HIST_SHIFT
+// log2 of the width [QS time-stamp ticks] of the first bin
+#define QS_RTC_HIST_SHIFT 4U
+#endif
+
+#ifndef QS_RTC_HIST_CMD
+// QS-RX command id reserved for the histogram query
+#define QS_RTC_HIST_CMD 0xF0U
+#endif
+
+#ifndef QS_RTC_HIST_REC
+// QS application-specific record used for the histogram reports
+#define QS_RTC_HIST_REC ((enum_t)QS_USER + 24)
+#endif
+
+#if (QS_RTC_HIST_BINS < 2U) || ((QS_RTC_HIST_BINS + QS_RTC_HIST_SHIFT) > 33U)
+#error QS_RTC_HIST_BINS and QS_RTC_HIST_SHIFT do not fit 32-bit times;
+#endif
+
+#endif // QS_RTC_HIST
+
+#ifdef QF_EPOOL_TRACK
+
+#ifndef QS_EPOOL_TRACK_CMD
+// QS-RX command id reserved for the outstanding-event (leak) report
+#define QS_EPOOL_TRACK_CMD 0xF1U
+#endif
+
+#ifndef QS_EPOOL_TRACK_REC
+// QS application-specific record used for the outstanding-event reports
+#define QS_EPOOL_TRACK_REC ((enum_t)QS_USER + 23)
+#endif
+
+#endif // QF_EPOOL_TRACK
+
 //! @endcond
 //============================================================================
 
@@ -813,6 +860,35 @@ void QS_onCommand(
     uint32_t param3);
 //$enddecl${QS::QS-RX} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
+//$declare${QS::QS-RTC} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+#ifdef QS_RTC_HIST
+
+//${QS::QS-RTC::rtcHistUpdate_} ..............................................
+//! @static @private @memberof QS
+//!
+//! @details
+//! Called by the kernel at the end of every RTC step of the active object
+//! `a`, which has processed the signal `sig`. Adds the execution time of
+//! the RTC step and the time the event has waited in the queue to the
+//! log2 histograms of the (`a`, `sig`) pair.
+void QS_rtcHistUpdate_(
+    QActive const * const a,
+    enum_t const sig);
+
+//${QS::QS-RTC::rtcHistReport_} ..............................................
+//! @static @private @memberof QS
+//!
+//! @details
+//! Reports the histograms of the active object of priority `prio` (all
+//! active objects for `prio` == 0) as #QS_RTC_HIST_REC records and
+//! optionally resets them. Invoked by the QS-RX command #QS_RTC_HIST_CMD.
+void QS_rtcHistReport_(
+    uint_fast8_t const prio,
+    bool const reset);
+
+#endif // def QS_RTC_HIST
+//$enddecl${QS::QS-RTC} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+
 //============================================================================
 #ifdef Q_UTEST
 
@@ -68,6 +68,12 @@ typedef struct {
     //! @memberof QV_Attr
     QPSet readySet_dis;
 #endif // ndef Q_UNSAFE
+
+#ifdef QF_EPOOL_MAG
+    //! @memberof QV_Attr
+    //! prio. of the AO in the RTC step (0 outside of the RTC steps)
+    uint8_t volatile actPrio;
+#endif // def QF_EPOOL_MAG
 } QV_Attr;
 
 //${QV::QV-base::priv_} ......................................................
@@ -110,6 +116,15 @@ void QV_onIdle(void);
 #define QACTIVE_EQUEUE_SIGNAL_(me_) \
     QPSet_insert(&QV_priv_.readySet, (uint_fast8_t)(me_)->prio)
 #endif // def Q_UNSAFE
+
+#if (defined QF_EPOOL_MAG) && (defined QV_ISR_CONTEXT_)
+//${QV-impl::QF_MAG_ACT_} ....................................................
+// the AO in the current RTC step (none in ISRs and in the idle loop),
+// the port must be able to tell the ISR context (QV_ISR_CONTEXT_())
+#define QF_MAG_ACT_() \
+    ((QV_ISR_CONTEXT_() || (QV_priv_.actPrio == 0U)) \
+     ? (QActive *)0 : QActive_registry_[QV_priv_.actPrio])
+#endif // QF_EPOOL_MAG && QV_ISR_CONTEXT_
 //$enddecl${QV-impl} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
 //$declare${QF_EPOOL-impl} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
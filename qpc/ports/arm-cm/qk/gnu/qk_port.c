@@ -0,0 +1,279 @@
+//============================================================================
+// QP/C Real-Time Embedded Framework (RTEF)
+//
+//                   Q u a n t u m  L e a P s
+//                   ------------------------
+//                   Modern Embedded Software
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open source GNU
+// General Public License version 3 (or any later version), or alternatively,
+// under the terms of one of the closed source Quantum Leaps commercial
+// licenses.
+//
+// The terms of the open source GNU General Public License version 3
+// can be found at: <www.gnu.org/licenses/gpl-3.0>
+//
+// The terms of the closed source Quantum Leaps commercial licenses
+// can be found at: <www.state-machine.com/licensing>
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// Contact information:
+// <www.state-machine.com>
+// <info@state-machine.com>
+//============================================================================
+//! @date Last updated on: 2023-09-07
+//! @version Last updated for: @ref qpc_7_3_0
+//!
+//! @file
+//! @brief QK/C port to ARM Cortex-M, GNU-ARM
+
+#define QP_IMPL 1U
+#include "qp_port.h"
+
+#define SCB_SYSPRI   ((uint32_t volatile *)0xE000ED18U)
+#define NVIC_IP      ((uint32_t volatile *)0xE000E400U)
+#define SCB_CPACR   *((uint32_t volatile *)0xE000ED88U)
+#define FPU_FPCCR   *((uint32_t volatile *)0xE000EF34U)
+
+// helper macros to "stringify" values
+#define VAL(x) #x
+#define STRINGIFY(x) VAL(x)
+
+//............................................................................
+// Initialize the exception priorities and IRQ priorities to safe values.
+//
+// Description:
+// On ARMv7-M or higher, this QK port disables interrupts by means of the
+// BASEPRI register. However, this method cannot disable interrupt
+// priority zero, which is the default for all interrupts out of reset.
+// The following code changes the SysTick priority and all IRQ priorities
+// to the safe value QF_BASEPRI, which the QF critical section can disable.
+// This avoids breaching of the QF critical sections in case the
+// application programmer forgets to explicitly set priorities of all
+// "kernel aware" interrupts.
+//
+// The PendSV exception, which performs the QK asynchronous preemption,
+// is set to the lowest priority (0xFF), so that it runs only after all
+// nested interrupts have completed. See NOTE1.
+//
+// The interrupt priorities established in QK_init() can be later
+// changed by the application-level code.
+void QK_init(void) {
+
+#if (__ARM_ARCH != 6)   //--------- if ARMv7-M and higher...
+
+    // SCB_SYSPRI[2]:  SysTick
+    SCB_SYSPRI[2] = (SCB_SYSPRI[2] | (QF_BASEPRI << 24U));
+
+    // set all 240 possible IRQ priories to QF_BASEPRI...
+    for (uint_fast8_t n = 0U; n < (240U/sizeof(uint32_t)); ++n) {
+        NVIC_IP[n] = (QF_BASEPRI << 24U) | (QF_BASEPRI << 16U)
+                     | (QF_BASEPRI << 8U) | QF_BASEPRI;
+    }
+
+#endif                  //--------- ARMv7-M or higher
+
+    // SCB_SYSPRI3: PendSV set to the lowest priority 0xFF
+    SCB_SYSPRI[3] = (SCB_SYSPRI[3] | (0xFFU << 16U));
+
+#ifdef __ARM_FP         //--------- if VFP available...
+    // make sure that the FPU is enabled by seting CP10 & CP11 Full Access
+    SCB_CPACR = (SCB_CPACR | ((3UL << 20U) | (3UL << 22U)));
+
+    // FPU automatic state preservation (ASPEN) lazy stacking (LSPEN)
+    FPU_FPCCR = (FPU_FPCCR | (1U << 30U) | (1U << 31U));
+#endif                  //--------- VFP available
+}
+
+//============================================================================
+// The PendSV_Handler exception is used for handling the asynchronous
+// preemption in QK. The use of the PendSV exception is the recommended and
+// most efficient method for performing context switches with ARM Cortex-M.
+//
+// The PendSV exception should have the lowest priority in the whole system
+// (0xFF, see QK_init). All other exceptions and interrupts should have higher
+// priority. For example, for NVIC with 2 priority bits all interrupts and
+// exceptions must have numerical value of priority lower than 0xC0. In this
+// case the interrupt priority levels available to your applications are (in
+// the order from the lowest urgency to the highest urgency): 0x80, 0x40, 0x00.
+//
+// Also, *all* "kernel aware" ISRs in the QK application must call the
+// QK_ISR_EXIT() macro, which triggers PendSV when it detects a need for
+// a context switch or asynchronous preemption.
+//
+// Due to tail-chaining and its lowest priority, the PendSV exception will be
+// entered immediately after the exit from the *last* nested interrupt (or
+// exception). In QK, this is exactly the time when the QK activator needs to
+// handle the asynchronous preemption.
+//
+// NOTE:
+// The inline GNU assembler does not accept mnemonics MOVS, LSRS and ADDS,
+// but for ARMv6-M the mnemonics MOV, LSR and ADD always set the condition
+// flags in the PSR.
+__attribute__ ((naked, optimize("-fno-stack-protector")))
+void PendSV_Handler(void) {
+__asm volatile (
+
+    //<<<<<<<<<<<<<<<<<<<<<<< CRITICAL SECTION BEGIN <<<<<<<<<<<<<<<<<<<<<<<<
+#if (__ARM_ARCH == 6)   // if ARMv6-M...
+    "  CPSID   i                \n" // disable interrupts (set PRIMASK)
+#else                   // ARMv7-M or higher
+    "  PUSH    {r0,lr}          \n" // save stack-aligner + EXC_RETURN
+    "  MOV     r0,#" STRINGIFY(QF_BASEPRI) "\n"
+    "  CPSID   i                \n" // disable interrutps with PRIMASK
+    "  MSR     BASEPRI,r0       \n" // apply the Cortex-M7 erratum
+    "  CPSIE   i                \n" // 837070, see SDEN-1068427.
+#endif                  // ARMv7-M or higher
+
+#ifdef QF_MEM_ISOLATE
+    "  BL      QF_onMemSys      \n"
+#endif
+
+    // The PendSV exception handler can be preempted by an interrupt,
+    // which might pend PendSV exception again. The following write to
+    // ICSR[27] un-pends any such spurious instance of PendSV.
+    "  LDR     r2,=0xE000ED04   \n" // Interrupt Control and State Register
+    "  MOV     r1,#1            \n"
+    "  LSL     r1,r1,#27        \n" // r1 := (1 << 27) (UNPENDSVSET bit)
+    "  STR     r1,[r2]          \n" // ICSR[27] := 1 (un-pend PendSV)
+
+    // The QK activator must be called in a Thread mode, while this code
+    // executes in the Handler mode of the PendSV exception. The switch
+    // to the Thread mode is accomplished by returning from PendSV using
+    // a fabricated exception stack frame, where the return address is
+    // QK_activate_().
+    //
+    // NOTE: the QK activator is called with interrupts DISABLED and also
+    // returns with interrupts DISABLED.
+    "  MOV     r3,#1            \n"
+    "  LSL     r3,r3,#24        \n" // r3 := (1 << 24), set T bit  (new xpsr)
+    "  LDR     r2,=QK_activate_ \n" // address of QK_activate_
+    "  SUB     r2,r2,#1         \n" // align Thumb-address at halfword (new pc)
+    "  LDR     r1,=QK_thread_ret \n" // return address after the call (new lr)
+
+    "  SUB     sp,sp,#(8*4)     \n" // reserve space for exception stack frame
+    "  ADD     r0,sp,#(5*4)     \n" // r0 := 5 registers below the top of stack
+    "  STM     r0!,{r1-r3}      \n" // save xpsr,pc,lr
+
+    "  MOV     r0,#6            \n"
+    "  MVN     r0,r0            \n" // r0 := ~6 == 0xFFFFFFF9
+#if (__ARM_ARCH != 6)   // ARMv7-M or higher
+    "  DSB                      \n" // ARM Erratum 838869
+#endif                  // ARMv7-M or higher
+    "  BX      r0               \n" // exception-return to the QK activator
+    );
+}
+
+//============================================================================
+// QK_thread_ret is a helper function executed when the QK activator returns.
+//
+// NOTE: QK_thread_ret does not execute in the PendSV context!
+// NOTE: QK_thread_ret is entered with interrupts DISABLED.
+__attribute__ ((naked, used, optimize("-fno-stack-protector")))
+void QK_thread_ret(void) {
+__asm volatile (
+
+#ifdef __ARM_FP         //--------- if VFP available...
+    // make sure that the following NMI does not use the FPU stack frame
+    "  MRS     r0,CONTROL       \n" // r0 := CONTROL
+    "  BIC     r0,r0,#4         \n" // r0 := r0 & ~4 (FPCA bit)
+    "  MSR     CONTROL,r0       \n" // CONTROL := r0 (clear CONTROL[2] FPCA bit)
+    "  ISB                      \n" // ISB after MSR CONTROL (ARM AN321,Sect.4.16)
+#endif                  //--------- VFP available
+
+    // trigger NMI to return to preempted task...
+    // NOTE: The NMI exception is triggered with interrupts DISABLED,
+    // because QK activator disables interrutps before return.
+    "  LDR     r0,=0xE000ED04   \n" // Interrupt Control and State Register
+    "  MOV     r1,#1            \n"
+    "  LSL     r1,r1,#31        \n" // r1 := (1 << 31) (NMI bit)
+    "  STR     r1,[r0]          \n" // ICSR[31] := 1 (pend NMI)
+    "  B       .                \n" // wait for preemption by NMI
+    );
+}
+
+//============================================================================
+// The NMI_Handler exception handler is used for returning back to the
+// interrupted task. The NMI exception simply removes its own interrupt
+// stack frame from the stack and returns to the preempted task using the
+// interrupt stack frame that must be at the top of the stack.
+//
+// NOTE: The NMI exception is entered with interrupts DISABLED, so it needs
+// to re-enable interrupts before it returns to the preempted task.
+__attribute__ ((naked, optimize("-fno-stack-protector")))
+void NMI_Handler(void) {
+__asm volatile (
+
+    "  ADD     sp,sp,#(8*4)     \n" // remove one 8-register exception frame
+
+#if (__ARM_ARCH == 6)   // if ARMv6-M...
+    "  CPSIE   i                \n" // enable interrupts (clear PRIMASK)
+    "  BX      lr               \n" // return to the preempted task
+#else                   // ARMv7-M or higher
+    "  MOV     r0,#0            \n"
+    "  MSR     BASEPRI,r0       \n" // enable interrupts (clear BASEPRI)
+    "  POP     {r0,lr}          \n" // pop stack aligner and EXC_RETURN
+    "  DSB                      \n" // ARM Erratum 838869
+    "  BX      lr               \n" // return to the preempted task
+#endif                  // ARMv7-M or higher
+    );
+}
+
+//============================================================================
+#if (__ARM_ARCH == 6) // if ARMv6-M...
+
+// hand-optimized quick LOG2 in assembly (no CLZ instruction in ARMv6-M)
+// NOTE:
+// The inline GNU assembler does not accept mnemonics MOVS, LSRS and ADDS,
+// but for ARMv6-M the mnemonics MOV, LSR and ADD always set the condition
+// flags in the PSR.
+__attribute__ ((naked, optimize("-fno-stack-protector")))
+uint_fast8_t QF_qlog2(uint32_t x) {
+__asm volatile (
+    "  MOV     r1,#0            \n"
+#if (QF_MAX_ACTIVE > 16U)
+    "  LSR     r2,r0,#16        \n"
+    "  BEQ     QF_qlog2_1       \n"
+    "  MOV     r1,#16           \n"
+    "  MOV     r0,r2            \n"
+    "QF_qlog2_1:                \n"
+#endif
+#if (QF_MAX_ACTIVE > 8U)
+    "  LSR     r2,r0,#8         \n"
+    "  BEQ     QF_qlog2_2       \n"
+    "  ADD     r1, r1,#8        \n"
+    "  MOV     r0, r2           \n"
+    "QF_qlog2_2:                \n"
+#endif
+    "  LSR     r2,r0,#4         \n"
+    "  BEQ     QF_qlog2_3       \n"
+    "  ADD     r1,r1,#4         \n"
+    "  MOV     r0,r2            \n"
+    "QF_qlog2_3:                \n"
+    "  LDR     r2,=QF_qlog2_LUT \n"
+    "  LDRB    r0,[r2,r0]       \n"
+    "  ADD     r0,r1,r0         \n"
+    "  BX      lr               \n"
+    "  .align                   \n"
+    "QF_qlog2_LUT:              \n"
+    "  .byte 0, 1, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4"
+    );
+}
+
+#endif // ARMv6-M
+
+
+//============================================================================
+// NOTE1:
+// The QK activator (QK_activate_()) runs in the Thread mode, so it can be
+// preempted by interrupts, which in turn can pend PendSV again. Returning
+// to the preempted thread is accomplished by pending the NMI exception
+// from QK_thread_ret(), which unconditionally preempts the Thread mode even
+// with interrupts disabled, discards its own exception frame and returns
+// through the original PendSV exception frame.
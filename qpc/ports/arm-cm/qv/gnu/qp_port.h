@@ -134,6 +134,15 @@
 #endif // def QF_MEM_ISOLATE
 
 // determination if the code executes in the ISR context
+#define QV_ISR_CONTEXT_() (QV_get_IPSR() != 0U)
+
+__attribute__((always_inline))
+static inline uint32_t QV_get_IPSR(void) {
+    uint32_t regIPSR;
+    __asm volatile ("mrs %0,ipsr" : "=r" (regIPSR));
+    return regIPSR;
+}
+
 #if (__ARM_ARCH == 6) // ARMv6-M?
 
     // macro to put the CPU to sleep inside QV_onIdle()
@@ -0,0 +1,234 @@
+//============================================================================
+// QP/C Real-Time Embedded Framework (RTEF)
+//
+//                   Q u a n t u m  L e a P s
+//                   ------------------------
+//                   Modern Embedded Software
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open source GNU
+// General Public License version 3 (or any later version), or alternatively,
+// under the terms of one of the closed source Quantum Leaps commercial
+// licenses.
+//
+// The terms of the open source GNU General Public License version 3
+// can be found at: <www.gnu.org/licenses/gpl-3.0>
+//
+// The terms of the closed source Quantum Leaps commercial licenses
+// can be found at: <www.state-machine.com/licensing>
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// Contact information:
+// <www.state-machine.com>
+// <info@state-machine.com>
+//============================================================================
+//! @date Last updated on: 2026-10-17
+//! @version Last updated for: @ref qpc_7_3_0
+//!
+//! @file
+//! @brief QF/C port to POSIX (Linux), one P-thread per active object
+
+// expose timerfd and the recursive mutex initializer
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#define QP_IMPL           // this is QP implementation
+#include "qp_port.h"      // QP port
+#include "qp_pkg.h"       // QP package-scope interface
+#include "qsafe.h"        // QP Functional Safety (FuSa) Subsystem
+#ifdef Q_SPY              // QS software tracing enabled?
+    #include "qs_port.h"  // QS port
+    #include "qs_pkg.h"   // QS package-scope internal interface
+#else
+    #include "qs_dummy.h" // disable the QS software tracing
+#endif // Q_SPY
+
+#include <sched.h>        // POSIX scheduling policies
+#include <stdint.h>
+#include <unistd.h>       // read(), close()
+#include <sys/timerfd.h>  // Linux timerfd API
+
+Q_DEFINE_THIS_MODULE("qf_port")
+
+// the QF critical section, see NOTE2 in qp_port.h
+pthread_mutex_t QF_critSectMutex_ = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+static uint32_t l_tickPerSec = 100U; // default clock tick rate [Hz]
+static int      l_tickPrio   = 0;    // default ticker thread priority
+
+static bool volatile l_isRunning;    // flag indicating when QF is running
+static pthread_cond_t l_stopCond = PTHREAD_COND_INITIALIZER;
+
+#ifdef QF_EPOOL_MAG
+// the AO of the calling AO thread, see NOTE5 in qp_port.h
+__thread QActive *QF_magAct_;
+#endif
+
+//............................................................................
+void QF_enterCriticalSection_(void) {
+    (void)pthread_mutex_lock(&QF_critSectMutex_);
+}
+//............................................................................
+void QF_leaveCriticalSection_(void) {
+    (void)pthread_mutex_unlock(&QF_critSectMutex_);
+}
+
+//............................................................................
+void QF_setTickRate(uint32_t ticksPerSec, int tickPrio) {
+    l_tickPerSec = ticksPerSec;
+    l_tickPrio   = tickPrio;
+}
+
+//............................................................................
+static void *ao_thread(void *arg) { // the expected P-Thread signature
+    QActive * const act = (QActive *)arg;
+
+    #ifdef QF_EPOOL_MAG
+    QF_magAct_ = act; // this thread may use the magazines of act
+    #endif
+
+    // event loop of the AO thread...
+    for (;;) { // for-ever
+        QEvt const * const e = QActive_get_(act); // wait for event
+        (*act->super.vptr->dispatch)(&act->super, e, act->prio);
+    #if (QF_MAX_EPOOL > 0U)
+        QF_gc(e); // check if the event is garbage, and collect it if so
+    #endif
+    }
+    return (void *)0; // return success
+}
+
+//............................................................................
+void QF_init(void) {
+    QF_bzero_(&QF_priv_,                 sizeof(QF_priv_));
+    QF_bzero_(&QTimeEvt_timeEvtHead_[0], sizeof(QTimeEvt_timeEvtHead_));
+    #ifdef QF_TIMEEVT_WHEEL
+    QF_bzero_(&QTimeEvt_wheel_[0],       sizeof(QTimeEvt_wheel_));
+    #endif
+    #ifdef QF_TIMEEVT_ABS
+    QF_bzero_(&QTimeEvt_tickCtr_[0],     sizeof(QTimeEvt_tickCtr_));
+    #endif
+    QF_bzero_(&QActive_registry_[0],     sizeof(QActive_registry_));
+}
+
+//............................................................................
+void QF_stop(void) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    l_isRunning = false; // terminate the ticker loop in QF_run()
+    (void)pthread_cond_signal(&l_stopCond);
+    QF_CRIT_EXIT();
+}
+
+//............................................................................
+// Runs the ticker loop in the calling (main) thread, see NOTE3 in qp_port.h
+int_t QF_run(void) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    l_isRunning = true;
+    #ifdef Q_SPY
+    // produce the QS_QF_RUN trace record
+    QS_beginRec_((uint_fast8_t)QS_QF_RUN);
+    QS_endRec_();
+    #endif // Q_SPY
+    QF_CRIT_EXIT();
+
+    QF_onStartup(); // application-specific startup callback
+
+    if (l_tickPerSec != 0U) { // clock tick enabled?
+        if (l_tickPrio > 0) { // real-time priority requested?
+            struct sched_param param;
+            param.sched_priority = l_tickPrio;
+            // NOTE: silently ignored without sufficient privileges (EPERM)
+            (void)pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        }
+
+        int const fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        QF_CRIT_ENTRY();
+        Q_ASSERT_INCRIT(100, fd >= 0);
+        QF_CRIT_EXIT();
+
+        struct itimerspec tspec;
+        tspec.it_interval.tv_sec  = (time_t)(1U / l_tickPerSec);
+        tspec.it_interval.tv_nsec = (long)((1000000000UL / l_tickPerSec)
+                                           % 1000000000UL);
+        tspec.it_value = tspec.it_interval;
+        int const err = timerfd_settime(fd, 0, &tspec,
+                                        (struct itimerspec *)0);
+        QF_CRIT_ENTRY();
+        Q_ASSERT_INCRIT(110, err == 0);
+        QF_CRIT_EXIT();
+
+        while (l_isRunning) {
+            uint64_t nExp;
+            if (read(fd, &nExp, sizeof(nExp)) != (ssize_t)sizeof(nExp)) {
+                break; // the timerfd failed
+            }
+            // catch up with all expirations (e.g., after thread preemption)
+            for (; (nExp != 0U) && l_isRunning; --nExp) {
+                QF_onClockTick(); // call the application clock-tick callback
+            }
+    #ifdef Q_SPY
+            QS_output(); // transmit the trace produced since the last tick
+    #endif
+        }
+        (void)close(fd);
+    }
+    else { // no clock tick, just wait for QF_stop()
+        QF_CRIT_ENTRY();
+        while (l_isRunning) {
+            (void)pthread_cond_wait(&l_stopCond, &QF_critSectMutex_);
+        }
+        QF_CRIT_EXIT();
+    }
+
+    QF_onCleanup(); // application-specific cleanup callback
+    QS_EXIT();      // cleanup the QSPY connection
+
+    return 0; // return success
+}
+
+//............................................................................
+void QActive_start_(QActive * const me,
+    QPrioSpec const prioSpec,
+    QEvt const * * const qSto,
+    uint_fast16_t const qLen,
+    void * const stkSto,
+    uint_fast16_t const stkSize,
+    void const * const par)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    // P-threads allocate their own stack, so stkSto must NOT be provided
+    Q_REQUIRE_INCRIT(200, stkSto == (void *)0);
+    QF_CRIT_EXIT();
+
+    me->prio  = (uint8_t)(prioSpec & 0xFFU); // QF-prio. of the AO
+    me->pthre = 0U; // preemption-threshold (not used in this port)
+    QActive_register_(me); // make QF aware of this active object
+
+    QEQueue_init(&me->eQueue, qSto, qLen); // init the built-in queue
+    (void)pthread_cond_init(&me->osObject, (pthread_condattr_t *)0);
+
+    // top-most initial tran. (virtual call) in the caller's thread
+    (*me->super.vptr->init)(&me->super, par, me->prio);
+    QS_FLUSH(); // flush the trace buffer to the host
+
+    pthread_attr_t attr;
+    (void)pthread_attr_init(&attr);
+    if (stkSize != 0U) { // stack size requested?
+        (void)pthread_attr_setstacksize(&attr, (size_t)stkSize);
+    }
+    int const err = pthread_create(&me->thread, &attr, &ao_thread, me);
+    (void)pthread_attr_destroy(&attr);
+
+    QF_CRIT_ENTRY();
+    Q_ASSERT_INCRIT(210, err == 0);
+    QF_CRIT_EXIT();
+}
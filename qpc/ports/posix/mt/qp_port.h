@@ -0,0 +1,162 @@
+//============================================================================
+// QP/C Real-Time Embedded Framework (RTEF)
+//
+//                   Q u a n t u m  L e a P s
+//                   ------------------------
+//                   Modern Embedded Software
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open source GNU
+// General Public License version 3 (or any later version), or alternatively,
+// under the terms of one of the closed source Quantum Leaps commercial
+// licenses.
+//
+// The terms of the open source GNU General Public License version 3
+// can be found at: <www.gnu.org/licenses/gpl-3.0>
+//
+// The terms of the closed source Quantum Leaps commercial licenses
+// can be found at: <www.state-machine.com/licensing>
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// Contact information:
+// <www.state-machine.com>
+// <info@state-machine.com>
+//============================================================================
+//! @date Last updated on: 2026-10-17
+//! @version Last updated for: @ref qpc_7_3_0
+//!
+//! @file
+//! @brief QP/C port to POSIX (Linux), one P-thread per active object
+
+#ifndef QP_PORT_H_
+#define QP_PORT_H_
+
+#include <stdint.h>  // Exact-width types. WG14/N843 C99 Standard
+#include <stdbool.h> // Boolean type.      WG14/N843 C99 Standard
+#include <pthread.h> // POSIX-thread API
+
+#ifdef QP_CONFIG
+#include "qp_config.h" // external QP configuration
+#endif
+
+#ifdef QACTIVE_ISR_RING
+// the AO threads of this port never drain the ISR rings (QActive_drainIsrRings_())
+#error QACTIVE_ISR_RING requires the QV kernel;
+#endif
+
+// no-return function specifier (C11 Standard)
+#define Q_NORETURN   _Noreturn void
+
+// QActive event queue and thread types, see NOTE1
+#define QACTIVE_EQUEUE_TYPE     QEQueue
+#define QACTIVE_OS_OBJ_TYPE     pthread_cond_t
+#define QACTIVE_THREAD_TYPE     pthread_t
+
+// QF "interrupt" disable/enable, see NOTE2
+#define QF_INT_DISABLE()        QF_enterCriticalSection_()
+#define QF_INT_ENABLE()         QF_leaveCriticalSection_()
+
+// QF critical section (recursive mutex), see NOTE2
+#define QF_CRIT_STAT
+#define QF_CRIT_ENTRY()         QF_enterCriticalSection_()
+#define QF_CRIT_EXIT()          QF_leaveCriticalSection_()
+
+// the GNU-C compiler provides the CLZ builtin for fast LOG2
+#define QF_LOG2(n_) ((uint_fast8_t)(32 - __builtin_clz((unsigned)(n_))))
+
+// internal functions for the critical section
+void QF_enterCriticalSection_(void);
+void QF_leaveCriticalSection_(void);
+
+// set the clock tick rate and the priority of the ticker thread, see NOTE3
+void QF_setTickRate(uint32_t ticksPerSec, int tickPrio);
+
+// clock tick callback (provided by the application), see NOTE3
+void QF_onClockTick(void);
+
+// include files -------------------------------------------------------------
+#include "qequeue.h"   // POSIX port uses the native QP event queue
+#include "qmpool.h"    // POSIX port uses the native QP memory pool
+#include "qp.h"        // QP framework
+
+//============================================================================
+// interface used only inside QF implementation, but not in applications
+
+#ifdef QP_IMPL
+
+// the mutex of the QF critical section
+extern pthread_mutex_t QF_critSectMutex_;
+
+// scheduler locking, see NOTE4
+#define QF_SCHED_STAT_
+#define QF_SCHED_LOCK_(dummy) ((void)0)
+#define QF_SCHED_UNLOCK_()    ((void)0)
+
+// native event queue operations, see NOTE1
+#define QACTIVE_EQUEUE_WAIT_(me_) \
+    while ((me_)->eQueue.frontEvt == (QEvt *)0) { \
+        (void)pthread_cond_wait(&(me_)->osObject, &QF_critSectMutex_); \
+    }
+#define QACTIVE_EQUEUE_SIGNAL_(me_) \
+    (void)pthread_cond_signal(&(me_)->osObject)
+
+// native QF event pool operations
+#define QF_EPOOL_TYPE_   QMPool
+#define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
+    (QMPool_init(&(p_), (poolSto_), (poolSize_), (evtSize_)))
+#define QF_EPOOL_EVENT_SIZE_(p_)  ((uint_fast16_t)(p_).blockSize)
+#define QF_EPOOL_GET_(p_, e_, m_, qs_id_) \
+    ((e_) = (QEvt *)QMPool_get(&(p_), (m_), (qs_id_)))
+#define QF_EPOOL_PUT_(p_, e_, qs_id_) \
+    (QMPool_put(&(p_), (e_), (qs_id_)))
+
+#ifdef QF_EPOOL_MAG
+// the AO of the calling AO thread, see NOTE5
+extern __thread QActive *QF_magAct_;
+#define QF_MAG_ACT_() (QF_magAct_)
+#endif // def QF_EPOOL_MAG
+
+#endif // QP_IMPL
+
+//============================================================================
+// NOTE1:
+// Every active object started with QActive_start_() gets its own P-thread,
+// which blocks on the condition variable of the AO (QActive.osObject) while
+// the AO's event queue is empty. QACTIVE_EQUEUE_SIGNAL_() is invoked only
+// when an event is posted to an empty queue, so a busy AO does not incur
+// the cost of signaling the condition variable for every event.
+//
+// NOTE2:
+// The QF "interrupts" and the QF critical section are both implemented
+// with a single, recursive POSIX mutex, which is shared by all AO threads
+// and protects the event queues, event pools and time events. The mutex is
+// recursive, because some QS trace records (e.g., the function dictionary
+// of QHsm_top in QHsm_init_()) are produced inside the critical section.
+// The RTC steps of different AOs run outside of the critical section and
+// therefore in parallel on all available CPU cores.
+//
+// NOTE3:
+// QF_run() turns the main thread into the ticker thread, which reads a
+// Linux timerfd and calls QF_onClockTick() once per timer expiration, until
+// QF_stop() is called. Calling QF_setTickRate() with zero ticksPerSec
+// disables the clock tick, in which case QF_run() just waits for QF_stop().
+//
+// NOTE4:
+// The AO threads are scheduled by the OS. The AO priorities only identify
+// the AOs in QP/C and do not map to the priorities of the P-threads.
+// Consequently, locking of the scheduler during publish-subscribe event
+// delivery is not needed.
+//
+// NOTE5:
+// With QF_EPOOL_MAG, every AO thread sets QF_magAct_ to its AO, so Q_NEW()
+// and QF_gc() in the AO thread use the magazines of the AO without the
+// critical section. Other threads (e.g., the ticker) have no AO and use
+// the event pools directly.
+//
+
+#endif // QP_PORT_H_
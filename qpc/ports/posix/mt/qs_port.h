@@ -0,0 +1,66 @@
+//============================================================================
+// QP/C Real-Time Embedded Framework (RTEF)
+//
+//                   Q u a n t u m  L e a P s
+//                   ------------------------
+//                   Modern Embedded Software
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open source GNU
+// General Public License version 3 (or any later version), or alternatively,
+// under the terms of one of the closed source Quantum Leaps commercial
+// licenses.
+//
+// The terms of the open source GNU General Public License version 3
+// can be found at: <www.gnu.org/licenses/gpl-3.0>
+//
+// The terms of the closed source Quantum Leaps commercial licenses
+// can be found at: <www.state-machine.com/licensing>
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// Contact information:
+// <www.state-machine.com>
+// <info@state-machine.com>
+//============================================================================
+//! @date Last updated on: 2026-10-17
+//! @version Last updated for: @ref qpc_7_3_0
+//!
+//! @file
+//! @brief QS/C port to POSIX (Linux), one P-thread per AO, 64-bit host
+
+#ifndef QS_PORT_H_
+#define QS_PORT_H_
+
+// QS time-stamp size in bytes
+#define QS_TIME_SIZE     4U
+
+// QS buffer counter size in bytes (allows trace buffers above 64KB)
+#define QS_CTR_SIZE      4U
+
+// object pointer size in bytes
+#define QS_OBJ_PTR_SIZE  8U
+
+// function pointer size in bytes
+#define QS_FUN_PTR_SIZE  8U
+
+//============================================================================
+// NOTE: QS might be used with or without other QP components, in which
+// case the separate definitions of the macros QF_CRIT_STAT, QF_CRIT_ENTRY(),
+// and QF_CRIT_EXIT() are needed. In this port QS is configured to be used
+// with the other QP component, by simply including "qp_port.h"
+//*before* "qs.h".
+#ifndef QP_PORT_H_
+#include "qp_port.h" // use QS with QF
+#endif
+
+#include "qs.h"      // QS platform-independent public interface
+
+// write all the QS trace data accumulated so far to the output stream
+void QS_output(void);
+
+#endif // QS_PORT_H_
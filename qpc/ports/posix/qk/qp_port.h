@@ -0,0 +1,113 @@
+//============================================================================
+// QP/C Real-Time Embedded Framework (RTEF)
+//
+//                   Q u a n t u m  L e a P s
+//                   ------------------------
+//                   Modern Embedded Software
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open source GNU
+// General Public License version 3 (or any later version), or alternatively,
+// under the terms of one of the closed source Quantum Leaps commercial
+// licenses.
+//
+// The terms of the open source GNU General Public License version 3
+// can be found at: <www.gnu.org/licenses/gpl-3.0>
+//
+// The terms of the closed source Quantum Leaps commercial licenses
+// can be found at: <www.state-machine.com/licensing>
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// Contact information:
+// <www.state-machine.com>
+// <info@state-machine.com>
+//============================================================================
+//! @date Last updated on: 2026-10-17
+//! @version Last updated for: @ref qpc_7_3_0
+//!
+//! @file
+//! @brief QP/C port to POSIX (Linux), simulated preemptive QK kernel, GNU-C
+
+#ifndef QP_PORT_H_
+#define QP_PORT_H_
+
+#include <stdint.h>  // Exact-width types. WG14/N843 C99 Standard
+#include <stdbool.h> // Boolean type.      WG14/N843 C99 Standard
+
+#ifdef QP_CONFIG
+#include "qp_config.h" // external QP configuration
+#endif
+
+// no-return function specifier (C11 Standard)
+#define Q_NORETURN   _Noreturn void
+
+// QF configuration for QK -- data members of the QActive class...
+
+// QK event-queue used for AOs
+#define QACTIVE_EQUEUE_TYPE     QEQueue
+
+// QF "interrupt" disable/enable (simulated with a nesting counter), NOTE1
+#define QF_INT_DISABLE()        (++QF_intLock_)
+#define QF_INT_ENABLE()         (--QF_intLock_)
+
+// QF critical section, see NOTE1
+#define QF_CRIT_STAT
+#define QF_CRIT_ENTRY()         QF_INT_DISABLE()
+#define QF_CRIT_EXIT()          QF_INT_ENABLE()
+
+// the GNU-C compiler provides the CLZ builtin for fast LOG2
+#define QF_LOG2(n_) ((uint_fast8_t)(32 - __builtin_clz((unsigned)(n_))))
+
+// simulated interrupt lock nesting counter
+extern uint_fast8_t volatile QF_intLock_;
+
+// determination if the code executes in the (simulated) ISR context
+#define QK_ISR_CONTEXT_() (QK_priv_.intNest != 0U)
+
+// QK (simulated) ISR entry and exit, see NOTE2
+#define QK_ISR_ENTRY() do { \
+    QF_INT_DISABLE();       \
+    ++QK_priv_.intNest;     \
+    QF_INT_ENABLE();        \
+} while (false)
+
+#define QK_ISR_EXIT() do {  \
+    QF_INT_DISABLE();       \
+    --QK_priv_.intNest;     \
+    if (QK_priv_.intNest == 0U) { \
+        if (QK_sched_() != 0U) {  \
+            QK_activate_();       \
+        }                   \
+    }                       \
+    QF_INT_ENABLE();        \
+} while (false)
+
+// include files -------------------------------------------------------------
+#include "qequeue.h"   // QK kernel uses the native QP event queue
+#include "qmpool.h"    // QK kernel uses the native QP memory pool
+#include "qp.h"        // QP framework
+#include "qk.h"        // QK kernel
+
+//============================================================================
+// NOTE1:
+// This port simulates the QK kernel in a single thread of a host process,
+// so that the preemption scenarios of an application can be reproduced
+// deterministically on Linux (e.g., under the QUTest harness). No other
+// threads may call QP services. The "interrupts" are application functions
+// bracketed with QK_ISR_ENTRY()/QK_ISR_EXIT() and invoked synchronously,
+// typically from inside a long RTC step to model an IRQ arriving at that
+// point. The interrupt lock is then only a nesting counter.
+//
+// NOTE2:
+// On the target, QK_ISR_EXIT() pends PendSV, which activates the ready
+// higher-priority AOs after the last nested ISR returns. The simulation
+// calls the QK activator directly at the exit from the outermost
+// simulated ISR, which is the same point in the program order.
+//
+
+#endif // QP_PORT_H_
@@ -0,0 +1,148 @@
+//============================================================================
+// QP/C Real-Time Embedded Framework (RTEF)
+//
+//                   Q u a n t u m  L e a P s
+//                   ------------------------
+//                   Modern Embedded Software
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open source GNU
+// General Public License version 3 (or any later version), or alternatively,
+// under the terms of one of the closed source Quantum Leaps commercial
+// licenses.
+//
+// The terms of the open source GNU General Public License version 3
+// can be found at: <www.gnu.org/licenses/gpl-3.0>
+//
+// The terms of the closed source Quantum Leaps commercial licenses
+// can be found at: <www.state-machine.com/licensing>
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// Contact information:
+// <www.state-machine.com>
+// <info@state-machine.com>
+//============================================================================
+//! @date Last updated on: 2026-10-17
+//! @version Last updated for: @ref qpc_7_3_0
+//!
+//! @file
+//! @brief QP/C port to POSIX (Linux), cooperative QV kernel, GNU-C
+
+#ifndef QP_PORT_H_
+#define QP_PORT_H_
+
+#include <stdint.h>  // Exact-width types. WG14/N843 C99 Standard
+#include <stdbool.h> // Boolean type.      WG14/N843 C99 Standard
+
+#ifdef QP_CONFIG
+#include "qp_config.h" // external QP configuration
+#endif
+
+// no-return function specifier (C11 Standard)
+#define Q_NORETURN   _Noreturn void
+
+// QF configuration for QV -- data members of the QActive class...
+
+// QV event-queue used for AOs
+#define QACTIVE_EQUEUE_TYPE     QEQueue
+
+// QF "interrupt" disable/enable, see NOTE1
+#define QF_INT_DISABLE()        QF_enterCriticalSection_()
+#define QF_INT_ENABLE()         QF_leaveCriticalSection_()
+
+// QF critical section (recursive mutex), see NOTE1
+#define QF_CRIT_STAT
+#define QF_CRIT_ENTRY()         QF_enterCriticalSection_()
+#define QF_CRIT_EXIT()          QF_leaveCriticalSection_()
+
+// the GNU-C compiler provides the CLZ builtin for fast LOG2
+#define QF_LOG2(n_) ((uint_fast8_t)(32 - __builtin_clz((unsigned)(n_))))
+
+// internal functions for the critical section
+void QF_enterCriticalSection_(void);
+void QF_leaveCriticalSection_(void);
+
+// set the clock tick rate and the priority of the ticker thread, see NOTE2
+void QF_setTickRate(uint32_t ticksPerSec, int tickPrio);
+
+// clock tick callback (provided by the application), see NOTE2
+void QF_onClockTick(void);
+
+// start the ticker thread (called from QF_run())
+#define QV_START()  QV_start_()
+void QV_start_(void);
+
+// include files -------------------------------------------------------------
+#include "qequeue.h"   // QV kernel uses the native QP event queue
+#include "qmpool.h"    // QV kernel uses the native QP memory pool
+#include "qp.h"        // QP framework
+#include "qv.h"        // QV kernel
+
+//============================================================================
+// interface used only inside QF implementation, but not in applications
+
+#ifdef QP_IMPL
+
+#include <pthread.h>   // POSIX-thread API
+
+// condition variable for waking up the QV event loop, see NOTE3
+extern pthread_cond_t QV_condVar_;
+
+// the ready-set insertion must also wake up the idle QV event loop
+#undef QACTIVE_EQUEUE_SIGNAL_
+#ifndef Q_UNSAFE
+#define QACTIVE_EQUEUE_SIGNAL_(me_) \
+    QPSet_insert(&QV_priv_.readySet, (uint_fast8_t)(me_)->prio); \
+    QPSet_update_(&QV_priv_.readySet, &QV_priv_.readySet_dis); \
+    (void)pthread_cond_signal(&QV_condVar_)
+#else
+#define QACTIVE_EQUEUE_SIGNAL_(me_) \
+    QPSet_insert(&QV_priv_.readySet, (uint_fast8_t)(me_)->prio); \
+    (void)pthread_cond_signal(&QV_condVar_)
+#endif // ndef Q_UNSAFE
+
+#ifdef QACTIVE_ISR_RING
+// wake up the idle QV event loop after posting to an ISR ring, see NOTE4
+#define QACTIVE_ISR_RING_SIGNAL_() QV_isrRingSignal_()
+void QV_isrRingSignal_(void);
+#endif // QACTIVE_ISR_RING
+
+#endif // QP_IMPL
+
+//============================================================================
+// NOTE1:
+// The QF "interrupts" and the QF critical section are both implemented
+// with a single POSIX mutex. The mutex is recursive, because some QS trace
+// records (e.g., the function dictionary of QHsm_top in QHsm_init_()) are
+// produced with the critical section already entered. The "interrupts" in
+// this port are the other threads of the process, such as the ticker thread
+// or any application threads that post events to active objects.
+//
+// NOTE2:
+// The clock tick is driven by a Linux timerfd read by a dedicated ticker
+// thread, which calls QF_onClockTick() for every timer expiration. The
+// application typically calls QF_TICK_X() from QF_onClockTick(). Calling
+// QF_setTickRate() with zero ticksPerSec disables the ticker thread.
+// A tickPrio greater than zero requests the SCHED_FIFO policy, which is
+// silently dropped when the process lacks the privilege.
+//
+// NOTE3:
+// The QV event loop in QF_run() calls QV_onIdle() with the critical
+// section mutex held. This port provides QV_onIdle(), which atomically
+// releases the (non-nested) mutex and blocks on the QV_condVar_ condition
+// variable until an event is posted to any active object.
+//
+// NOTE4:
+// With QACTIVE_ISR_RING, QActive_postFromISR_() publishes the event
+// without the critical section, but the producer thread then briefly takes
+// the mutex to signal QV_condVar_. Otherwise the wake-up could be lost
+// between the check of the ISR rings and the pthread_cond_wait() in
+// QV_onIdle(). On the target, the interrupt itself wakes up the CPU.
+//
+
+#endif // QP_PORT_H_
@@ -0,0 +1,129 @@
+//============================================================================
+// QP/C Real-Time Embedded Framework (RTEF)
+//
+//                   Q u a n t u m  L e a P s
+//                   ------------------------
+//                   Modern Embedded Software
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open source GNU
+// General Public License version 3 (or any later version), or alternatively,
+// under the terms of one of the closed source Quantum Leaps commercial
+// licenses.
+//
+// The terms of the open source GNU General Public License version 3
+// can be found at: <www.gnu.org/licenses/gpl-3.0>
+//
+// The terms of the closed source Quantum Leaps commercial licenses
+// can be found at: <www.state-machine.com/licensing>
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// Contact information:
+// <www.state-machine.com>
+// <info@state-machine.com>
+//============================================================================
+//! @date Last updated on: 2026-10-17
+//! @version Last updated for: @ref qpc_7_3_0
+//!
+//! @file
+//! @brief QS/C port to POSIX (Linux), output to stdout or to a file
+
+#ifndef Q_SPY
+    #error "Q_SPY must be defined to compile qs_port.c"
+#endif // Q_SPY
+
+// expose clock_gettime()
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#define QP_IMPL           // this is QP implementation
+#include "qp_port.h"      // QP port
+#include "qsafe.h"        // QP Functional Safety (FuSa) Subsystem
+#include "qs_port.h"      // QS port
+#include "qs_pkg.h"       // QS package-scope interface
+
+#include <stdio.h>        // fopen(), fwrite(), fflush()
+#include <time.h>         // clock_gettime()
+
+#ifndef QS_TX_SIZE
+#define QS_TX_SIZE     (64U*1024U)
+#endif
+#ifndef QS_RX_SIZE
+#define QS_RX_SIZE     256U
+#endif
+#define QS_TX_CHUNK    4096U
+
+static FILE *l_out;
+
+//............................................................................
+// The QS_INIT() argument is the name of the binary output file, which can be
+// post-processed by QSPY. NULL argument writes the binary trace to stdout,
+// which can be piped to QSPY.
+uint8_t QS_onStartup(void const *arg) {
+    static uint8_t qsTxBuf[QS_TX_SIZE]; // buffer for QS transmit channel
+    static uint8_t qsRxBuf[QS_RX_SIZE]; // buffer for QS receive channel
+
+    QS_initBuf  (qsTxBuf, sizeof(qsTxBuf));
+    QS_rxInitBuf(qsRxBuf, sizeof(qsRxBuf));
+
+    if (arg != (void *)0) {
+        l_out = fopen((char const *)arg, "wb");
+        if (l_out == (FILE *)0) {
+            return 0U; // return failure
+        }
+    }
+    else {
+        l_out = stdout;
+    }
+    return 1U; // return success
+}
+//............................................................................
+void QS_onCleanup(void) {
+    QS_output();
+    if ((l_out != (FILE *)0) && (l_out != stdout)) {
+        (void)fclose(l_out);
+    }
+    l_out = (FILE *)0;
+}
+//............................................................................
+void QS_onFlush(void) {
+    QS_output();
+    if (l_out != (FILE *)0) {
+        (void)fflush(l_out);
+    }
+}
+//............................................................................
+// NOTE: invoked inside the QF critical section
+QSTimeCtr QS_onGetTime(void) {
+    struct timespec tspec;
+    (void)clock_gettime(CLOCK_MONOTONIC, &tspec);
+
+    // 32-bit nanosecond time stamp (wraps around every ~4.3 seconds)
+    return (QSTimeCtr)(((uint64_t)tspec.tv_sec * 1000000000U)
+                       + (uint64_t)tspec.tv_nsec);
+}
+//............................................................................
+// NOTE: must be called with the QF critical section exited
+void QS_output(void) {
+    if (l_out == (FILE *)0) { // QS not started yet?
+        return;
+    }
+    for (;;) {
+        uint16_t nBytes = QS_TX_CHUNK;
+        QF_CRIT_STAT
+        QF_CRIT_ENTRY();
+        uint8_t const *block = QS_getBlock(&nBytes);
+        QF_CRIT_EXIT();
+
+        if (block == (uint8_t *)0) { // no more data?
+            break;
+        }
+        (void)fwrite(block, 1U, nBytes, l_out);
+    }
+}
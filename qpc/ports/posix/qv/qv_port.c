@@ -0,0 +1,180 @@
+//============================================================================
+// QP/C Real-Time Embedded Framework (RTEF)
+//
+//                   Q u a n t u m  L e a P s
+//                   ------------------------
+//                   Modern Embedded Software
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open source GNU
+// General Public License version 3 (or any later version), or alternatively,
+// under the terms of one of the closed source Quantum Leaps commercial
+// licenses.
+//
+// The terms of the open source GNU General Public License version 3
+// can be found at: <www.gnu.org/licenses/gpl-3.0>
+//
+// The terms of the closed source Quantum Leaps commercial licenses
+// can be found at: <www.state-machine.com/licensing>
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// Contact information:
+// <www.state-machine.com>
+// <info@state-machine.com>
+//============================================================================
+//! @date Last updated on: 2026-10-17
+//! @version Last updated for: @ref qpc_7_3_0
+//!
+//! @file
+//! @brief QV/C port to POSIX (Linux), GNU-C
+
+// expose timerfd and the POSIX scheduling API
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#define QP_IMPL 1U
+#include "qp_port.h"
+#include "qp_pkg.h"
+#include "qsafe.h"        // QP Functional Safety (FuSa) Subsystem
+#ifdef Q_SPY              // QS software tracing enabled?
+    #include "qs_port.h"  // QS port
+#else
+    #include "qs_dummy.h" // disable the QS software tracing
+#endif // Q_SPY
+
+#include <errno.h>        // EPERM
+#include <sched.h>        // POSIX scheduling policies
+#include <stdint.h>
+#include <unistd.h>       // read(), close()
+#include <sys/timerfd.h>  // Linux timerfd API
+
+Q_DEFINE_THIS_MODULE("qv_port")
+
+// the QF critical section (recursive, see NOTE1 in qp_port.h) and
+// the condition variable of the QV event loop
+static pthread_mutex_t l_critSectMutex =
+    PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+pthread_cond_t QV_condVar_ = PTHREAD_COND_INITIALIZER;
+
+static uint32_t  l_tickPerSec = 100U; // default clock tick rate [Hz]
+static int       l_tickPrio   = 0;    // default ticker thread priority
+static pthread_t l_tickerThread;
+
+//............................................................................
+void QF_enterCriticalSection_(void) {
+    (void)pthread_mutex_lock(&l_critSectMutex);
+}
+//............................................................................
+void QF_leaveCriticalSection_(void) {
+    (void)pthread_mutex_unlock(&l_critSectMutex);
+}
+
+//............................................................................
+void QF_setTickRate(uint32_t ticksPerSec, int tickPrio) {
+    l_tickPerSec = ticksPerSec;
+    l_tickPrio   = tickPrio;
+}
+
+//............................................................................
+// Called by QF_run() with the QF critical section entered, see NOTE3 in
+// qp_port.h. Returns with the QF critical section exited.
+void QV_onIdle(void) {
+#ifdef Q_SPY
+    QF_INT_ENABLE();
+    QS_output(); // transmit the trace produced so far, outside crit. sect.
+    QF_INT_DISABLE();
+
+    // an event might have been posted while the trace was being written
+    if (QPSet_notEmpty(&QV_priv_.readySet)
+#ifdef QACTIVE_ISR_RING
+        || (QActive_isrRingPending_ != 0U)
+#endif
+        )
+    {
+        QF_INT_ENABLE();
+        return;
+    }
+#endif // Q_SPY
+
+    // atomically release the mutex and wait for an event to be posted.
+    // NOTE: spurious wake-ups are harmless, because the QV event loop
+    // re-checks the ready-set after QV_onIdle() returns.
+    (void)pthread_cond_wait(&QV_condVar_, &l_critSectMutex);
+    QF_INT_ENABLE();
+}
+
+#ifdef QACTIVE_ISR_RING
+//............................................................................
+// Called by the ISR-ring producer (another thread standing in for an ISR)
+// after publishing an entry. Taking the mutex here only serializes the
+// wake-up with the pthread_cond_wait() in QV_onIdle(), see NOTE4 in
+// qp_port.h; the ring itself is not protected by the mutex.
+void QV_isrRingSignal_(void) {
+    (void)pthread_mutex_lock(&l_critSectMutex);
+    (void)pthread_cond_signal(&QV_condVar_);
+    (void)pthread_mutex_unlock(&l_critSectMutex);
+}
+#endif // QACTIVE_ISR_RING
+
+//............................................................................
+static void *ticker_thread(void *arg) { // the expected P-Thread signature
+    int const fd = (int)(intptr_t)arg;
+
+    for (;;) {
+        uint64_t nExp;
+        if (read(fd, &nExp, sizeof(nExp)) != (ssize_t)sizeof(nExp)) {
+            break; // the timerfd has been closed or failed
+        }
+        // catch up with all expirations (e.g., after thread preemption)
+        for (; nExp != 0U; --nExp) {
+            QF_onClockTick(); // call the application clock-tick callback
+        }
+    }
+    (void)close(fd);
+    return (void *)0; // return success
+}
+
+//............................................................................
+// Called from QF_run() with the QF critical section entered, so the ticker
+// cannot call QF_onClockTick() before the QV event loop starts.
+void QV_start_(void) {
+    if (l_tickPerSec == 0U) { // ticker disabled?
+        return;
+    }
+
+    int const fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    Q_ASSERT_INCRIT(100, fd >= 0);
+
+    struct itimerspec tspec;
+    tspec.it_interval.tv_sec  = (time_t)(1U / l_tickPerSec);
+    tspec.it_interval.tv_nsec = (long)((1000000000UL / l_tickPerSec)
+                                       % 1000000000UL);
+    tspec.it_value = tspec.it_interval;
+    int err = timerfd_settime(fd, 0, &tspec, (struct itimerspec *)0);
+    Q_ASSERT_INCRIT(110, err == 0);
+
+    pthread_attr_t attr;
+    (void)pthread_attr_init(&attr);
+    if (l_tickPrio > 0) { // real-time priority requested?
+        struct sched_param param;
+        param.sched_priority = l_tickPrio;
+        (void)pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        (void)pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        (void)pthread_attr_setschedparam(&attr, &param);
+    }
+    err = pthread_create(&l_tickerThread, &attr, &ticker_thread,
+                         (void *)(intptr_t)fd);
+    if (err == EPERM) { // insufficient privileges for SCHED_FIFO?
+        (void)pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+        err = pthread_create(&l_tickerThread, &attr, &ticker_thread,
+                             (void *)(intptr_t)fd);
+    }
+    (void)pthread_attr_destroy(&attr);
+    Q_ASSERT_INCRIT(120, err == 0);
+}
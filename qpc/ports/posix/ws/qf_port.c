@@ -0,0 +1,353 @@
+//============================================================================
+// QP/C Real-Time Embedded Framework (RTEF)
+//
+//                   Q u a n t u m  L e a P s
+//                   ------------------------
+//                   Modern Embedded Software
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open source GNU
+// General Public License version 3 (or any later version), or alternatively,
+// under the terms of one of the closed source Quantum Leaps commercial
+// licenses.
+//
+// The terms of the open source GNU General Public License version 3
+// can be found at: <www.gnu.org/licenses/gpl-3.0>
+//
+// The terms of the closed source Quantum Leaps commercial licenses
+// can be found at: <www.state-machine.com/licensing>
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// Contact information:
+// <www.state-machine.com>
+// <info@state-machine.com>
+//============================================================================
+//! @date Last updated on: 2026-10-17
+//! @version Last updated for: @ref qpc_7_3_0
+//!
+//! @file
+//! @brief QF/C port to POSIX (Linux), work-stealing QV-like scheduler
+
+// expose timerfd and the recursive mutex initializer
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#define QP_IMPL           // this is QP implementation
+#include "qp_port.h"      // QP port
+#include "qp_pkg.h"       // QP package-scope interface
+#include "qsafe.h"        // QP Functional Safety (FuSa) Subsystem
+#ifdef Q_SPY              // QS software tracing enabled?
+    #include "qs_port.h"  // QS port
+    #include "qs_pkg.h"   // QS package-scope internal interface
+#else
+    #include "qs_dummy.h" // disable the QS software tracing
+#endif // Q_SPY
+
+#include <pthread.h>      // POSIX-thread API
+#include <sched.h>        // POSIX scheduling policies
+#include <stdint.h>
+#include <unistd.h>       // read(), close(), sysconf()
+#include <sys/timerfd.h>  // Linux timerfd API
+
+Q_DEFINE_THIS_MODULE("qf_port")
+
+// the QF critical section, see NOTE2 in qp_port.h
+static pthread_mutex_t l_critSectMutex =
+    PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+// idle workers wait for work on this condition variable
+static pthread_cond_t l_workCond = PTHREAD_COND_INITIALIZER;
+
+static QPSet        l_readySet[QF_MAX_WORKERS]; // ready-sets of the workers
+static pthread_t    l_worker[QF_MAX_WORKERS];   // the worker threads
+static uint_fast8_t l_nWorkers;   // number of workers (0 == default)
+static uint_fast8_t l_nIdle;      // number of workers waiting for work
+static bool         l_isRunning;  // flag indicating when QF is running
+
+static uint32_t l_tickPerSec = 100U; // default clock tick rate [Hz]
+static int      l_tickPrio   = 0;    // default ticker thread priority
+
+#ifdef QF_EPOOL_MAG
+// the AO run by the calling worker, see NOTE5 in qp_port.h
+__thread QActive *QF_magAct_;
+#endif
+
+//............................................................................
+void QF_enterCriticalSection_(void) {
+    (void)pthread_mutex_lock(&l_critSectMutex);
+}
+//............................................................................
+void QF_leaveCriticalSection_(void) {
+    (void)pthread_mutex_unlock(&l_critSectMutex);
+}
+
+//............................................................................
+void QF_setTickRate(uint32_t ticksPerSec, int tickPrio) {
+    l_tickPerSec = ticksPerSec;
+    l_tickPrio   = tickPrio;
+}
+
+//............................................................................
+void QF_setWorkers(uint_fast8_t nWorkers) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(100, (0U < nWorkers) && (nWorkers <= QF_MAX_WORKERS));
+    l_nWorkers = nWorkers;
+    QF_CRIT_EXIT();
+}
+
+//............................................................................
+// NOTE: called inside the critical section, when an event has been posted
+// to the empty queue of the AO
+void QF_makeReady_(QActive * const act) {
+    if (!act->osObject.busy) { // not executing an RTC step right now?
+        QPSet_insert(&l_readySet[act->osObject.worker], act->prio);
+        if (l_nIdle != 0U) { // any worker waiting for work?
+            (void)pthread_cond_signal(&l_workCond);
+        }
+    }
+    // else: the worker executing the AO re-inserts it after the RTC step
+}
+
+//............................................................................
+// returns the lowest-priority AO ready to run in the given ready-set
+static uint_fast8_t findMin_(QPSet const * const set) {
+    #if (QF_MAX_ACTIVE <= 32U)
+    return (uint_fast8_t)__builtin_ctz((unsigned)set->bits[0]) + 1U;
+    #else
+    return (set->bits[0] != 0U)
+        ? ((uint_fast8_t)__builtin_ctz((unsigned)set->bits[0]) + 1U)
+        : ((uint_fast8_t)__builtin_ctz((unsigned)set->bits[1]) + 33U);
+    #endif
+}
+
+//............................................................................
+// NOTE: called inside the critical section
+static uint_fast8_t schedule_(uint_fast8_t const w) {
+    uint_fast8_t p = 0U;
+    if (QPSet_notEmpty(&l_readySet[w])) { // own work available?
+        p = QPSet_findMax(&l_readySet[w]); // highest-priority first
+        QPSet_remove(&l_readySet[w], p);
+    }
+    else { // try to steal work from the other workers...
+        for (uint_fast8_t n = 1U; n < l_nWorkers; ++n) {
+            uint_fast8_t const v = (uint_fast8_t)((w + n) % l_nWorkers);
+            if (QPSet_notEmpty(&l_readySet[v])) {
+                p = findMin_(&l_readySet[v]); // lowest-priority first
+                QPSet_remove(&l_readySet[v], p);
+                QActive_registry_[p]->osObject.worker = (uint8_t)w;
+                break;
+            }
+        }
+    }
+    return p;
+}
+
+//............................................................................
+static void *worker_thread(void *arg) { // the expected P-Thread signature
+    uint_fast8_t const w = (uint_fast8_t)(uintptr_t)arg;
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    while (l_isRunning) {
+        uint_fast8_t const p = schedule_(w);
+        if (p == 0U) { // no work available?
+            ++l_nIdle;
+            (void)pthread_cond_wait(&l_workCond, &l_critSectMutex);
+            --l_nIdle;
+            continue;
+        }
+
+        QActive * const a = QActive_registry_[p];
+        Q_ASSERT_INCRIT(230, !a->osObject.busy); // RTC must not overlap
+        a->osObject.busy = true; // no other worker can run the AO now
+        QF_CRIT_EXIT();
+
+    #ifdef QF_EPOOL_MAG
+        QF_magAct_ = a; // the RTC step may use the magazines of a
+    #endif
+        QEvt const * const e = QActive_get_(a);
+        (*a->super.vptr->dispatch)(&a->super, e, p);
+    #if (QF_MAX_EPOOL > 0U)
+        QF_gc(e);
+    #endif
+    #ifdef QF_EPOOL_MAG
+        QF_magAct_ = (QActive *)0;
+    #endif
+
+        QF_CRIT_ENTRY();
+        a->osObject.busy = false;
+        if (a->eQueue.frontEvt != (QEvt *)0) { // more events for the AO?
+            QF_makeReady_(a);
+        }
+    }
+    QF_CRIT_EXIT();
+
+    return (void *)0; // return success
+}
+
+//............................................................................
+void QF_init(void) {
+    QF_bzero_(&QF_priv_,                 sizeof(QF_priv_));
+    QF_bzero_(&QTimeEvt_timeEvtHead_[0], sizeof(QTimeEvt_timeEvtHead_));
+    #ifdef QF_TIMEEVT_WHEEL
+    QF_bzero_(&QTimeEvt_wheel_[0],       sizeof(QTimeEvt_wheel_));
+    #endif
+    #ifdef QF_TIMEEVT_ABS
+    QF_bzero_(&QTimeEvt_tickCtr_[0],     sizeof(QTimeEvt_tickCtr_));
+    #endif
+    QF_bzero_(&QActive_registry_[0],     sizeof(QActive_registry_));
+    QF_bzero_(&l_readySet[0],            sizeof(l_readySet));
+}
+
+//............................................................................
+void QF_stop(void) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    l_isRunning = false; // terminate the workers and the ticker loop
+    (void)pthread_cond_broadcast(&l_workCond);
+    QF_CRIT_EXIT();
+}
+
+//............................................................................
+// Runs the ticker loop in the calling (main) thread, see NOTE3 in qp_port.h
+int_t QF_run(void) {
+    QF_onStartup(); // application-specific startup callback
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    if (l_nWorkers == 0U) { // number of workers not set?
+        long const nCPU = sysconf(_SC_NPROCESSORS_ONLN);
+        l_nWorkers = (nCPU < 1) ? 1U
+            : ((nCPU > (long)QF_MAX_WORKERS) ? QF_MAX_WORKERS
+               : (uint_fast8_t)nCPU);
+    }
+
+    // distribute the AOs with events already posted among the workers
+    QPSet ready;
+    QF_bzero_(&ready, sizeof(ready));
+    for (uint_fast8_t w = 0U; w < QF_MAX_WORKERS; ++w) {
+        for (uint_fast8_t k = 0U; k < Q_DIM(ready.bits); ++k) {
+            ready.bits[k] |= l_readySet[w].bits[k];
+        }
+    }
+    QF_bzero_(&l_readySet[0], sizeof(l_readySet));
+    uint_fast8_t w = 0U;
+    for (uint_fast8_t p = 1U; p <= QF_MAX_ACTIVE; ++p) {
+        QActive * const a = QActive_registry_[p];
+        if (a != (QActive *)0) {
+            a->osObject.worker = (uint8_t)w; // round-robin assignment
+            if (QPSet_hasElement(&ready, p)) {
+                QPSet_insert(&l_readySet[w], p);
+            }
+            w = (uint_fast8_t)((w + 1U) % l_nWorkers);
+        }
+    }
+
+    l_isRunning = true;
+    #ifdef Q_SPY
+    // produce the QS_QF_RUN trace record
+    QS_beginRec_((uint_fast8_t)QS_QF_RUN);
+    QS_endRec_();
+    #endif // Q_SPY
+
+    for (w = 0U; w < l_nWorkers; ++w) {
+        int const err = pthread_create(&l_worker[w], (pthread_attr_t *)0,
+                                       &worker_thread, (void *)(uintptr_t)w);
+        Q_ASSERT_INCRIT(200, err == 0);
+    }
+    QF_CRIT_EXIT();
+
+    if (l_tickPerSec != 0U) { // clock tick enabled?
+        if (l_tickPrio > 0) { // real-time priority requested?
+            struct sched_param param;
+            param.sched_priority = l_tickPrio;
+            // NOTE: silently ignored without sufficient privileges (EPERM)
+            (void)pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        }
+
+        int const fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        QF_CRIT_ENTRY();
+        Q_ASSERT_INCRIT(210, fd >= 0);
+        QF_CRIT_EXIT();
+
+        struct itimerspec tspec;
+        tspec.it_interval.tv_sec  = (time_t)(1U / l_tickPerSec);
+        tspec.it_interval.tv_nsec = (long)((1000000000UL / l_tickPerSec)
+                                           % 1000000000UL);
+        tspec.it_value = tspec.it_interval;
+        int const err = timerfd_settime(fd, 0, &tspec,
+                                        (struct itimerspec *)0);
+        QF_CRIT_ENTRY();
+        Q_ASSERT_INCRIT(220, err == 0);
+        QF_CRIT_EXIT();
+
+        for (;;) {
+            QF_CRIT_ENTRY();
+            bool const isRunning = l_isRunning;
+            QF_CRIT_EXIT();
+            if (!isRunning) {
+                break;
+            }
+
+            uint64_t nExp;
+            if (read(fd, &nExp, sizeof(nExp)) != (ssize_t)sizeof(nExp)) {
+                break; // the timerfd failed
+            }
+            // catch up with all expirations (e.g., after thread preemption)
+            for (; nExp != 0U; --nExp) {
+                QF_onClockTick(); // call the application clock-tick callback
+            }
+    #ifdef Q_SPY
+            QS_output(); // transmit the trace produced since the last tick
+    #endif
+        }
+        (void)close(fd);
+    }
+
+    // wait for all the workers to finish their current RTC steps
+    for (w = 0U; w < l_nWorkers; ++w) {
+        (void)pthread_join(l_worker[w], (void **)0);
+    }
+
+    QF_onCleanup(); // application-specific cleanup callback
+    QS_EXIT();      // cleanup the QSPY connection
+
+    return 0; // return success
+}
+
+//............................................................................
+void QActive_start_(QActive * const me,
+    QPrioSpec const prioSpec,
+    QEvt const * * const qSto,
+    uint_fast16_t const qLen,
+    void * const stkSto,
+    uint_fast16_t const stkSize,
+    void const * const par)
+{
+    Q_UNUSED_PAR(stkSize); // not needed in this port
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    // the workers have their own stacks, so stkSto must NOT be provided
+    Q_REQUIRE_INCRIT(300, stkSto == (void *)0);
+    QF_CRIT_EXIT();
+
+    me->prio  = (uint8_t)(prioSpec & 0xFFU); // QF-prio. of the AO
+    me->pthre = 0U; // preemption-threshold (not used in this port)
+    me->osObject.worker = 0U; // assigned to the workers in QF_run()
+    me->osObject.busy   = false;
+    QActive_register_(me); // make QF aware of this active object
+
+    QEQueue_init(&me->eQueue, qSto, qLen); // init the built-in queue
+
+    // top-most initial tran. (virtual call)
+    (*me->super.vptr->init)(&me->super, par, me->prio);
+    QS_FLUSH(); // flush the trace buffer to the host
+}
@@ -0,0 +1,178 @@
+//============================================================================
+// QP/C Real-Time Embedded Framework (RTEF)
+//
+//                   Q u a n t u m  L e a P s
+//                   ------------------------
+//                   Modern Embedded Software
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open source GNU
+// General Public License version 3 (or any later version), or alternatively,
+// under the terms of one of the closed source Quantum Leaps commercial
+// licenses.
+//
+// The terms of the open source GNU General Public License version 3
+// can be found at: <www.gnu.org/licenses/gpl-3.0>
+//
+// The terms of the closed source Quantum Leaps commercial licenses
+// can be found at: <www.state-machine.com/licensing>
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// Contact information:
+// <www.state-machine.com>
+// <info@state-machine.com>
+//============================================================================
+//! @date Last updated on: 2026-10-17
+//! @version Last updated for: @ref qpc_7_3_0
+//!
+//! @file
+//! @brief QP/C port to POSIX (Linux), work-stealing QV-like scheduler
+
+#ifndef QP_PORT_H_
+#define QP_PORT_H_
+
+#include <stdint.h>  // Exact-width types. WG14/N843 C99 Standard
+#include <stdbool.h> // Boolean type.      WG14/N843 C99 Standard
+
+#ifdef QP_CONFIG
+#include "qp_config.h" // external QP configuration
+#endif
+
+#ifdef QACTIVE_ISR_RING
+// the workers of this port never drain the ISR rings (QActive_drainIsrRings_())
+#error QACTIVE_ISR_RING requires the QV kernel;
+#endif
+
+// no-return function specifier (C11 Standard)
+#define Q_NORETURN   _Noreturn void
+
+// maximum number of worker threads
+#ifndef QF_MAX_WORKERS
+#define QF_MAX_WORKERS          64U
+#endif
+
+// scheduling attributes of an AO, see NOTE1
+typedef struct {
+    uint8_t worker;  //!< the worker, in whose ready-set the AO is inserted
+    bool    busy;    //!< the AO is executing an RTC step
+} QWorkerAttr;
+
+// QActive event queue and scheduling attributes, see NOTE1
+#define QACTIVE_EQUEUE_TYPE     QEQueue
+#define QACTIVE_OS_OBJ_TYPE     QWorkerAttr
+
+// QF "interrupt" disable/enable, see NOTE2
+#define QF_INT_DISABLE()        QF_enterCriticalSection_()
+#define QF_INT_ENABLE()         QF_leaveCriticalSection_()
+
+// QF critical section (recursive mutex), see NOTE2
+#define QF_CRIT_STAT
+#define QF_CRIT_ENTRY()         QF_enterCriticalSection_()
+#define QF_CRIT_EXIT()          QF_leaveCriticalSection_()
+
+// the GNU-C compiler provides the CLZ builtin for fast LOG2
+#define QF_LOG2(n_) ((uint_fast8_t)(32 - __builtin_clz((unsigned)(n_))))
+
+// internal functions for the critical section
+void QF_enterCriticalSection_(void);
+void QF_leaveCriticalSection_(void);
+
+// set the number of worker threads (call before QF_run()), see NOTE1
+void QF_setWorkers(uint_fast8_t nWorkers);
+
+// set the clock tick rate and the priority of the ticker thread, see NOTE3
+void QF_setTickRate(uint32_t ticksPerSec, int tickPrio);
+
+// clock tick callback (provided by the application), see NOTE3
+void QF_onClockTick(void);
+
+// include files -------------------------------------------------------------
+#include "qequeue.h"   // this port uses the native QP event queue
+#include "qmpool.h"    // this port uses the native QP memory pool
+#include "qp.h"        // QP framework
+
+//============================================================================
+// interface used only inside QF implementation, but not in applications
+
+#ifdef QP_IMPL
+
+// scheduler locking, see NOTE4
+#define QF_SCHED_STAT_
+#define QF_SCHED_LOCK_(dummy) ((void)0)
+#define QF_SCHED_UNLOCK_()    ((void)0)
+
+// native event queue operations, see NOTE1
+#define QACTIVE_EQUEUE_WAIT_(me_) \
+    Q_ASSERT_INCRIT(310, (me_)->eQueue.frontEvt != (QEvt *)0)
+#define QACTIVE_EQUEUE_SIGNAL_(me_) QF_makeReady_((me_))
+
+// make the AO ready to run (called inside the critical section)
+void QF_makeReady_(QActive * const act);
+
+// native QF event pool operations
+#define QF_EPOOL_TYPE_   QMPool
+#define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
+    (QMPool_init(&(p_), (poolSto_), (poolSize_), (evtSize_)))
+#define QF_EPOOL_EVENT_SIZE_(p_)  ((uint_fast16_t)(p_).blockSize)
+#define QF_EPOOL_GET_(p_, e_, m_, qs_id_) \
+    ((e_) = (QEvt *)QMPool_get(&(p_), (m_), (qs_id_)))
+#define QF_EPOOL_PUT_(p_, e_, qs_id_) \
+    (QMPool_put(&(p_), (e_), (qs_id_)))
+
+#ifdef QF_EPOOL_MAG
+// the AO run by the calling worker thread, see NOTE5
+extern __thread QActive *QF_magAct_;
+#define QF_MAG_ACT_() (QF_magAct_)
+#endif // def QF_EPOOL_MAG
+
+#endif // QP_IMPL
+
+//============================================================================
+// NOTE1:
+// This port runs the cooperative QV scheduling policy on N worker threads
+// (QF_setWorkers(), by default the number of on-line CPUs). Every worker
+// has its own ready-set of AOs, which is the priority-ordered equivalent of
+// a work-stealing deque: the worker itself always runs the highest-priority
+// ready AO from its set, while an idle worker steals the lowest-priority
+// ready AO from the set of another worker. A stolen AO stays with the thief
+// (QWorkerAttr.worker), which keeps the AO's data in one CPU cache.
+//
+// An AO is inserted into a ready-set only when it has events and is NOT
+// executing an RTC step (QWorkerAttr.busy), so at most one worker can ever
+// execute the AO, which preserves the RTC semantics of every AO.
+//
+// NOTE2:
+// The QF "interrupts" and the QF critical section are both implemented
+// with a single, recursive POSIX mutex, which protects the event queues,
+// event pools, time events and the ready-sets of all workers. The mutex is
+// recursive, because some QS trace records (e.g., the function dictionary
+// of QHsm_top in QHsm_init_()) are produced inside the critical section.
+// The RTC steps run outside of the critical section, in parallel.
+//
+// NOTE3:
+// QF_run() starts the workers and turns the main thread into the ticker
+// thread, which reads a Linux timerfd and calls QF_onClockTick() once per
+// timer expiration. QF_run() returns after QF_stop(), when all workers have
+// finished their current RTC steps. Calling QF_setTickRate() with zero
+// ticksPerSec disables the clock tick.
+//
+// NOTE4:
+// AOs of different priorities can run in parallel on different workers,
+// so the AO priorities do not provide mutual exclusion and locking of the
+// scheduler during publish-subscribe event delivery is not needed.
+//
+// NOTE5:
+// With QF_EPOOL_MAG, a worker sets QF_magAct_ to the AO for the duration
+// of the AO's RTC step (including QF_gc() of the event), so Q_NEW() and
+// QF_gc() use the magazines of that AO without the critical section. The
+// busy flag guarantees that only one worker at a time uses the magazines,
+// and the mutex around the flag orders the accesses of different workers.
+// Other threads (e.g., the ticker) have no AO and use the pools directly.
+//
+
+#endif // QP_PORT_H_
@@ -85,6 +85,10 @@ enum {
     QHSM_MAX_NEST_DEPTH_ = 6
 };
 
+#ifdef QHSM_TRAN_CACHE
+Q_ASSERT_STATIC(QHSM_TRAN_CACHE_DEPTH == (unsigned)QHSM_MAX_NEST_DEPTH_);
+#endif
+
 // helper macro to handle reserved event in an QHsm
 #define QHSM_RESERVED_EVT_(state_, sig_) \
     ((*(state_))(me, &QEvt_reserved_[(sig_)]))
@@ -111,6 +115,26 @@ enum {
     QS_MEM_APP();                               \
     QS_CRIT_EXIT()
 
+#ifdef QHSM_SIG_MASK
+// helper macro to test a signal in a handled-signal bitmask
+#define QHSM_SIG_TEST_(bits_, sig_) \
+    (((bits_)[(sig_) >> 3U] & (1U << ((sig_) & 7U))) != 0U)
+
+// helper function to find the handled-signal mask of a given state
+static QHsmSigMask const * QHsm_sigMaskOf_(
+    QHsmSigMask const * const masks,
+    uint_fast8_t const nMasks,
+    QStateHandler const state)
+{
+    for (uint_fast8_t i = 0U; i < nMasks; ++i) {
+        if (masks[i].state == state) {
+            return &masks[i];
+        }
+    }
+    return (QHsmSigMask const *)0; // the state is not in the table
+}
+#endif // def QHSM_SIG_MASK
+
 //! @endcond
 
 //$define${QEP::QHsm} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
@@ -133,6 +157,14 @@ void QHsm_ctor(QHsm * const me,
     me->super.vptr      = &vtable;
     me->super.state.fun = Q_STATE_CAST(&QHsm_top);
     me->super.temp.fun  = initial;
+    #ifdef QHSM_TRAN_CACHE
+    me->super.tranCache = (struct QTranCache *)0;
+    #endif
+    #ifdef QHSM_SIG_MASK
+    me->super.sigMasks  = (QHsmSigMask const *)0;
+    me->super.sigMask   = (QHsmSigMask const *)0;
+    me->super.nSigMasks = 0U;
+    #endif
 }
 
 //${QEP::QHsm::init_} ........................................................
@@ -244,6 +276,9 @@ void QHsm_init_(
     #ifndef Q_UNSAFE
     me->temp.uint = ~me->state.uint;
     #endif
+    #ifdef QHSM_SIG_MASK
+    me->sigMask = QHsm_sigMaskOf_(me->sigMasks, me->nSigMasks, t);
+    #endif
 }
 
 //${QEP::QHsm::dispatch_} ....................................................
@@ -278,9 +313,28 @@ void QHsm_dispatch_(
     QF_CRIT_EXIT();
 
     // process the event hierarchically...
-    QState r;
+    QState r = Q_RET_SUPER;
     me->temp.fun = s;
-    do {
+
+    #ifdef QHSM_SIG_MASK
+    QHsmSigMask const *m = me->sigMask;
+    if ((m != (QHsmSigMask const *)0)
+        && (Q_USER_SIG <= e->sig) && (e->sig < QF_MAX_SIG))
+    {
+        if (QHSM_SIG_TEST_(m->any, e->sig)) {
+            // skip the states that don't handle the signal at all
+            while (!QHSM_SIG_TEST_(m->own, e->sig)) {
+                m = m->super;
+            }
+            me->temp.fun = m->state;
+        }
+        else { // no state in the hierarchy handles the signal
+            r = Q_RET_IGNORED;
+        }
+    }
+    #endif // def QHSM_SIG_MASK
+
+    while (r == Q_RET_SUPER) {
         s = me->temp.fun;
         r = (*s)(me, e); // invoke state handler s
 
@@ -298,7 +352,7 @@ void QHsm_dispatch_(
 
             r = QHSM_RESERVED_EVT_(s, Q_EMPTY_SIG); // superstate of s
         }
-    } while (r == Q_RET_SUPER);
+    }
 
     if (r >= Q_RET_TRAN) { // regular tran. taken?
         QStateHandler path[QHSM_MAX_NEST_DEPTH_];
@@ -307,6 +361,11 @@ void QHsm_dispatch_(
         path[1] = t; // current state
         path[2] = s; // tran. source
 
+    #ifdef QHSM_TRAN_CACHE
+        // exit up to the LCA, possibly replaying a cached tran. path
+        int_fast8_t ip = QHsm_tranCached_(me, path, qs_id);
+        t = s; // the tran. source (for the QS_QEP_TRAN_HIST record)
+    #else
         // exit current state to tran. source s...
         for (; t != s; t = me->temp.fun) {
             // exit from t
@@ -317,6 +376,7 @@ void QHsm_dispatch_(
             }
         }
         int_fast8_t ip = QHsm_tran_(me, path, qs_id); // take the tran.
+    #endif // def QHSM_TRAN_CACHE
 
     #ifdef Q_SPY
         if (r == Q_RET_TRAN_HIST) {
@@ -401,6 +461,10 @@ void QHsm_dispatch_(
         QS_END_PRE_()
         QS_MEM_APP();
         QS_CRIT_EXIT();
+
+    #ifdef QHSM_SIG_MASK
+        me->sigMask = QHsm_sigMaskOf_(me->sigMasks, me->nSigMasks, t);
+    #endif
     }
 
     #ifdef Q_SPY
@@ -660,6 +724,216 @@ int_fast8_t QHsm_tran_(
     return ip;
 }
 
+//${QEP::QHsm::tranCached_} ..................................................
+#ifdef QHSM_TRAN_CACHE
+//! @private @memberof QHsm
+int_fast8_t QHsm_tranCached_(
+    QAsm * const me,
+    QStateHandler * const path,
+    uint_fast8_t const qs_id)
+{
+    #ifndef Q_SPY
+    Q_UNUSED_PAR(qs_id);
+    #endif
+
+    QStateHandler const leaf = path[1]; // path[1] is changed by QHsm_tran_()
+    QStateHandler const s    = path[2];
+    QTranCache * const cache = me->tranCache;
+    struct QTranCacheEntry *ent = (struct QTranCacheEntry *)0;
+    bool isHit = false;
+    QF_CRIT_STAT
+
+    if (cache != (QTranCache *)0) {
+        uintptr_t h = (uintptr_t)leaf
+                      ^ ((uintptr_t)s >> 3U) ^ ((uintptr_t)path[0] >> 5U);
+        h ^= (h >> 11U);
+        ent = &cache->entry[h % QHSM_TRAN_CACHE_SIZE];
+
+        // the cache is shared by all instances of the state machine class,
+        // which might run at different priorities. An entry is written only
+        // once (inside a critical section) and never changes afterwards,
+        // so only the check of the key needs the critical section.
+        QF_CRIT_ENTRY();
+        if (ent->target == Q_STATE_CAST(0)) { // entry still free?
+            // keep 'ent' to fill the entry after the tran.
+        }
+        else if ((ent->leaf == leaf) && (ent->source == s)
+                 && (ent->target == path[0]))
+        {
+            isHit = true;
+        }
+        else { // entry taken by another tran.
+            ent = (struct QTranCacheEntry *)0; // do not cache this tran.
+        }
+        QF_CRIT_EXIT();
+    }
+
+    int_fast8_t ip;
+    if (isHit) {
+        // replay the exits without discovering the superstates
+        uint_fast8_t const nExit = ent->nExit;
+        for (uint_fast8_t i = 0U; i < nExit; ++i) {
+            if (QHSM_RESERVED_EVT_(ent->exitPath[i], Q_EXIT_SIG)
+                == Q_RET_HANDLED)
+            {
+                QS_STATE_EXIT_(ent->exitPath[i], qs_id);
+            }
+        }
+        ip = ent->ip;
+        for (int_fast8_t i = 1; i <= ip; ++i) { // path[0] is the target
+            path[i] = ent->entryPath[i];
+        }
+    }
+    else {
+        // exit current state to tran. source s...
+        for (QStateHandler t = leaf; t != s; t = me->temp.fun) {
+            // exit from t
+            if (QHSM_RESERVED_EVT_(t, Q_EXIT_SIG) == Q_RET_HANDLED) {
+                QS_STATE_EXIT_(t, qs_id);
+                // find superstate of t
+                (void)QHSM_RESERVED_EVT_(t, Q_EMPTY_SIG);
+            }
+        }
+        ip = QHsm_tran_(me, path, qs_id); // take the tran.
+
+        if (ent != (struct QTranCacheEntry *)0) {
+            // the states exited are all states from the leaf up to
+            // (but not including) the LCA, which is the superstate of
+            // the last state to enter, or the target itself when the
+            // target is a superstate of the source and nothing is entered
+            QStateHandler exitPath[QHSM_TRAN_CACHE_DEPTH];
+            uint_fast8_t nExit = 0U;
+            QStateHandler lca = path[0];
+            if (ip >= 0) {
+                (void)QHSM_RESERVED_EVT_(path[ip], Q_EMPTY_SIG);
+                lca = me->temp.fun;
+            }
+            for (QStateHandler t = leaf; t != lca; t = me->temp.fun) {
+                QF_CRIT_ENTRY();
+                Q_ASSERT_INCRIT(710, nExit < QHSM_TRAN_CACHE_DEPTH);
+                QF_CRIT_EXIT();
+
+                exitPath[nExit] = t;
+                ++nExit;
+                (void)QHSM_RESERVED_EVT_(t, Q_EMPTY_SIG); // superstate of t
+            }
+
+            QF_CRIT_ENTRY();
+            if (ent->target == Q_STATE_CAST(0)) { // still free?
+                for (uint_fast8_t i = 0U; i < nExit; ++i) {
+                    ent->exitPath[i] = exitPath[i];
+                }
+                for (int_fast8_t i = 0; i <= ip; ++i) {
+                    ent->entryPath[i] = path[i];
+                }
+                ent->nExit  = (uint8_t)nExit;
+                ent->ip     = (int8_t)ip;
+                ent->leaf   = leaf;
+                ent->source = s;
+                ent->target = path[0]; // the entry becomes valid
+            }
+            QF_CRIT_EXIT();
+        }
+    }
+    return ip;
+}
+#endif // def QHSM_TRAN_CACHE
+
+//${QEP::QHsm::setTranCache} .................................................
+#ifdef QHSM_TRAN_CACHE
+//! @public @memberof QHsm
+void QHsm_setTranCache(QHsm * const me,
+    struct QTranCache * const cache)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(700, me->super.vptr != (struct QAsmVtable *)0);
+    QF_CRIT_EXIT();
+
+    me->super.tranCache = cache; // (QTranCache *)0 disables the cache
+}
+#endif // def QHSM_TRAN_CACHE
+
+//${QEP::QHsm::setSigMasks} ..................................................
+#ifdef QHSM_SIG_MASK
+//! @public @memberof QHsm
+void QHsm_setSigMasks(QHsm * const me,
+    struct QHsmSigMask * const masks,
+    uint_fast8_t const nMasks)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(720, (me->super.vptr != (struct QAsmVtable *)0)
+                      && (masks != (QHsmSigMask *)0)
+                      && (0U < nMasks));
+    QF_CRIT_EXIT();
+
+    // the superstates are discovered by probing the state handlers
+    // with Q_EMPTY_SIG, which clobbers me->temp (the initial pseudostate
+    // before QHsm_init_(), or the inverted state afterwards)
+    union QAsmAttr const temp = me->super.temp;
+
+    uint_fast8_t i;
+    for (i = 0U; i < nMasks; ++i) {
+        QHsmSigMask * const mi = &masks[i];
+        uint_fast8_t j;
+        for (j = 0U; j < Q_DIM(mi->own); ++j) {
+            mi->own[j] = 0U;
+        }
+        if (mi->sigs != (QSignal const *)0) {
+            QSignal const *sig;
+            for (sig = mi->sigs; *sig != 0U; ++sig) {
+                QF_CRIT_ENTRY();
+                Q_ASSERT_INCRIT(722, (Q_USER_SIG <= *sig)
+                                     && (*sig < QF_MAX_SIG));
+                QF_CRIT_EXIT();
+                mi->own[*sig >> 3U] |= (uint8_t)(1U << (*sig & 7U));
+            }
+        }
+
+        // find the superstate of the state
+        (void)(*mi->state)(&me->super, &QEvt_reserved_[Q_EMPTY_SIG]);
+        if (me->super.temp.fun == Q_STATE_CAST(&QHsm_top)) {
+            mi->super = (QHsmSigMask const *)0;
+        }
+        else {
+            mi->super = QHsm_sigMaskOf_(masks, nMasks, me->super.temp.fun);
+            // all superstates of the listed states must be listed as well
+            QF_CRIT_ENTRY();
+            Q_ASSERT_INCRIT(724, mi->super != (QHsmSigMask const *)0);
+            QF_CRIT_EXIT();
+        }
+    }
+    me->super.temp = temp;
+
+    // the signals handled in the state or any of its superstates
+    for (i = 0U; i < nMasks; ++i) {
+        QHsmSigMask * const mi = &masks[i];
+        uint_fast8_t j;
+        for (j = 0U; j < Q_DIM(mi->any); ++j) {
+            mi->any[j] = mi->own[j];
+        }
+        int_fast8_t depth = 0;
+        QHsmSigMask const *ms;
+        for (ms = mi->super; ms != (QHsmSigMask const *)0; ms = ms->super) {
+            ++depth;
+            // the state nesting must not be circular or too deep
+            QF_CRIT_ENTRY();
+            Q_ASSERT_INCRIT(726, depth < QHSM_MAX_NEST_DEPTH_);
+            QF_CRIT_EXIT();
+            for (j = 0U; j < Q_DIM(mi->any); ++j) {
+                mi->any[j] |= ms->own[j];
+            }
+        }
+    }
+
+    me->super.sigMasks  = masks;
+    me->super.nSigMasks = (uint8_t)nMasks;
+    me->super.sigMask   = QHsm_sigMaskOf_(masks, nMasks,
+                                          me->super.state.fun);
+}
+#endif // def QHSM_SIG_MASK
+
 //${QEP::QHsm::top} ..........................................................
 //! @protected @memberof QAsm
 QState QHsm_top(QHsm const * const me,
@@ -61,6 +61,108 @@ Q_DEFINE_THIS_MODULE("qf_actq")
 #endif
 //$endskip${QP_VERSION} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
+//============================================================================
+//! @cond INTERNAL
+
+#ifdef QS_RTC_HIST
+
+#ifdef QF_EQUEUE_POW2
+// ring-buffer slot of the free-running queue counter 'ctr_'
+#define QACTIVE_SLOT_(me_, ctr_) \
+    ((ctr_) & (QEQueueCtr)((me_)->eQueue.end - 1U))
+#else
+#define QACTIVE_SLOT_(me_, ctr_) (ctr_)
+#endif
+
+// time-stamp the event delivered directly to the front of the queue
+#define QACTIVE_STAMP_FRONT_(me_) \
+    ((me_)->frontStamp = (uint32_t)QS_onGetTime())
+
+// time-stamp the event inserted at the ring-buffer counter 'ctr_'
+#define QACTIVE_STAMP_RING_(me_, ctr_) do { \
+    if ((me_)->stampSto != (uint32_t *)0) { \
+        (me_)->stampSto[QACTIVE_SLOT_((me_), (ctr_))] = \
+            (uint32_t)QS_onGetTime(); \
+    } \
+} while (false)
+
+#else
+
+#define QACTIVE_STAMP_FRONT_(me_)      ((void)0)
+#define QACTIVE_STAMP_RING_(me_, ctr_) ((void)0)
+
+#endif // def QS_RTC_HIST
+
+#ifdef QACTIVE_COALESCE
+
+// is the signal 'sig_' coalesced ("latest-wins") in the AO 'me_'?
+#define QACTIVE_COALESCED_(me_, sig_) \
+    (((sig_) < QF_MAX_SIG) \
+     && (((me_)->coalesce[(sig_) >> 3U] & (1U << ((sig_) & 7U))) != 0U))
+
+// replaces the queued event with the signal of 'e' by 'e' in place and
+// returns the replaced event, or NULL if no such event is queued
+// NOTE: must be called inside a critical section
+static QEvt const * QActive_replace_(QActive * const me,
+    QEvt const * const e)
+{
+    QEvt const * const front = me->eQueue.frontEvt;
+    if (front == (QEvt *)0) { // empty queue?
+        return (QEvt *)0;
+    }
+    if (front->sig == e->sig) {
+        me->eQueue.frontEvt = e;
+    #ifdef QACTIVE_URGENT_LANE
+        // 'e' is not urgent, so it must not stay ahead of the urgent lane
+        me->urgent.inFront = false;
+    #endif
+        return front;
+    }
+
+    // search the ring buffer from the tail (the oldest event)
+    QEQueueCtr i = me->eQueue.tail;
+    QEQueueCtr n = me->eQueue.end - me->eQueue.nFree; // # events in ring
+    for (; n > 0U; --n) {
+    #ifdef QF_EQUEUE_POW2
+        QEvt const ** const slot =
+            &me->eQueue.ring[i & (QEQueueCtr)(me->eQueue.end - 1U)];
+    #else
+        QEvt const ** const slot = &me->eQueue.ring[i];
+        if (i == 0U) { // need to wrap?
+            i = me->eQueue.end; // wrap around
+        }
+    #endif
+        --i;
+        if ((*slot)->sig == e->sig) {
+            QEvt const * const old = *slot;
+            *slot = e; // replace in place (keeps the position in the queue)
+            return old;
+        }
+    }
+    return (QEvt *)0;
+}
+
+#endif // def QACTIVE_COALESCE
+
+#ifdef QACTIVE_URGENT_LANE
+
+// removes the oldest event from the (not empty) urgent lane
+// NOTE: must be called inside a critical section
+static QEvt const * QActive_urgentGet_(QActive * const me) {
+    QEvt const * const e = me->urgent.ring[me->urgent.tail];
+    ++me->urgent.tail;
+    if (me->urgent.tail == me->urgent.end) { // need to wrap the tail?
+        me->urgent.tail = 0U; // wrap around
+    }
+    ++me->urgent.nFree;
+    return e;
+}
+
+#endif // def QACTIVE_URGENT_LANE
+
+//! @endcond
+//============================================================================
+
 //$define${QF::QActive::post_} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 
 //${QF::QActive::post_} ......................................................
@@ -88,6 +190,43 @@ bool QActive_post_(QActive * const me,
 
     Q_REQUIRE_INCRIT(102, QEvt_verify_(e));
 
+    #ifdef QACTIVE_COALESCE
+    // a "latest-wins" signal replaces its instance already in the queue
+    // without taking a new entry (even when the queue is full)
+    if (QACTIVE_COALESCED_(me, e->sig)) {
+        QEvt const * const old = QActive_replace_(me, e);
+        if (old != (QEvt *)0) { // replaced?
+            if (QEvt_getPoolId_(e) != 0U) { // is it a mutable event?
+                QEvt_refCtr_inc_(e); // increment the reference counter
+            }
+
+            QS_BEGIN_PRE_(QS_QF_ACTIVE_POST, me->prio)
+                QS_TIME_PRE_();       // timestamp
+                QS_OBJ_PRE_(sender);  // the sender object
+                QS_SIG_PRE_(e->sig);  // the signal of the event
+                QS_OBJ_PRE_(me);      // this active object (recipient)
+                QS_2U8_PRE_(QEvt_getPoolId_(e), e->refCtr_); // poolId & refCtr
+                QS_EQC_PRE_(me->eQueue.nFree); // # free entries (unchanged)
+                QS_EQC_PRE_(me->eQueue.nMin);  // min # free entries
+            QS_END_PRE_()
+
+        #ifdef Q_UTEST
+            if (QS_LOC_CHECK_(me->prio)) {
+                QS_onTestPost(sender, me, e, true);
+            }
+        #endif
+
+            QF_MEM_APP();
+            QF_CRIT_EXIT();
+
+        #if (QF_MAX_EPOOL > 0U)
+            QF_gc(old); // the queue no longer references the replaced event
+        #endif
+            return true;
+        }
+    }
+    #endif // def QACTIVE_COALESCE
+
     QEQueueCtr nFree = me->eQueue.nFree; // get volatile into temporary
 
     // test-probe#1 for faking queue overflow
@@ -147,6 +286,7 @@ bool QActive_post_(QActive * const me,
 
         if (me->eQueue.frontEvt == (QEvt *)0) { // empty queue?
             me->eQueue.frontEvt = e; // deliver event directly
+            QACTIVE_STAMP_FRONT_(me);
 
     #ifdef QXK_H_
             if (me->super.state.act == Q_ACTION_CAST(0)) { // eXtended?
@@ -162,11 +302,17 @@ bool QActive_post_(QActive * const me,
         // queue is not empty, insert event into the ring-buffer
         else {
             // insert event into the ring buffer (FIFO)
+            QACTIVE_STAMP_RING_(me, me->eQueue.head);
+    #ifdef QF_EQUEUE_POW2
+            me->eQueue.ring[me->eQueue.head
+                            & (QEQueueCtr)(me->eQueue.end - 1U)] = e;
+    #else
             me->eQueue.ring[me->eQueue.head] = e;
 
             if (me->eQueue.head == 0U) { // need to wrap head?
                 me->eQueue.head = me->eQueue.end; // wrap around
             }
+    #endif
             --me->eQueue.head; // advance the head (counter clockwise)
         }
 
@@ -205,6 +351,491 @@ bool QActive_post_(QActive * const me,
     return status;
 }
 //$enddef${QF::QActive::post_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::postN_} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+
+//${QF::QActive::postN_} .....................................................
+//! @private @memberof QActive
+bool QActive_postN_(QActive * const me,
+    QEvt const * const * const events,
+    uint_fast16_t const n,
+    uint_fast16_t const margin,
+    void const * const sender)
+{
+    #ifndef Q_SPY
+    Q_UNUSED_PAR(sender);
+    #endif
+
+    #ifdef Q_UTEST // test?
+    #if Q_UTEST != 0 // testing QP-stub?
+    if (me->super.temp.fun == Q_STATE_CAST(0)) { // QActiveDummy?
+        bool ok = true;
+        for (uint_fast16_t i = 0U; i < n; ++i) {
+            ok = QActiveDummy_fakePost_(me, events[i], margin, sender)
+                 && ok;
+        }
+        return ok;
+    }
+    #endif
+    #endif
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    Q_REQUIRE_INCRIT(150, (events != (QEvt const * const *)0)
+                          && (n > 0U));
+
+    QEQueueCtr nFree = me->eQueue.nFree; // get volatile into temporary
+
+    // test-probe#1 for faking queue overflow
+    QS_TEST_PROBE_DEF(&QActive_postN_)
+    QS_TEST_PROBE_ID(1,
+        nFree = 0U;
+    )
+
+    // reserve all the n entries at once (all or nothing)
+    bool status;
+    if (margin == QF_NO_MARGIN) {
+        if (nFree >= n) {
+            status = true; // can post
+        }
+        else {
+            status = false; // cannot post
+            Q_ERROR_INCRIT(195); // must be able to post all the events
+        }
+    }
+    else if ((nFree >= n) && ((nFree - n) >= margin)) {
+        status = true; // can post
+    }
+    else {
+        status = false; // cannot post, but don't assert
+    }
+
+    // verify all events and increment the mutable ones' reference counters
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        Q_REQUIRE_INCRIT(152, QEvt_verify_(events[i]));
+        if (QEvt_getPoolId_(events[i]) != 0U) { // is it a mutable event?
+            QEvt_refCtr_inc_(events[i]); // increment the reference counter
+        }
+    }
+
+    QEvt const * const e = events[0]; // the event summarised in QS
+
+    if (status) { // can post all the events?
+
+        nFree -= (QEQueueCtr)n; // n free entries just used up
+        me->eQueue.nFree = nFree; // update the original
+        if (me->eQueue.nMin > nFree) {
+            me->eQueue.nMin = nFree; // increase minimum so far
+        }
+
+        // one summarising record for the whole batch of n events
+        // (the signal and poolId/refCtr of the first event, and the
+        // number of free entries after all n events have been posted)
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_POST, me->prio)
+            QS_TIME_PRE_();       // timestamp
+            QS_OBJ_PRE_(sender);  // the sender object
+            QS_SIG_PRE_(e->sig);  // the signal of the first event
+            QS_OBJ_PRE_(me);      // this active object (recipient)
+            QS_2U8_PRE_(QEvt_getPoolId_(e), e->refCtr_); // poolId & refCtr
+            QS_EQC_PRE_(nFree);   // # free entries after the batch
+            QS_EQC_PRE_(me->eQueue.nMin); // min # free entries
+        QS_END_PRE_()
+
+    #ifdef Q_UTEST
+        // callback to examine the posted events under the same conditions
+        // as producing the #QS_QF_ACTIVE_POST trace record, which are:
+        // the local filter for this AO ('me->prio') is set
+        if (QS_LOC_CHECK_(me->prio)) {
+            for (uint_fast16_t i = 0U; i < n; ++i) {
+                QS_onTestPost(sender, me, events[i], status);
+            }
+        }
+    #endif
+
+        // the queue might be empty, in which case the first event goes
+        // to the front, but only after the rest is in the ring-buffer,
+        // because signaling the queue might run the AO (e.g., in QK)
+        uint_fast16_t i = (me->eQueue.frontEvt == (QEvt *)0) ? 1U : 0U;
+        for (; i < n; ++i) {
+            // insert event into the ring buffer (FIFO)
+            QACTIVE_STAMP_RING_(me, me->eQueue.head);
+    #ifdef QF_EQUEUE_POW2
+            me->eQueue.ring[me->eQueue.head
+                            & (QEQueueCtr)(me->eQueue.end - 1U)] = events[i];
+    #else
+            me->eQueue.ring[me->eQueue.head] = events[i];
+
+            if (me->eQueue.head == 0U) { // need to wrap head?
+                me->eQueue.head = me->eQueue.end; // wrap around
+            }
+    #endif
+            --me->eQueue.head; // advance the head (counter clockwise)
+        }
+
+        if (me->eQueue.frontEvt == (QEvt *)0) { // empty queue?
+            me->eQueue.frontEvt = e; // deliver event directly
+            QACTIVE_STAMP_FRONT_(me);
+
+    #ifdef QXK_H_
+            if (me->super.state.act == Q_ACTION_CAST(0)) { // eXtended?
+                QXTHREAD_EQUEUE_SIGNAL_(me); // signal the event queue
+            }
+            else {
+                QACTIVE_EQUEUE_SIGNAL_(me); // signal the event queue
+            }
+    #else
+            QACTIVE_EQUEUE_SIGNAL_(me); // signal the event queue
+    #endif
+        }
+
+        QF_MEM_APP();
+        QF_CRIT_EXIT();
+    }
+    else { // cannot post the events
+
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_POST_ATTEMPT, me->prio)
+            QS_TIME_PRE_();       // timestamp
+            QS_OBJ_PRE_(sender);  // the sender object
+            QS_SIG_PRE_(e->sig);  // the signal of the first event
+            QS_OBJ_PRE_(me);      // this active object (recipient)
+            QS_2U8_PRE_(QEvt_getPoolId_(e), e->refCtr_); // poolId & refCtr
+            QS_EQC_PRE_(nFree);   // # free entries
+            QS_EQC_PRE_(margin);  // margin requested
+        QS_END_PRE_()
+
+    #ifdef Q_UTEST
+        if (QS_LOC_CHECK_(me->prio)) {
+            for (uint_fast16_t i = 0U; i < n; ++i) {
+                QS_onTestPost(sender, me, events[i], status);
+            }
+        }
+    #endif
+
+        QF_MEM_APP();
+        QF_CRIT_EXIT();
+
+    #if (QF_MAX_EPOOL > 0U)
+        for (uint_fast16_t i = 0U; i < n; ++i) {
+            QF_gc(events[i]); // recycle the events to avoid leaks
+        }
+    #endif
+    }
+
+    return status;
+}
+//$enddef${QF::QActive::postN_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::isrRing} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+#ifdef QACTIVE_ISR_RING
+
+//${QF::QActive::isrRingPending_} ............................................
+uint8_t volatile QActive_isrRingPending_;
+
+//${QF::QActive::setIsrRing} .................................................
+//! @public @memberof QActive
+void QActive_setIsrRing(QActive * const me,
+    QEvt const * * const ringSto,
+    uint_fast16_t const ringLen)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    // one ring entry always stays free to tell a full ring from an empty one
+    Q_REQUIRE_INCRIT(600, (ringSto != (QEvt const **)0)
+                          && (1U < ringLen) && (ringLen <= 0xFFFFU));
+
+    me->isrRing.ring = (QEvt const * volatile *)ringSto;
+    me->isrRing.end  = (uint16_t)ringLen;
+    me->isrRing.head = 0U;
+    me->isrRing.tail = 0U;
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+}
+
+//${QF::QActive::postFromISR_} ...............................................
+//! @private @memberof QActive
+bool QActive_postFromISR_(QActive * const me,
+    QEvt const * const e)
+{
+    // NOTE: this function is called from a single producer (typically an
+    // ISR) per active object and it never disables interrupts. Therefore,
+    // it cannot assert, trace, or touch the event's reference counter.
+    // The event is posted to the regular event queue later, when the QV
+    // event loop drains the ring in QActive_drainIsrRings_().
+    QIsrRing * const r = &me->isrRing;
+    uint_fast16_t const head = r->head; // only the producer changes head
+    uint_fast16_t next = head + 1U;
+    if (next == r->end) { // need to wrap?
+        next = 0U;
+    }
+
+    bool status;
+    if ((r->end == 0U) || (next == r->tail)) { // no ring or ring full?
+        status = false; // the caller still owns the event
+    }
+    else {
+        r->ring[head] = e;
+        QF_ISR_RING_BARRIER(); // publish the entry before the index
+        r->head = (uint16_t)next;
+        QF_ISR_RING_BARRIER(); // publish the index before the flag
+        QActive_isrRingPending_ = 1U;
+
+    #ifdef QACTIVE_ISR_RING_SIGNAL_
+        QACTIVE_ISR_RING_SIGNAL_(); // wake up the (idle) event loop
+    #endif
+        status = true;
+    }
+    return status;
+}
+
+//${QF::QActive::drainIsrRings_} .............................................
+//! @static @private @memberof QActive
+void QActive_drainIsrRings_(void) {
+    // NOTE: called from the QV event loop with interrupts enabled
+
+    // clear the flag *before* scanning the rings, so that an entry
+    // published after the scan of its ring sets the flag again
+    QActive_isrRingPending_ = 0U;
+    QF_ISR_RING_BARRIER();
+
+    for (uint_fast8_t p = 1U; p <= QF_MAX_ACTIVE; ++p) {
+        QActive * const a = QActive_registry_[p];
+        if ((a == (QActive *)0) || (a->isrRing.end == 0U)) {
+            continue; // no AO or no ring at this prio.
+        }
+        QIsrRing * const r = &a->isrRing;
+        uint_fast16_t tail = r->tail; // only the consumer changes tail
+        uint_fast16_t const head = r->head;
+        QF_ISR_RING_BARRIER(); // read the index before the entries
+
+        // post the entries in at most two contiguous batches
+        while (tail != head) {
+            uint_fast16_t const n = (head > tail)
+                                    ? (head - tail)
+                                    : (r->end - tail);
+            (void)QActive_postN_(a,
+                (QEvt const * const *)&r->ring[tail], n,
+                QF_NO_MARGIN, (void *)0);
+            tail += n;
+            if (tail == r->end) { // need to wrap?
+                tail = 0U;
+            }
+            QF_ISR_RING_BARRIER(); // finish reading before freeing entries
+            r->tail = (uint16_t)tail;
+        }
+    }
+}
+
+#endif // def QACTIVE_ISR_RING
+//$enddef${QF::QActive::isrRing} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::setStampSto} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+#ifdef QS_RTC_HIST
+
+//${QF::QActive::setStampSto} ................................................
+//! @public @memberof QActive
+void QActive_setStampSto(QActive * const me,
+    uint32_t * const stampSto,
+    uint_fast16_t const stampLen)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    // the AO must be started (queue initialized) and the storage must
+    // provide one time stamp per ring-buffer entry
+    Q_REQUIRE_INCRIT(700, (stampSto != (uint32_t *)0)
+                          && (me->eQueue.ring != (QEvt const **)0)
+                          && (stampLen >= (uint_fast16_t)me->eQueue.end));
+
+    // the events already in the queue count as posted now
+    uint32_t const now = (uint32_t)QS_onGetTime();
+    for (uint_fast16_t i = 0U; i < stampLen; ++i) {
+        stampSto[i] = now;
+    }
+    me->frontStamp = now;
+    me->stampSto = stampSto;
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+}
+
+#endif // def QS_RTC_HIST
+//$enddef${QF::QActive::setStampSto} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::setCoalesce} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+#ifdef QACTIVE_COALESCE
+
+//${QF::QActive::setCoalesce} ................................................
+//! @public @memberof QActive
+void QActive_setCoalesce(QActive * const me,
+    QSignal const * const sigs)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    // the zero-terminated list of the "latest-wins" signals replaces
+    // the previous one ((QSignal const *)0 disables coalescing)
+    for (uint_fast8_t i = 0U; i < Q_DIM(me->coalesce); ++i) {
+        me->coalesce[i] = 0U;
+    }
+    if (sigs != (QSignal const *)0) {
+        for (QSignal const *sig = sigs; *sig != 0U; ++sig) {
+            Q_REQUIRE_INCRIT(800, (Q_USER_SIG <= *sig)
+                                  && (*sig < QF_MAX_SIG));
+            me->coalesce[*sig >> 3U] |= (uint8_t)(1U << (*sig & 7U));
+        }
+    }
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+}
+
+#endif // def QACTIVE_COALESCE
+//$enddef${QF::QActive::setCoalesce} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QActive::urgentLane} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+#ifdef QACTIVE_URGENT_LANE
+
+//${QF::QActive::setUrgentLane} ..............................................
+//! @public @memberof QActive
+void QActive_setUrgentLane(QActive * const me,
+    QEvt const * * const laneSto,
+    uint_fast16_t const laneLen)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    Q_REQUIRE_INCRIT(820, (laneSto != (QEvt const **)0)
+                          && (0U < laneLen) && (laneLen <= 0xFFFFU));
+
+    me->urgent.ring    = laneSto;
+    me->urgent.end     = (uint16_t)laneLen;
+    me->urgent.head    = 0U;
+    me->urgent.tail    = 0U;
+    me->urgent.nFree   = (uint16_t)laneLen;
+    me->urgent.nMin    = (uint16_t)laneLen;
+    me->urgent.inFront = false;
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+}
+
+//${QF::QActive::postUrgent_} ................................................
+//! @private @memberof QActive
+bool QActive_postUrgent_(QActive * const me,
+    QEvt const * const e,
+    uint_fast16_t const margin,
+    void const * const sender)
+{
+    #ifndef Q_SPY
+    Q_UNUSED_PAR(sender);
+    #endif
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    Q_REQUIRE_INCRIT(830, QEvt_verify_(e));
+    Q_REQUIRE_INCRIT(832, me->urgent.end != 0U); // urgent lane provided?
+
+    // an urgent event posted to an empty AO queue is delivered directly
+    // to the front of eQueue, as it would be dispatched first anyway
+    bool const toFront = (me->eQueue.frontEvt == (QEvt *)0);
+    uint_fast16_t nFree = toFront
+                          ? (uint_fast16_t)me->eQueue.nFree
+                          : (uint_fast16_t)me->urgent.nFree;
+
+    bool status;
+    if (margin == QF_NO_MARGIN) {
+        if (nFree > 0U) {
+            status = true; // can post
+        }
+        else {
+            status = false; // cannot post
+            Q_ERROR_INCRIT(890); // must be able to post the event
+        }
+    }
+    else if (nFree > margin) {
+        status = true; // can post
+    }
+    else {
+        status = false; // cannot post, but don't assert
+    }
+
+    // is it a mutable event?
+    if (QEvt_getPoolId_(e) != 0U) {
+        QEvt_refCtr_inc_(e); // increment the reference counter
+    }
+
+    if (status) { // can post the event?
+        --nFree; // one free entry just used up
+        if (toFront) {
+            me->eQueue.nFree = (QEQueueCtr)nFree;
+            if (me->eQueue.nMin > nFree) {
+                me->eQueue.nMin = (QEQueueCtr)nFree;
+            }
+        }
+        else {
+            me->urgent.nFree = (uint16_t)nFree;
+            if (me->urgent.nMin > nFree) {
+                me->urgent.nMin = (uint16_t)nFree; // urgent watermark
+            }
+        }
+
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_POST, me->prio)
+            QS_TIME_PRE_();       // timestamp
+            QS_OBJ_PRE_(sender);  // the sender object
+            QS_SIG_PRE_(e->sig);  // the signal of the event
+            QS_OBJ_PRE_(me);      // this active object (recipient)
+            QS_2U8_PRE_(QEvt_getPoolId_(e), e->refCtr_); // poolId & refCtr
+            QS_EQC_PRE_(nFree);   // # free entries
+            QS_EQC_PRE_(toFront ? me->eQueue.nMin : me->urgent.nMin);
+        QS_END_PRE_()
+
+        if (toFront) {
+            me->eQueue.frontEvt = e; // deliver event directly
+            me->urgent.inFront = true; // ahead of later urgent events
+            QACTIVE_STAMP_FRONT_(me);
+            QACTIVE_EQUEUE_SIGNAL_(me); // signal the event queue
+        }
+        else { // the AO is already ready, just append to the urgent lane
+            me->urgent.ring[me->urgent.head] = e;
+            ++me->urgent.head;
+            if (me->urgent.head == me->urgent.end) { // need to wrap head?
+                me->urgent.head = 0U; // wrap around
+            }
+        }
+
+        QF_MEM_APP();
+        QF_CRIT_EXIT();
+    }
+    else { // cannot post the event
+
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_POST_ATTEMPT, me->prio)
+            QS_TIME_PRE_();       // timestamp
+            QS_OBJ_PRE_(sender);  // the sender object
+            QS_SIG_PRE_(e->sig);  // the signal of the event
+            QS_OBJ_PRE_(me);      // this active object (recipient)
+            QS_2U8_PRE_(QEvt_getPoolId_(e), e->refCtr_); // poolId & refCtr
+            QS_EQC_PRE_(nFree);   // # free entries
+            QS_EQC_PRE_(margin);  // margin requested
+        QS_END_PRE_()
+
+        QF_MEM_APP();
+        QF_CRIT_EXIT();
+
+    #if (QF_MAX_EPOOL > 0U)
+        QF_gc(e); // recycle the event to avoid a leak
+    #endif
+    }
+
+    return status;
+}
+
+#endif // def QACTIVE_URGENT_LANE
+//$enddef${QF::QActive::urgentLane} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 //$define${QF::QActive::postLIFO_} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 
 //${QF::QActive::postLIFO_} ..................................................
@@ -269,19 +900,47 @@ void QActive_postLIFO_(QActive * const me,
     }
     #endif
 
-    QEvt const * const frontEvt = me->eQueue.frontEvt;
-    me->eQueue.frontEvt = e; // deliver the event directly to the front
+    QEvt const * frontEvt = me->eQueue.frontEvt;
+    #ifdef QS_RTC_HIST
+    uint32_t frontStamp = me->frontStamp; // stamp of the old front
+    #endif
+    #ifdef QACTIVE_URGENT_LANE
+    if (me->urgent.inFront) { // is the front event an urgent event?
+        // the urgent front event must stay ahead of the later urgent events
+        // (see QActive_get_()), so 'e' goes to the ring-buffer right behind
+        // the front event, which is still ahead of all the other events
+        frontEvt = e;
+    #ifdef QS_RTC_HIST
+        frontStamp = (uint32_t)QS_onGetTime();
+    #endif
+    }
+    else
+    #endif // def QACTIVE_URGENT_LANE
+    {
+        me->eQueue.frontEvt = e; // deliver the event directly to the front
+        QACTIVE_STAMP_FRONT_(me);
+    }
 
     if (frontEvt == (QEvt *)0) { // was the queue empty?
         QACTIVE_EQUEUE_SIGNAL_(me); // signal the event queue
     }
     else { // queue was not empty, leave the event in the ring-buffer
         ++me->eQueue.tail;
+    #ifdef QF_EQUEUE_POW2
+        me->eQueue.ring[me->eQueue.tail
+                        & (QEQueueCtr)(me->eQueue.end - 1U)] = frontEvt;
+    #else
         if (me->eQueue.tail == me->eQueue.end) { // need to wrap the tail?
             me->eQueue.tail = 0U; // wrap around
         }
 
         me->eQueue.ring[me->eQueue.tail] = frontEvt;
+    #endif
+    #ifdef QS_RTC_HIST
+        if (me->stampSto != (uint32_t *)0) {
+            me->stampSto[QACTIVE_SLOT_(me, me->eQueue.tail)] = frontStamp;
+        }
+    #endif
     }
 
     QF_MEM_APP();
@@ -299,17 +958,65 @@ QEvt const * QActive_get_(QActive * const me) {
 
     QACTIVE_EQUEUE_WAIT_(me); // wait for event to arrive directly
 
+    #ifdef QACTIVE_URGENT_LANE
+    // urgent events go ahead of all the events in eQueue, including the
+    // front event, which stays in place (so the AO remains ready), unless
+    // the front event is itself an older urgent event
+    if ((me->urgent.nFree < me->urgent.end) && (!me->urgent.inFront)) {
+        QEvt const * const u = QActive_urgentGet_(me);
+
+    #ifdef QS_RTC_HIST
+        // the urgent lane is not time-stamped (no queue wait recorded)
+        me->rtcWait  = 0U;
+        me->rtcStart = (uint32_t)QS_onGetTime();
+    #endif
+
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_GET, me->prio)
+            QS_TIME_PRE_();       // timestamp
+            QS_SIG_PRE_(u->sig);  // the signal of this event
+            QS_OBJ_PRE_(me);      // this active object
+            QS_2U8_PRE_(QEvt_getPoolId_(u), u->refCtr_); // poolId & refCtr
+            QS_EQC_PRE_(me->urgent.nFree); // # free entries (urgent lane)
+        QS_END_PRE_()
+
+        QF_MEM_APP();
+        QF_CRIT_EXIT();
+
+        return u;
+    }
+    #endif // def QACTIVE_URGENT_LANE
+
     // always remove event from the front
     QEvt const * const e = me->eQueue.frontEvt;
+    #ifdef QACTIVE_URGENT_LANE
+    me->urgent.inFront = false;
+    #endif
     QEQueueCtr const nFree = me->eQueue.nFree + 1U; // get volatile into tmp
     me->eQueue.nFree = nFree; // update the # free
 
+    #ifdef QS_RTC_HIST
+    // start of the RTC step and the queue wait for QS_rtcHistUpdate_()
+    QSTimeCtr const now = QS_onGetTime();
+    me->rtcWait  = (uint32_t)(QSTimeCtr)(now - (QSTimeCtr)me->frontStamp);
+    me->rtcStart = (uint32_t)now;
+    #endif
+
     if (nFree <= me->eQueue.end) { // any events in the ring buffer?
         // remove event from the tail
+    #ifdef QS_RTC_HIST
+        me->frontStamp = (me->stampSto != (uint32_t *)0)
+            ? me->stampSto[QACTIVE_SLOT_(me, me->eQueue.tail)]
+            : (uint32_t)now;
+    #endif
+    #ifdef QF_EQUEUE_POW2
+        me->eQueue.frontEvt = me->eQueue.ring[me->eQueue.tail
+                                  & (QEQueueCtr)(me->eQueue.end - 1U)];
+    #else
         me->eQueue.frontEvt = me->eQueue.ring[me->eQueue.tail];
         if (me->eQueue.tail == 0U) { // need to wrap the tail?
             me->eQueue.tail = me->eQueue.end; // wrap around
         }
+    #endif
         --me->eQueue.tail;
 
         QS_BEGIN_PRE_(QS_QF_ACTIVE_GET, me->prio)
@@ -326,6 +1033,17 @@ QEvt const * QActive_get_(QActive * const me) {
         // all entries in the queue must be free (+1 for fronEvt)
         Q_ASSERT_INCRIT(310, nFree == (me->eQueue.end + 1U));
 
+    #ifdef QACTIVE_URGENT_LANE
+        if (me->urgent.nFree < me->urgent.end) { // urgent events left?
+            // the oldest urgent event becomes the front event, so that
+            // the AO stays ready
+            me->eQueue.frontEvt = QActive_urgentGet_(me);
+            me->eQueue.nFree = nFree - 1U;
+            me->urgent.inFront = true;
+            QACTIVE_STAMP_FRONT_(me);
+        }
+    #endif
+
         QS_BEGIN_PRE_(QS_QF_ACTIVE_GET_LAST, me->prio)
             QS_TIME_PRE_();       // timestamp
             QS_SIG_PRE_(e->sig);  // the signal of this event
@@ -357,6 +1075,25 @@ uint_fast16_t QF_getQueueMin(uint_fast8_t const prio) {
     return min;
 }
 //$enddef${QF::QF-base::getQueueMin} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+//$define${QF::QF-base::getUrgentMin} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+#ifdef QACTIVE_URGENT_LANE
+
+//${QF::QF-base::getUrgentMin} ...............................................
+//! @static @public @memberof QF
+uint_fast16_t QF_getUrgentMin(uint_fast8_t const prio) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(840, (prio <= QF_MAX_ACTIVE)
+                      && (QActive_registry_[prio] != (QActive *)0));
+    uint_fast16_t const min =
+         (uint_fast16_t)QActive_registry_[prio]->urgent.nMin;
+    QF_CRIT_EXIT();
+
+    return min;
+}
+
+#endif // def QACTIVE_URGENT_LANE
+//$enddef${QF::QF-base::getUrgentMin} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 //$define${QF::QTicker} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 
 //${QF::QTicker} .............................................................
@@ -445,6 +1182,7 @@ void QTicker_trig_(
 
         static QEvt const tickEvt = QEVT_INITIALIZER(0);
         me->eQueue.frontEvt = &tickEvt; // deliver event directly
+        QACTIVE_STAMP_FRONT_(me);
         --me->eQueue.nFree; // one less free event
 
         QACTIVE_EQUEUE_SIGNAL_(me); // signal the event queue
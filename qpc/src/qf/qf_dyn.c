@@ -64,6 +64,424 @@ Q_DEFINE_THIS_MODULE("qf_dyn")
 
 //$define${QF::QF-dyn} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 
+#ifdef QF_EPOOL_LUT
+//${QF::QF-dyn::ePoolLut_} ...................................................
+uint8_t QF_ePoolLut_[QF_EPOOL_LUT_SIZE];
+#endif // def QF_EPOOL_LUT
+
+#ifdef QF_EPOOL_MAG
+
+#ifdef Q_SPY
+    #define QF_MAG_QS_ID_(poolId_) ((uint_fast8_t)QS_EP_ID + (poolId_))
+#else
+    #define QF_MAG_QS_ID_(poolId_) 0U
+#endif
+
+//${QF::QF-dyn::magGet_} .....................................................
+//! @static @private @memberof QF
+//! Gets a block of the pool `poolId` (1-based). In the context of an AO
+//! (see QF_MAG_ACT_()) the block comes from the AO's magazine without a
+//! critical section; an empty magazine is first refilled with half of its
+//! capacity in one batch, as long as the pool keeps `margin` free blocks.
+//! Elsewhere (e.g., in ISRs) the block comes straight from the pool.
+static QEvt * QF_magGet_(uint_fast8_t const poolId,
+    uint_fast16_t const margin)
+{
+    QMPool * const pool = &QF_priv_.ePool_[poolId - 1U];
+    QActive * const act = QF_MAG_ACT_();
+    QEvt *e;
+    if (act != (QActive *)0) { // in the context of an AO?
+        void ** const mag = &act->magSto[poolId - 1U][0];
+        uint_fast16_t n = (uint_fast16_t)act->magCtr[poolId - 1U];
+        if (n == 0U) { // magazine empty?
+            n = QMPool_getN(pool, mag, QF_EPOOL_MAG / 2U, margin,
+                             QF_MAG_QS_ID_(poolId));
+        }
+        if (n != 0U) {
+            --n;
+            e = (QEvt *)mag[n]; // LIFO: the most recently freed block
+        }
+        else { // the pool is exhausted (down to the margin)
+            e = (QEvt *)0;
+        }
+        act->magCtr[poolId - 1U] = (uint8_t)n;
+    }
+    else {
+        e = (QEvt *)QMPool_get(pool, margin, QF_MAG_QS_ID_(poolId));
+    }
+    return e;
+}
+
+//${QF::QF-dyn::magPut_} .....................................................
+//! @static @private @memberof QF
+//! Recycles the block `e` of the pool `poolId` (1-based). In the context of
+//! an AO the block goes to the AO's magazine; a full magazine first returns
+//! its older half to the pool in one batch and keeps the recently freed
+//! (cache-hot) blocks. Elsewhere the block goes straight to the pool.
+static void QF_magPut_(uint_fast8_t const poolId,
+    QEvt * const e)
+{
+    QMPool * const pool = &QF_priv_.ePool_[poolId - 1U];
+    QActive * const act = QF_MAG_ACT_();
+    if (act != (QActive *)0) { // in the context of an AO?
+        void ** const mag = &act->magSto[poolId - 1U][0];
+        uint_fast16_t n = (uint_fast16_t)act->magCtr[poolId - 1U];
+        if (n == QF_EPOOL_MAG) { // magazine full?
+            QMPool_putN(pool, mag, QF_EPOOL_MAG / 2U,
+                         QF_MAG_QS_ID_(poolId));
+            for (n = 0U; n < (QF_EPOOL_MAG - (QF_EPOOL_MAG / 2U)); ++n) {
+                mag[n] = mag[n + (QF_EPOOL_MAG / 2U)];
+            }
+        }
+        mag[n] = e;
+        act->magCtr[poolId - 1U] = (uint8_t)(n + 1U);
+    }
+    else {
+        QMPool_put(pool, e, QF_MAG_QS_ID_(poolId));
+    }
+}
+
+//${QF::QF-dyn::magFlush_} ...................................................
+//! @static @private @memberof QF
+void QF_magFlush_(QActive * const act) {
+    for (uint_fast8_t i = 0U; i < QF_priv_.maxPool_; ++i) {
+        if (act->magCtr[i] != 0U) {
+            QMPool_putN(&QF_priv_.ePool_[i], &act->magSto[i][0],
+                         act->magCtr[i], QF_MAG_QS_ID_(i + 1U));
+            act->magCtr[i] = 0U;
+        }
+    }
+}
+
+#endif // def QF_EPOOL_MAG
+
+#ifdef QF_EVT_BUF
+
+// all the buffer pools trace as the event pool #0 (not used otherwise)
+#ifdef Q_SPY
+    #define QF_BUF_QS_ID_ ((uint_fast8_t)QS_EP_ID)
+#else
+    #define QF_BUF_QS_ID_ 0U
+#endif
+
+//${QF::QF-dyn::bufRelease_} .................................................
+//! @static @private @memberof QF
+//! Returns the external buffer of the event `e`, if it has one, to its
+//! buffer pool. Called for the last reference to `e`, before `e` itself
+//! goes back to its event pool.
+static void QF_bufRelease_(QEvt * const e) {
+    if ((e->evtTag_ & QEVT_XBUF) != 0U) { // owns an external buffer?
+        QEvtBuf * const eb = (QEvtBuf *)e;
+        uint_fast8_t const bufPoolId = (uint_fast8_t)eb->bufPoolId_;
+
+        // buffer pool number must be in range
+    #ifdef QF_MPOOL_LOCKFREE
+        QF_ASSERT_LF_(730, (0U < bufPoolId)
+                           && (bufPoolId <= QF_priv_.maxBufPool_));
+    #else
+        Q_ASSERT_ID(730, (0U < bufPoolId)
+                         && (bufPoolId <= QF_priv_.maxBufPool_));
+    #endif
+
+        QF_EPOOL_PUT_(QF_priv_.bufPool_[bufPoolId - 1U], eb->buf,
+                      QF_BUF_QS_ID_);
+        eb->buf = (void *)0;
+        e->evtTag_ &= (uint8_t)~QEVT_XBUF;
+    }
+}
+
+//${QF::QF-dyn::bufPoolInit} .................................................
+//! @static @public @memberof QF
+void QF_bufPoolInit(
+    void * const poolSto,
+    uint_fast32_t const poolSize,
+    uint_fast16_t const bufSize)
+{
+    uint_fast8_t const bufPoolId = QF_priv_.maxBufPool_;
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    Q_REQUIRE_INCRIT(700, bufPoolId < QF_MAX_BUFPOOL);
+    if (bufPoolId > 0U) {
+        Q_REQUIRE_INCRIT(701,
+            QF_EPOOL_EVENT_SIZE_(QF_priv_.bufPool_[bufPoolId - 1U])
+                < bufSize);
+    }
+    QF_priv_.maxBufPool_ = bufPoolId + 1U; // one more buffer pool
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+
+    QF_EPOOL_INIT_(QF_priv_.bufPool_[bufPoolId], poolSto, poolSize,
+                   bufSize);
+
+    #ifdef Q_SPY
+    // generate the object-dictionary entry for the initialized pool
+    {
+        uint8_t obj_name[9] = "BufPool?";
+        obj_name[7] = (uint8_t)((uint8_t)'0' + bufPoolId + 1U);
+        QF_CRIT_ENTRY();
+        QF_MEM_SYS();
+        QS_obj_dict_pre_(&QF_priv_.bufPool_[bufPoolId],
+                         (char const *)obj_name);
+        QF_MEM_APP();
+        QF_CRIT_EXIT();
+    }
+    #endif // Q_SPY
+}
+
+//${QF::QF-dyn::newBuf_} .....................................................
+//! @static @private @memberof QF
+QEvtBuf * QF_newBuf_(
+    uint_fast16_t const evtSize,
+    uint_fast16_t const bufSize,
+    uint_fast16_t const margin,
+    enum_t const sig)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    // precondition:
+    // - the event must be a QEvtBuf (or a subclass of it)
+    Q_REQUIRE_INCRIT(710, evtSize >= (uint_fast16_t)sizeof(QEvtBuf));
+
+    // find the smallest buffer pool that fits the requested size...
+    uint_fast8_t bufPoolId = 0U; // zero-based initially
+    for (; bufPoolId < QF_priv_.maxBufPool_; ++bufPoolId) {
+        if (bufSize <= QF_EPOOL_EVENT_SIZE_(QF_priv_.bufPool_[bufPoolId])) {
+            break;
+        }
+    }
+
+    // precondition:
+    // - cannot run out of registered buffer pools
+    Q_REQUIRE_INCRIT(711, bufPoolId < QF_priv_.maxBufPool_);
+
+    ++bufPoolId; // convert to 1-based bufPoolId
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+
+    // the buffer first, so that a failed allocation leaves no event behind
+    void *buf;
+    QF_EPOOL_GET_(QF_priv_.bufPool_[bufPoolId - 1U], buf,
+                  ((margin != QF_NO_MARGIN) ? margin : 0U),
+                  QF_BUF_QS_ID_);
+
+    QEvtBuf *e = (QEvtBuf *)0;
+    if (buf != (void *)0) { // buffer allocated?
+        e = (QEvtBuf *)QF_newX_(evtSize, margin, sig);
+        if (e != (QEvtBuf *)0) {
+            e->buf        = buf;
+            e->size       = bufSize;
+            e->bufPoolId_ = (uint8_t)bufPoolId;
+            e->super.evtTag_ |= (uint8_t)QEVT_XBUF;
+        }
+        else { // event not allocated (margin), give the buffer back
+            QF_EPOOL_PUT_(QF_priv_.bufPool_[bufPoolId - 1U], buf,
+                          QF_BUF_QS_ID_);
+        }
+    }
+    else {
+        QF_CRIT_ENTRY();
+        // This assertion means that the buffer allocation failed,
+        // and this failure cannot be tolerated.
+        Q_ASSERT_INCRIT(720, margin != QF_NO_MARGIN);
+        QF_CRIT_EXIT();
+    }
+    return e;
+}
+
+#endif // def QF_EVT_BUF
+
+#ifdef QF_EPOOL_TRACK
+
+#ifndef QF_EPOOL_TRACK_TIME
+// time stamp of the tracked allocations: the QS time stamp with Q_SPY,
+// otherwise none (define QF_EPOOL_TRACK_TIME() for another clock)
+#ifdef Q_SPY
+    #define QF_EPOOL_TRACK_TIME() ((uint32_t)QS_onGetTime())
+#else
+    #define QF_EPOOL_TRACK_TIME() 0U
+#endif
+#endif // ndef QF_EPOOL_TRACK_TIME
+
+// allocation record of the block 'e_' of the tracked pool 'poolId_'
+#define QF_SITE_OF_(poolId_, e_) \
+    (&QF_priv_.siteSto_[(poolId_) - 1U][ \
+        ((uint8_t const *)(e_) \
+         - (uint8_t const *)QF_priv_.ePool_[(poolId_) - 1U].start) \
+        / QF_priv_.ePool_[(poolId_) - 1U].blockSize])
+
+// the site of the allocations not made through Q_NEW...()
+static char const QF_noSite_[] = "?";
+
+//${QF::QF-dyn::siteNew_} ....................................................
+//! @static @private @memberof QF
+//! Fills the allocation record of the event `e` just allocated from the
+//! pool `poolId` (1-based), if the pool is tracked.
+//!
+//! @note
+//! The records are written without a critical section, because the block
+//! belongs to the caller alone between the allocation and the first post
+//! (and between the last reference and the recycling). The `file` goes
+//! last when the record is filled and first when it is cleared, so the
+//! reports (which read the records in critical sections) never take
+//! a free block for an outstanding one.
+static inline void QF_siteNew_(uint_fast8_t const poolId,
+    QEvt const * const e)
+{
+    if (QF_priv_.siteSto_[poolId - 1U] != (QEvtSite *)0) {
+        QEvtSite * const site = QF_SITE_OF_(poolId, e);
+        site->time = QF_EPOOL_TRACK_TIME();
+        site->line = 0U;
+        site->sig  = e->sig;
+        site->file = &QF_noSite_[0];
+    }
+}
+
+//${QF::QF-dyn::siteFree_} ...................................................
+//! @static @private @memberof QF
+//! Clears the allocation record of the event `e` being recycled.
+static inline void QF_siteFree_(uint_fast8_t const poolId,
+    QEvt const * const e)
+{
+    if (QF_priv_.siteSto_[poolId - 1U] != (QEvtSite *)0) {
+        QF_SITE_OF_(poolId, e)->file = (char const *)0;
+    }
+}
+
+//${QF::QF-dyn::evtSite_} ....................................................
+//! @static @private @memberof QF
+uint_fast16_t QF_evtSite_(
+    QEvt * const * const evts,
+    uint_fast16_t const n,
+    char const * const file,
+    int_t const line)
+{
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        uint_fast8_t const poolId = QEvt_getPoolId_(evts[i]);
+        if ((poolId != 0U)
+            && (QF_priv_.siteSto_[poolId - 1U] != (QEvtSite *)0))
+        {
+            QEvtSite * const site = QF_SITE_OF_(poolId, evts[i]);
+            site->line = (uint16_t)line;
+            site->file = file;
+        }
+    }
+    return n;
+}
+
+//${QF::QF-dyn::poolSetSiteSto} ..............................................
+//! @static @public @memberof QF
+void QF_poolSetSiteSto(
+    uint_fast8_t const poolId,
+    QEvtSite * const siteSto,
+    uint_fast16_t const siteLen)
+{
+    // the table is not in use yet, so it is cleared outside of the
+    // critical section
+    for (uint_fast16_t i = 0U; i < siteLen; ++i) {
+        siteSto[i].file = (char const *)0;
+    }
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    // the pool must be initialized and the table must provide one
+    // record per block of the pool
+    Q_REQUIRE_INCRIT(1000, (0U < poolId) && (poolId <= QF_priv_.maxPool_)
+        && (siteSto != (QEvtSite *)0)
+        && (siteLen >= (uint_fast16_t)QF_priv_.ePool_[poolId - 1U].nTot));
+
+    QF_priv_.siteSto_[poolId - 1U] = siteSto;
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+}
+
+//${QF::QF-dyn::poolForEachLive} .............................................
+//! @static @public @memberof QF
+uint_fast16_t QF_poolForEachLive(
+    uint_fast8_t const poolId,
+    void (* const visit)(uint_fast8_t poolId, uint_fast16_t block,
+                         QEvtSite const * site))
+{
+    Q_REQUIRE_ID(1010, poolId <= QF_priv_.maxPool_);
+
+    uint_fast8_t const first = (poolId != 0U) ? poolId : 1U;
+    uint_fast8_t const last  = (poolId != 0U) ? poolId : QF_priv_.maxPool_;
+    uint_fast16_t nLive = 0U;
+    QF_CRIT_STAT
+    for (uint_fast8_t p = first; p <= last; ++p) {
+        QEvtSite const * const sto = QF_priv_.siteSto_[p - 1U];
+        uint_fast16_t const nTot
+            = (sto != (QEvtSite *)0)
+              ? (uint_fast16_t)QF_priv_.ePool_[p - 1U].nTot
+              : 0U;
+        for (uint_fast16_t b = 0U; b < nTot; ++b) {
+            // take a snapshot of the record
+            QF_CRIT_ENTRY();
+            QF_MEM_SYS();
+            QEvtSite const site = sto[b];
+            QF_MEM_APP();
+            QF_CRIT_EXIT();
+
+            if (site.file != (char const *)0) { // outstanding event?
+                ++nLive;
+                if (visit != (void (*)(uint_fast8_t, uint_fast16_t,
+                                       QEvtSite const *))0)
+                {
+                    (*visit)(p, b, &site);
+                }
+            }
+        }
+    }
+    return nLive;
+}
+
+#ifdef Q_SPY
+//${QF::QF-dyn::siteReport_} .................................................
+//! @static @private @memberof QF
+//! one QS_EPOOL_TRACK_REC record per outstanding event:
+//! kind 0, poolId, block #, signal, time stamp, file, line
+static void QF_siteReport_(uint_fast8_t const poolId,
+    uint_fast16_t const block,
+    QEvtSite const * const site)
+{
+    QS_BEGIN_ID(QS_EPOOL_TRACK_REC, 0U)
+        QS_U8(0, 0U);
+        QS_U8(0, poolId);
+        QS_U16(0, block);
+        QS_SIG(site->sig, (void *)0);
+        QS_U32(0, site->time);
+        QS_STR(site->file);
+        QS_U16(0, site->line);
+    QS_END()
+    QS_FLUSH(); // don't overrun the QS buffer with the report
+}
+
+//${QF::QF-dyn::poolTrackReport_} ............................................
+//! @static @private @memberof QF
+void QF_poolTrackReport_(uint_fast8_t const poolId) {
+    uint_fast16_t const nLive = QF_poolForEachLive(poolId, &QF_siteReport_);
+
+    // the closing record: kind 1, poolId, # outstanding events
+    QS_BEGIN_ID(QS_EPOOL_TRACK_REC, 0U)
+        QS_U8(0, 1U);
+        QS_U8(0, poolId);
+        QS_U16(0, nLive);
+    QS_END()
+    QS_FLUSH();
+}
+#endif // def Q_SPY
+
+#endif // def QF_EPOOL_TRACK
+
 //${QF::QF-dyn::poolInit} ....................................................
 //! @static @public @memberof QF
 void QF_poolInit(
@@ -91,6 +509,24 @@ void QF_poolInit(
     // perform the port-dependent initialization of the event-pool
     QF_EPOOL_INIT_(QF_priv_.ePool_[poolId], poolSto, poolSize, evtSize);
 
+    #ifdef QF_EPOOL_LUT
+    // assign the new pool to all the size classes that it fits and that
+    // no smaller pool fits. The first pool initializes the whole table.
+    {
+        uint_fast16_t const blockSize =
+            QF_EPOOL_EVENT_SIZE_(QF_priv_.ePool_[poolId]);
+        for (uint_fast16_t c = 0U; c < QF_EPOOL_LUT_SIZE; ++c) {
+            if ((poolId == 0U) || (QF_ePoolLut_[c] == 0U)) {
+                // the largest event size in the class 'c'
+                uint_fast32_t const maxSize =
+                    ((uint_fast32_t)c + 1U) << QF_EPOOL_LUT_SHIFT;
+                QF_ePoolLut_[c] = (maxSize <= blockSize)
+                                  ? (uint8_t)(poolId + 1U) : 0U;
+            }
+        }
+    }
+    #endif // def QF_EPOOL_LUT
+
     #ifdef Q_SPY
     // generate the object-dictionary entry for the initialized pool
     {
@@ -129,37 +565,81 @@ uint_fast16_t QF_getPoolMin(uint_fast8_t const poolId) {
     return min;
 }
 
+//${QF::QF-dyn::poolFit_} ....................................................
+//! @static @private @memberof QF
+//! Zero-based id of the smallest event pool that fits `evtSize`, or
+//! QF_priv_.maxPool_ if none does. A non-zero `lutPoolId` (1-based, see
+//! QF_EPOOL_ID_()) already resolves the pool.
+static inline uint_fast8_t QF_poolFit_(uint_fast8_t const lutPoolId,
+    uint_fast16_t const evtSize)
+{
+    uint_fast8_t poolId = 0U;
+    if (lutPoolId != 0U) { // pool resolved by the lookup table?
+        poolId = lutPoolId - 1U;
+    }
+    else {
+        // find the pool id that fits the requested event size...
+        for (; poolId < QF_priv_.maxPool_; ++poolId) {
+            if (evtSize <= QF_EPOOL_EVENT_SIZE_(QF_priv_.ePool_[poolId])) {
+                break;
+            }
+        }
+    }
+    return poolId;
+}
+
 //${QF::QF-dyn::newX_} .......................................................
 //! @static @private @memberof QF
 QEvt * QF_newX_(
     uint_fast16_t const evtSize,
     uint_fast16_t const margin,
     enum_t const sig)
+{
+    #ifdef QF_EPOOL_LUT
+    return QF_newP_(QF_EPOOL_ID_(evtSize), evtSize, margin, sig);
+    #else
+    return QF_newP_(0U, evtSize, margin, sig);
+    #endif
+}
+
+//${QF::QF-dyn::newP_} .......................................................
+//! @static @private @memberof QF
+QEvt * QF_newP_(
+    uint_fast8_t const lutPoolId,
+    uint_fast16_t const evtSize,
+    uint_fast16_t const margin,
+    enum_t const sig)
 {
     QF_CRIT_STAT
+    #ifndef QF_MPOOL_LOCKFREE
     QF_CRIT_ENTRY();
     QF_MEM_SYS();
+    #endif
+    // NOTE: with QF_MPOOL_LOCKFREE the pools are selected without the
+    // critical section, because they don't change after QF_poolInit()
 
-    // find the pool id that fits the requested event size...
-    uint_fast8_t poolId = 0U; // zero-based poolId initially
-    for (; poolId < QF_priv_.maxPool_; ++poolId) {
-        if (evtSize <= QF_EPOOL_EVENT_SIZE_(QF_priv_.ePool_[poolId])) {
-            break;
-        }
-    }
+    uint_fast8_t poolId = QF_poolFit_(lutPoolId, evtSize); // zero-based
 
     // precondition:
     // - cannot run out of registered pools
+    #ifdef QF_MPOOL_LOCKFREE
+    QF_ASSERT_LF_(300, poolId < QF_priv_.maxPool_);
+    #else
     Q_REQUIRE_INCRIT(300, poolId < QF_priv_.maxPool_);
+    #endif
 
     ++poolId; // convert to 1-based poolId
 
+    #ifndef QF_MPOOL_LOCKFREE
     QF_MEM_APP();
     QF_CRIT_EXIT();
+    #endif
 
     // get event e (port-dependent)...
     QEvt *e;
-    #ifdef Q_SPY
+    #ifdef QF_EPOOL_MAG
+    e = QF_magGet_(poolId, ((margin != QF_NO_MARGIN) ? margin : 0U));
+    #elif (defined Q_SPY)
     QF_EPOOL_GET_(QF_priv_.ePool_[poolId - 1U], e,
                   ((margin != QF_NO_MARGIN) ? margin : 0U),
                   (uint_fast8_t)QS_EP_ID + poolId);
@@ -172,6 +652,9 @@ QEvt * QF_newX_(
         e->sig     = (QSignal)sig; // set the signal
         e->refCtr_ = 0U; // initialize the reference counter to 0
         e->evtTag_ = (uint8_t)(QEVT_MARKER | poolId);
+    #ifdef QF_EPOOL_TRACK
+        QF_siteNew_(poolId, e);
+    #endif
 
         QS_CRIT_ENTRY();
         QS_MEM_SYS();
@@ -185,6 +668,11 @@ QEvt * QF_newX_(
         QS_CRIT_EXIT();
     }
     else { // event was not allocated
+    #if (defined QF_EPOOL_TRACK) && (defined Q_SPY)
+        if (margin == QF_NO_MARGIN) { // about to fail?
+            QF_poolTrackReport_(poolId); // report who holds the events
+        }
+    #endif
 
         QF_CRIT_ENTRY();
         // This assertion means that the event allocation failed,
@@ -212,6 +700,59 @@ QEvt * QF_newX_(
 //${QF::QF-dyn::gc} ..........................................................
 //! @static @public @memberof QF
 void QF_gc(QEvt const * const e) {
+    #ifdef QF_MPOOL_LOCKFREE
+    // lock-free variant: the references are counted with atomics and the
+    // pools are lock-free, so only the QS records need a critical section
+    QF_ASSERT_LF_(402, QEvt_verify_(e));
+
+    uint_fast8_t const poolId = QEvt_getPoolId_(e);
+
+    if (poolId != 0U) { // is it a pool event (mutable)?
+        // an event that was never posted (refCtr_ == 0) has no other
+        // references; otherwise the last reference brings refCtr_ to 0
+        uint8_t const refCtr
+            = __atomic_load_n(&e->refCtr_, __ATOMIC_ACQUIRE);
+        bool const isLast = (refCtr == 0U)
+            || (__atomic_fetch_sub(&((QEvt *)e)->refCtr_, 1U,
+                                   __ATOMIC_ACQ_REL) == 1U);
+
+        QS_CRIT_STAT
+        QS_CRIT_ENTRY();
+        QS_MEM_SYS();
+        QS_BEGIN_PRE_(isLast ? QS_QF_GC : QS_QF_GC_ATTEMPT,
+                (uint_fast8_t)QS_EP_ID + poolId)
+            QS_TIME_PRE_();       // timestamp
+            QS_SIG_PRE_(e->sig);  // the signal of the event
+            QS_2U8_PRE_(poolId, refCtr); // poolId & refCtr
+        QS_END_PRE_()
+        QS_MEM_APP();
+        QS_CRIT_EXIT();
+
+        if (isLast) { // this is the last reference to this event
+            // pool number must be in range
+            QF_ASSERT_LF_(410, (poolId <= QF_priv_.maxPool_)
+                               && (poolId <= QF_MAX_EPOOL));
+
+            // NOTE: casting 'const' away is legit because it's a pool event
+    #ifdef QF_EPOOL_TRACK
+            QF_siteFree_(poolId, e);
+    #endif
+    #ifdef QF_EVT_BUF
+            QF_bufRelease_((QEvt *)e); // the external buffer, if any
+    #endif
+    #ifdef QF_EPOOL_MAG
+            QF_magPut_(poolId, (QEvt *)e);
+    #elif (defined Q_SPY)
+            QF_EPOOL_PUT_(QF_priv_.ePool_[poolId - 1U],
+                (QEvt *)e,
+                (uint_fast8_t)QS_EP_ID + poolId);
+    #else
+            QF_EPOOL_PUT_(QF_priv_.ePool_[poolId - 1U],
+                (QEvt *)e, 0U);
+    #endif
+        }
+    }
+    #else
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
     Q_REQUIRE_INCRIT(402, QEvt_verify_(e));
@@ -251,7 +792,15 @@ void QF_gc(QEvt const * const e) {
             QF_CRIT_EXIT();
 
             // NOTE: casting 'const' away is legit because it's a pool event
-    #ifdef Q_SPY
+    #ifdef QF_EPOOL_TRACK
+            QF_siteFree_(poolId, e);
+    #endif
+    #ifdef QF_EVT_BUF
+            QF_bufRelease_((QEvt *)e); // the external buffer, if any
+    #endif
+    #ifdef QF_EPOOL_MAG
+            QF_magPut_(poolId, (QEvt *)e);
+    #elif (defined Q_SPY)
             QF_EPOOL_PUT_(QF_priv_.ePool_[poolId - 1U],
                 (QEvt *)e,
                 (uint_fast8_t)QS_EP_ID + poolId);
@@ -264,6 +813,217 @@ void QF_gc(QEvt const * const e) {
     else {
         QF_CRIT_EXIT();
     }
+    #endif // def QF_MPOOL_LOCKFREE
+}
+
+//${QF::QF-dyn::newN} ........................................................
+//! @static @public @memberof QF
+uint_fast16_t QF_newN(
+    QEvt ** const evts,
+    uint_fast16_t const n,
+    uint_fast16_t const evtSize,
+    uint_fast16_t const margin,
+    enum_t const sig)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    #ifdef QF_EPOOL_LUT
+    uint_fast8_t poolId = QF_poolFit_(QF_EPOOL_ID_(evtSize), evtSize);
+    #else
+    uint_fast8_t poolId = QF_poolFit_(0U, evtSize);
+    #endif
+
+    // precondition:
+    // - cannot run out of registered pools
+    Q_REQUIRE_INCRIT(800, poolId < QF_priv_.maxPool_);
+
+    ++poolId; // convert to 1-based poolId
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+
+    // all the blocks at once (bypassing the magazines of QF_EPOOL_MAG)
+    #ifdef Q_SPY
+    uint_fast16_t const m = QMPool_getN(&QF_priv_.ePool_[poolId - 1U],
+        (void **)evts, n, ((margin != QF_NO_MARGIN) ? margin : 0U),
+        (uint_fast8_t)QS_EP_ID + poolId);
+    #else
+    uint_fast16_t const m = QMPool_getN(&QF_priv_.ePool_[poolId - 1U],
+        (void **)evts, n, ((margin != QF_NO_MARGIN) ? margin : 0U), 0U);
+    #endif
+
+    for (uint_fast16_t i = 0U; i < m; ++i) {
+        evts[i]->sig     = (QSignal)sig;
+        evts[i]->refCtr_ = 0U;
+        evts[i]->evtTag_ = (uint8_t)(QEVT_MARKER | poolId);
+    #ifdef QF_EPOOL_TRACK
+        QF_siteNew_(poolId, evts[i]);
+    #endif
+    }
+
+    #ifdef Q_SPY
+    QS_CRIT_ENTRY();
+    QS_MEM_SYS();
+    for (uint_fast16_t i = 0U; i < m; ++i) {
+        QS_BEGIN_PRE_(QS_QF_NEW,
+                (uint_fast8_t)QS_EP_ID + poolId)
+            QS_TIME_PRE_();        // timestamp
+            QS_EVS_PRE_(evtSize);  // the size of the event
+            QS_SIG_PRE_(sig);      // the signal of the event
+        QS_END_PRE_()
+    }
+    QS_MEM_APP();
+    QS_CRIT_EXIT();
+    #endif // Q_SPY
+
+    if (m < n) { // not all the events allocated?
+    #if (defined QF_EPOOL_TRACK) && (defined Q_SPY)
+        if (margin == QF_NO_MARGIN) { // about to fail?
+            QF_poolTrackReport_(poolId); // report who holds the events
+        }
+    #endif
+        QF_CRIT_ENTRY();
+        // This assertion means that the allocation of the batch failed,
+        // and this failure cannot be tolerated (see QF_newP_()).
+        Q_ASSERT_INCRIT(820, margin != QF_NO_MARGIN);
+
+        QS_MEM_SYS();
+        QS_BEGIN_PRE_(QS_QF_NEW_ATTEMPT,
+                (uint_fast8_t)QS_EP_ID + poolId)
+            QS_TIME_PRE_();        // timestamp
+            QS_EVS_PRE_(evtSize);  // the size of the event
+            QS_SIG_PRE_(sig);      // the signal of the event
+        QS_END_PRE_()
+        QS_MEM_APP();
+
+        QF_CRIT_EXIT();
+    }
+
+    return m;
+}
+
+//${QF::QF-dyn::gcN} .........................................................
+//! @static @public @memberof QF
+void QF_gcN(
+    QEvt const ** const evts,
+    uint_fast16_t const n)
+{
+    uint_fast16_t k = 0U; // # events to recycle (moved to the front)
+
+    #ifdef QF_MPOOL_LOCKFREE
+    QF_ASSERT_LF_(900, (n != 0U) && QEvt_verify_(evts[0]));
+
+    uint_fast8_t const poolId = QEvt_getPoolId_(evts[0]);
+
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        QEvt const * const e = evts[i];
+
+        // all the events must come from the same pool
+        QF_ASSERT_LF_(902, QEvt_verify_(e)
+                           && (QEvt_getPoolId_(e) == poolId));
+
+        if (poolId != 0U) { // a pool event (mutable)?
+            // see QF_gc()
+            uint8_t const refCtr
+                = __atomic_load_n(&e->refCtr_, __ATOMIC_ACQUIRE);
+            bool const isLast = (refCtr == 0U)
+                || (__atomic_fetch_sub(&((QEvt *)e)->refCtr_, 1U,
+                                       __ATOMIC_ACQ_REL) == 1U);
+
+            QS_CRIT_STAT
+            QS_CRIT_ENTRY();
+            QS_MEM_SYS();
+            QS_BEGIN_PRE_(isLast ? QS_QF_GC : QS_QF_GC_ATTEMPT,
+                    (uint_fast8_t)QS_EP_ID + poolId)
+                QS_TIME_PRE_();       // timestamp
+                QS_SIG_PRE_(e->sig);  // the signal of the event
+                QS_2U8_PRE_(poolId, refCtr); // poolId & refCtr
+            QS_END_PRE_()
+            QS_MEM_APP();
+            QS_CRIT_EXIT();
+
+            if (isLast) {
+                evts[k] = e;
+                ++k;
+            }
+        }
+    }
+
+    // pool number must be in range
+    QF_ASSERT_LF_(910, (poolId <= QF_priv_.maxPool_)
+                       && (poolId <= QF_MAX_EPOOL));
+    #else
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(900, (n != 0U) && QEvt_verify_(evts[0]));
+
+    uint_fast8_t const poolId = QEvt_getPoolId_(evts[0]);
+
+    QF_MEM_SYS();
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        QEvt const * const e = evts[i];
+
+        // all the events must come from the same pool
+        Q_REQUIRE_INCRIT(902, QEvt_verify_(e)
+                              && (QEvt_getPoolId_(e) == poolId));
+
+        if (poolId == 0U) { // an immutable event?
+            // nothing to do
+        }
+        else if (e->refCtr_ > 1U) { // isn't this the last reference?
+
+            QS_BEGIN_PRE_(QS_QF_GC_ATTEMPT,
+                    (uint_fast8_t)QS_EP_ID + poolId)
+                QS_TIME_PRE_();       // timestamp
+                QS_SIG_PRE_(e->sig);  // the signal of the event
+                QS_2U8_PRE_(poolId, e->refCtr_); // poolId & refCtr
+            QS_END_PRE_()
+
+            QEvt_refCtr_dec_(e); // decrement the ref counter
+        }
+        else { // this is the last reference to this event, recycle it
+
+            QS_BEGIN_PRE_(QS_QF_GC,
+                    (uint_fast8_t)QS_EP_ID + poolId)
+                QS_TIME_PRE_();       // timestamp
+                QS_SIG_PRE_(e->sig);  // the signal of the event
+                QS_2U8_PRE_(poolId, e->refCtr_); // poolId & refCtr
+            QS_END_PRE_()
+
+            evts[k] = e;
+            ++k;
+        }
+    }
+
+    // pool number must be in range
+    Q_ASSERT_INCRIT(910, (poolId <= QF_priv_.maxPool_)
+                          && (poolId <= QF_MAX_EPOOL));
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+    #endif // def QF_MPOOL_LOCKFREE
+
+    if (k != 0U) { // any events to recycle?
+    #ifdef QF_EPOOL_TRACK
+        for (uint_fast16_t i = 0U; i < k; ++i) {
+            QF_siteFree_(poolId, evts[i]);
+        }
+    #endif
+    #ifdef QF_EVT_BUF
+        for (uint_fast16_t i = 0U; i < k; ++i) {
+            QF_bufRelease_((QEvt *)evts[i]); // the external buffer, if any
+        }
+    #endif
+        // NOTE: casting 'const' away is legit because these are pool events
+    #ifdef Q_SPY
+        QMPool_putN(&QF_priv_.ePool_[poolId - 1U], (void * const *)evts, k,
+                    (uint_fast8_t)QS_EP_ID + poolId);
+    #else
+        QMPool_putN(&QF_priv_.ePool_[poolId - 1U], (void * const *)evts, k,
+                    0U);
+    #endif
+    }
 }
 
 //${QF::QF-dyn::newRef_} .....................................................
@@ -79,7 +79,13 @@ void QMPool_init(QMPool * const me,
             && (poolSize >= (uint_fast32_t)sizeof(QFreeBlock))
             && ((uint_fast16_t)(blockSize + sizeof(QFreeBlock)) > blockSize));
 
+    #ifdef QF_MPOOL_LOCKFREE
+    // the tagged head holds 32-bit offsets of the blocks
+    Q_REQUIRE_INCRIT(120, poolSize <= (uint_fast32_t)0xFFFFFFFFU);
+    me->free_head = 1U; // the first block (offset 0), modification count 0
+    #else
     me->free_head = (QFreeBlock *)poolSto;
+    #endif
 
     // find # free blocks in a memory block, NO DIVISION
     me->blockSize = (QMPoolSize)sizeof(QFreeBlock);
@@ -93,7 +99,7 @@ void QMPool_init(QMPool * const me,
     Q_ASSERT_INCRIT(110, poolSize >= me->blockSize);
 
     // start at the head of the free list
-    QFreeBlock *fb = me->free_head;
+    QFreeBlock *fb = (QFreeBlock *)poolSto;
     me->nTot = 1U; // the last block already in the list
 
     // chain all blocks together in a free-list...
@@ -123,6 +129,7 @@ void QMPool_init(QMPool * const me,
     QF_CRIT_EXIT();
 }
 
+#ifndef QF_MPOOL_LOCKFREE
 //${QF::QMPool::get} .........................................................
 //! @public @memberof QMPool
 void * QMPool_get(QMPool * const me,
@@ -239,4 +246,346 @@ void QMPool_put(QMPool * const me,
     QF_MEM_APP();
     QF_CRIT_EXIT();
 }
+
+#else // QF_MPOOL_LOCKFREE
+
+//! @cond INTERNAL
+
+// adds one to the modification count in the upper half of the tagged head
+#define QMPOOL_TAG_INC_ ((uint64_t)1U << 32U)
+
+//${QF::QMPool::block_} ......................................................
+//! @private @memberof QMPool
+//! The free block of a tagged head (NULL for the empty list).
+static inline QFreeBlock * QMPool_block_(QMPool const * const me,
+    uint64_t const head)
+{
+    uint32_t const off = (uint32_t)head;
+    return (off != 0U)
+        ? (QFreeBlock *)((uint8_t *)me->start + (off - 1U))
+        : (QFreeBlock *)0;
+}
+
+//${QF::QMPool::head_} .......................................................
+//! @private @memberof QMPool
+//! The tagged head with the block fb, one modification after the head.
+static inline uint64_t QMPool_head_(QMPool const * const me,
+    uint64_t const head,
+    QFreeBlock const * const fb)
+{
+    uint64_t const off = (fb != (QFreeBlock *)0)
+        ? ((uint64_t)((uint8_t const *)fb - (uint8_t const *)me->start) + 1U)
+        : 0U;
+    return ((head & ~(uint64_t)0xFFFFFFFFU) + QMPOOL_TAG_INC_) | off;
+}
+
+//! @endcond
+
+//${QF::QMPool::get} .........................................................
+//! @public @memberof QMPool
+//! Lock-free variant (QF_MPOOL_LOCKFREE): first reserves a block in nFree,
+//! which guarantees a block in the list, and then pops the head of the
+//! list with one CAS of the tagged head (a Treiber stack, in which the
+//! modification count defeats ABA). The block links read before the CAS
+//! might be stale, so the integrity checks apply only after a successful
+//! CAS. nMin is kept with relaxed atomics. Unlike the locked variant, it
+//! cannot check that the last free block links to NULL, because other
+//! threads might return blocks at the same time.
+void * QMPool_get(QMPool * const me,
+    uint_fast16_t const margin,
+    uint_fast8_t const qs_id)
+{
+    #ifndef Q_SPY
+    Q_UNUSED_PAR(qs_id);
+    #endif
+
+    // reserve a free block, if there are more than the requested margin
+    QMPoolCtr nFree = __atomic_load_n(&me->nFree, __ATOMIC_RELAXED);
+    bool reserved = false;
+    while ((!reserved) && (nFree > (QMPoolCtr)margin)) {
+        reserved = __atomic_compare_exchange_n(&me->nFree, &nFree,
+            (QMPoolCtr)(nFree - 1U), true,
+            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+    }
+
+    QFreeBlock *fb = (QFreeBlock *)0;
+    if (reserved) {
+        --nFree; // the # free blocks left by this reservation
+
+        // is the # free blocks the new minimum so far?
+        QMPoolCtr nMin = __atomic_load_n(&me->nMin, __ATOMIC_RELAXED);
+        while ((nMin > nFree)
+               && (!__atomic_compare_exchange_n(&me->nMin, &nMin, nFree,
+                       true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+        {
+        }
+
+        // pop the head of the free list
+        uint64_t head = __atomic_load_n(&me->free_head, __ATOMIC_ACQUIRE);
+        QFreeBlock *fb_next;
+        uintptr_t fb_next_dis = 0U;
+        do {
+            fb = QMPool_block_(me, head);
+
+            // the reservation guarantees a free block
+            QF_ASSERT_LF_(300, fb != (QFreeBlock *)0);
+
+            fb_next = __atomic_load_n(&fb->next, __ATOMIC_RELAXED);
+        #ifndef Q_UNSAFE
+            fb_next_dis = __atomic_load_n(&fb->next_dis, __ATOMIC_RELAXED);
+        #endif
+        } while (!__atomic_compare_exchange_n(&me->free_head, &head,
+                     QMPool_head_(me, head, fb_next), true,
+                     __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+
+        // the free block must have integrity (duplicate inverse storage)
+        QF_ASSERT_LF_(302,
+            Q_UINTPTR_CAST_(fb_next) == (uintptr_t)~fb_next_dis);
+        #ifdef Q_UNSAFE
+        Q_UNUSED_PAR(fb_next_dis);
+        #endif
+
+        // the next free block must be in range, see the locked variant
+        QF_ASSERT_LF_(330, (fb_next == (QFreeBlock *)0)
+            || ((me->start <= fb_next) && (fb_next <= me->end)));
+
+        QS_CRIT_STAT
+        QS_CRIT_ENTRY();
+        QS_MEM_SYS();
+        QS_BEGIN_PRE_(QS_QF_MPOOL_GET, qs_id)
+            QS_TIME_PRE_();         // timestamp
+            QS_OBJ_PRE_(me);        // this memory pool
+            QS_MPC_PRE_(nFree);     // # of free blocks in the pool
+            QS_MPC_PRE_(me->nMin);  // min # free blocks ever in the pool
+        QS_END_PRE_()
+        QS_MEM_APP();
+        QS_CRIT_EXIT();
+    }
+    else { // don't have enough free blocks at this point
+        QS_CRIT_STAT
+        QS_CRIT_ENTRY();
+        QS_MEM_SYS();
+        QS_BEGIN_PRE_(QS_QF_MPOOL_GET_ATTEMPT, qs_id)
+            QS_TIME_PRE_();         // timestamp
+            QS_OBJ_PRE_(me);        // this memory pool
+            QS_MPC_PRE_(nFree);     // # of free blocks in the pool
+            QS_MPC_PRE_(margin);    // the requested margin
+        QS_END_PRE_()
+        QS_MEM_APP();
+        QS_CRIT_EXIT();
+    }
+
+    return fb; // return the block or NULL pointer to the caller
+}
+
+//${QF::QMPool::put} .........................................................
+//! @public @memberof QMPool
+//! Lock-free variant (QF_MPOOL_LOCKFREE): pushes the block with one CAS of
+//! the tagged head and only then counts it in nFree, so that a reservation
+//! in QMPool_get() always finds a block in the list.
+void QMPool_put(QMPool * const me,
+    void * const block,
+    uint_fast8_t const qs_id)
+{
+    #ifndef Q_SPY
+    Q_UNUSED_PAR(qs_id);
+    #endif
+
+    QFreeBlock * const fb = (QFreeBlock *)block;
+
+    QF_ASSERT_LF_(200,
+        (__atomic_load_n(&me->nFree, __ATOMIC_RELAXED) < me->nTot)
+        && (me->start <= fb) && (fb <= me->end));
+
+    uint64_t head = __atomic_load_n(&me->free_head, __ATOMIC_RELAXED);
+    QFreeBlock *next;
+    do {
+        next = QMPool_block_(me, head);
+        // a concurrent QMPool_get() might still read the old links
+        __atomic_store_n(&fb->next, next, __ATOMIC_RELAXED);
+    #ifndef Q_UNSAFE
+        __atomic_store_n(&fb->next_dis,
+            (uintptr_t)(~Q_UINTPTR_CAST_(next)), __ATOMIC_RELAXED);
+    #endif
+    } while (!__atomic_compare_exchange_n(&me->free_head, &head,
+                 QMPool_head_(me, head, fb), true,
+                 __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    // one more free block in this pool
+    QMPoolCtr const nFree
+        = __atomic_add_fetch(&me->nFree, 1U, __ATOMIC_RELEASE);
+
+    QS_CRIT_STAT
+    QS_CRIT_ENTRY();
+    QS_MEM_SYS();
+    QS_BEGIN_PRE_(QS_QF_MPOOL_PUT, qs_id)
+        QS_TIME_PRE_();         // timestamp
+        QS_OBJ_PRE_(me);        // this memory pool
+        QS_MPC_PRE_(nFree);     // the # free blocks in the pool
+    QS_END_PRE_()
+    QS_MEM_APP();
+    QS_CRIT_EXIT();
+    #ifndef Q_SPY
+    Q_UNUSED_PAR(nFree);
+    #endif
+}
+
+#endif // QF_MPOOL_LOCKFREE
+
+#ifndef QF_MPOOL_LOCKFREE
+//${QF::QMPool::getN} ........................................................
+//! @public @memberof QMPool
+//! Gets up to n blocks in one critical section, as long as the pool keeps
+//! more than `margin` free blocks, and returns the number of blocks stored
+//! in `blocks[]`. Every block is checked as in QMPool_get(); one QS record
+//! reports the whole batch.
+uint_fast16_t QMPool_getN(QMPool * const me,
+    void ** const blocks,
+    uint_fast16_t const n,
+    uint_fast16_t const margin,
+    uint_fast8_t const qs_id)
+{
+    #ifndef Q_SPY
+    Q_UNUSED_PAR(qs_id);
+    #endif
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    uint_fast16_t i = 0U;
+    for (; (i < n) && (me->nFree > (QMPoolCtr)margin); ++i) {
+        QFreeBlock * const fb = me->free_head; // get a free block
+
+        //  a free block must be valid
+        Q_ASSERT_INCRIT(400, fb != (QFreeBlock *)0);
+
+        QFreeBlock * const fb_next = fb->next; // fast temporary
+
+        // the free block must have integrity (duplicate inverse storage)
+        Q_ASSERT_INCRIT(402, Q_UINTPTR_CAST_(fb_next)
+                              == (uintptr_t)~fb->next_dis);
+
+        --me->nFree; // one less free block
+        if (me->nFree == 0U) { // is the pool becoming empty?
+            // pool is becoming empty, so the next free block must be NULL
+            Q_ASSERT_INCRIT(420, fb_next == (QFreeBlock *)0);
+        }
+        else {
+            // the next free block must be in range, see QMPool_get()
+            Q_ASSERT_INCRIT(430,
+                (me->start <= fb_next) && (fb_next <= me->end));
+        }
+
+        me->free_head = fb_next; // set the head to the next free block
+        blocks[i] = fb;
+    }
+
+    if (i != 0U) { // got any blocks?
+        // is the # free blocks the new minimum so far?
+        if (me->nMin > me->nFree) {
+            me->nMin = me->nFree; // remember the new minimum
+        }
+
+        QS_BEGIN_PRE_(QS_QF_MPOOL_GET, qs_id)
+            QS_TIME_PRE_();         // timestamp
+            QS_OBJ_PRE_(me);        // this memory pool
+            QS_MPC_PRE_(me->nFree); // # of free blocks in the pool
+            QS_MPC_PRE_(me->nMin);  // min # free blocks ever in the pool
+        QS_END_PRE_()
+    }
+    else { // don't have enough free blocks at this point
+        QS_BEGIN_PRE_(QS_QF_MPOOL_GET_ATTEMPT, qs_id)
+            QS_TIME_PRE_();         // timestamp
+            QS_OBJ_PRE_(me);        // this memory pool
+            QS_MPC_PRE_(me->nFree); // # of free blocks in the pool
+            QS_MPC_PRE_(margin);    // the requested margin
+        QS_END_PRE_()
+    }
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+
+    return i;
+}
+
+//${QF::QMPool::putN} ........................................................
+//! @public @memberof QMPool
+//! Returns n blocks in one critical section, see QMPool_put().
+void QMPool_putN(QMPool * const me,
+    void * const * const blocks,
+    uint_fast16_t const n,
+    uint_fast8_t const qs_id)
+{
+    #ifndef Q_SPY
+    Q_UNUSED_PAR(qs_id);
+    #endif
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        QFreeBlock * const fb = (QFreeBlock *)blocks[i];
+
+        Q_REQUIRE_INCRIT(500, (me->nFree < me->nTot)
+                               && (me->start <= fb) && (fb <= me->end));
+
+        fb->next = me->free_head; // link into list
+    #ifndef Q_UNSAFE
+        fb->next_dis = (uintptr_t)(~Q_UINTPTR_CAST_(fb->next));
+    #endif
+
+        // set as new head of the free list
+        me->free_head = fb;
+
+        ++me->nFree; // one more free block in this pool
+    }
+
+    QS_BEGIN_PRE_(QS_QF_MPOOL_PUT, qs_id)
+        QS_TIME_PRE_();         // timestamp
+        QS_OBJ_PRE_(me);        // this memory pool
+        QS_MPC_PRE_(me->nFree); // the # free blocks in the pool
+    QS_END_PRE_()
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+}
+
+#else // QF_MPOOL_LOCKFREE
+
+//${QF::QMPool::getN} ........................................................
+//! @public @memberof QMPool
+//! Lock-free variant: the blocks are taken one by one with QMPool_get(),
+//! which needs no critical section anyway.
+uint_fast16_t QMPool_getN(QMPool * const me,
+    void ** const blocks,
+    uint_fast16_t const n,
+    uint_fast16_t const margin,
+    uint_fast8_t const qs_id)
+{
+    uint_fast16_t i = 0U;
+    for (; i < n; ++i) {
+        blocks[i] = QMPool_get(me, margin, qs_id);
+        if (blocks[i] == (void *)0) { // no more blocks above the margin?
+            break;
+        }
+    }
+    return i;
+}
+
+//${QF::QMPool::putN} ........................................................
+//! @public @memberof QMPool
+//! Lock-free variant: the blocks are returned one by one with QMPool_put().
+void QMPool_putN(QMPool * const me,
+    void * const * const blocks,
+    uint_fast16_t const n,
+    uint_fast8_t const qs_id)
+{
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        QMPool_put(me, blocks[i], qs_id);
+    }
+}
+
+#endif // QF_MPOOL_LOCKFREE
 //$enddef${QF::QMPool} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
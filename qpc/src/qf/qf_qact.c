@@ -146,6 +146,10 @@ void QActive_register_(QActive * const me) {
 void QActive_unregister_(QActive * const me) {
     uint_fast8_t const p = (uint_fast8_t)me->prio;
 
+    #ifdef QF_EPOOL_MAG
+    QF_magFlush_(me); // the stopped AO must not keep any free blocks
+    #endif
+
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
     QF_MEM_SYS();
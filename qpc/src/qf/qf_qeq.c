@@ -71,6 +71,20 @@ void QEQueue_init(QEQueue * const me,
     struct QEvt const ** const qSto,
     uint_fast16_t const qLen)
 {
+    #ifdef QF_EQUEUE_POW2
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    // the ring-buffer length must be a power of two (or zero)
+    // and the counter must hold the number of free entries (qLen + 1U)
+    Q_REQUIRE_INCRIT(100, ((qLen & (qLen - 1U)) == 0U)
+                          && ((QEQueueCtr)(qLen + 1U) == (qLen + 1U)));
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+    #endif // def QF_EQUEUE_POW2
+
     me->frontEvt = (QEvt *)0; // no events in the queue
     me->ring     = qSto;      // the beginning of the ring buffer
     me->end      = (QEQueueCtr)qLen;
@@ -131,11 +145,15 @@ bool QEQueue_post(QEQueue * const me,
         }
         else { // queue was not empty, insert event into the ring-buffer
             // insert event into the ring buffer (FIFO)...
+    #ifdef QF_EQUEUE_POW2
+            me->ring[me->head & (QEQueueCtr)(me->end - 1U)] = e;
+    #else
             me->ring[me->head] = e; // insert e into buffer
             // need to wrap the head?
             if (me->head == 0U) {
                 me->head = me->end; // wrap around
             }
+    #endif
             --me->head;
         }
         status = true; // event posted successfully
@@ -204,10 +222,14 @@ void QEQueue_postLIFO(QEQueue * const me,
 
     if (frontEvt != (QEvt *)0) { // was the queue not empty?
         ++me->tail;
+    #ifdef QF_EQUEUE_POW2
+        me->ring[me->tail & (QEQueueCtr)(me->end - 1U)] = frontEvt;
+    #else
         if (me->tail == me->end) { // need to wrap the tail?
             me->tail = 0U; // wrap around
         }
         me->ring[me->tail] = frontEvt; // save old front evt
+    #endif
     }
 
     QF_MEM_APP();
@@ -236,10 +258,14 @@ struct QEvt const * QEQueue_get(QEQueue * const me,
 
         // any events in the ring buffer?
         if (nFree <= me->end) {
+    #ifdef QF_EQUEUE_POW2
+            me->frontEvt = me->ring[me->tail & (QEQueueCtr)(me->end - 1U)];
+    #else
             me->frontEvt = me->ring[me->tail]; // get from tail
             if (me->tail == 0U) { // need to wrap the tail?
                 me->tail = me->end; // wrap around
             }
+    #endif
             --me->tail;
 
             QS_BEGIN_PRE_(QS_QF_EQUEUE_GET, qs_id)
@@ -65,6 +65,411 @@ Q_DEFINE_THIS_MODULE("qf_time")
 //${QF::QTimeEvt} ............................................................
 QTimeEvt QTimeEvt_timeEvtHead_[QF_MAX_TICK_RATE];
 
+#ifdef QF_TIMEEVT_ABS
+//${QF::QTimeEvt::tickCtr_} ..................................................
+uint64_t QTimeEvt_tickCtr_[QF_MAX_TICK_RATE];
+#endif // def QF_TIMEEVT_ABS
+
+//! @cond INTERNAL
+
+//${QF::QTimeEvt::idle_} ......................................................
+//! @static @private @memberof QTimeEvt
+//! Tells if no time event of the tick rate is linked (armed or disarmed,
+//! but not yet unlinked). Must be called inside a critical section.
+static bool QTimeEvt_idle_(uint_fast8_t const tickRate) {
+    #ifdef QF_TIMEEVT_WHEEL
+    return QTimeEvt_wheel_[tickRate].nLinked == 0U;
+    #else
+    return (QTimeEvt_timeEvtHead_[tickRate].next == (QTimeEvt *)0)
+           && (QTimeEvt_timeEvtHead_[tickRate].act == (void *)0);
+    #endif // def QF_TIMEEVT_WHEEL
+}
+
+#if (defined QF_TICKLESS) && !(defined QF_TIMEEVT_WHEEL)
+//${QF::QTimeEvt::nextMin_} ...................................................
+//! @static @private @memberof QTimeEvt
+//! Ticks until the nearest expiry of the linked time events (0 if none),
+//! returned by QTimeEvt_nextExpiry() without scanning the list. Arming
+//! lowers it and every tick recomputes it, so it is a lower bound: a time
+//! event disarmed or re-armed later since the last tick still counts.
+static QTimeEvtCtr QTimeEvt_nextMin_[QF_MAX_TICK_RATE];
+
+//${QF::QTimeEvt::nextMinUpd_} ................................................
+//! @static @private @memberof QTimeEvt
+//! Lowers QTimeEvt_nextMin_[tickRate] to a time event expiring in nTicks.
+//! Must be called inside a critical section.
+static void QTimeEvt_nextMinUpd_(uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks)
+{
+    if ((QTimeEvt_nextMin_[tickRate] == 0U)
+        || (nTicks < QTimeEvt_nextMin_[tickRate]))
+    {
+        QTimeEvt_nextMin_[tickRate] = nTicks;
+    }
+}
+#endif // QF_TICKLESS && !QF_TIMEEVT_WHEEL
+
+//! @endcond
+
+#ifdef QF_TIMEEVT_WHEEL
+//${QF::QTimeEvt::wheel_} ....................................................
+QTimeWheel QTimeEvt_wheel_[QF_MAX_TICK_RATE];
+
+//! @cond INTERNAL
+
+#define QTE_WHEEL_MASK ((QTimeEvtCtr)(QTE_WHEEL_SIZE - 1U))
+
+//${QF::QTimeEvt::link_} .....................................................
+//! @private @memberof QTimeEvt
+//! Links the time event into the wheel slot covering me->expiry.
+//! Must be called inside a critical section.
+static void QTimeEvt_link_(QTimeEvt * const me,
+    QTimeWheel * const wheel)
+{
+    QTimeEvtCtr const delta = (QTimeEvtCtr)(me->expiry - wheel->now);
+
+    // find the lowest level whose range still covers the delta...
+    uint_fast8_t lvl   = 0U;
+    uint_fast8_t shift = 0U;
+    while ((lvl < (QF_TIMEEVT_WHEEL_LEVELS - 1U))
+           && (((uint32_t)delta >> (shift + QF_TIMEEVT_WHEEL_BITS)) != 0U))
+    {
+        ++lvl;
+        shift += QF_TIMEEVT_WHEEL_BITS;
+    }
+
+    uint_fast8_t idx;
+    if (((uint32_t)delta >> (shift + QF_TIMEEVT_WHEEL_BITS)) == 0U) {
+        idx = (uint_fast8_t)((me->expiry >> shift) & QTE_WHEEL_MASK);
+    }
+    else { // beyond the range of the wheel
+        // park in the top-level slot cascaded last, which happens
+        // before the expiry, so the event gets re-linked closer
+        idx = (uint_fast8_t)(((wheel->now >> shift) + QTE_WHEEL_MASK)
+                             & QTE_WHEEL_MASK);
+    }
+
+    QTimeEvt * volatile * const head = &wheel->slot[lvl][idx];
+    me->next = *head;
+    if (me->next != (QTimeEvt *)0) {
+        me->next->pprev = &me->next;
+    }
+    *head = me;
+    me->pprev = head;
+
+    ++wheel->nLinked;
+    me->super.refCtr_ |= QTE_IS_LINKED;
+}
+
+//${QF::QTimeEvt::unlink_} ...................................................
+//! @private @memberof QTimeEvt
+//! Removes the time event from whatever wheel list it is in, in O(1).
+//! Must be called inside a critical section.
+static void QTimeEvt_unlink_(QTimeEvt * const me,
+    QTimeWheel * const wheel)
+{
+    *me->pprev = me->next;
+    if (me->next != (QTimeEvt *)0) {
+        me->next->pprev = me->pprev;
+    }
+    me->next  = (QTimeEvt *)0;
+    me->pprev = (QTimeEvt * volatile *)0;
+
+    --wheel->nLinked;
+    me->super.refCtr_ &= (uint8_t)(~QTE_IS_LINKED & 0xFFU);
+}
+
+//${QF::QTimeEvt::detach_} ...................................................
+//! @private @memberof QTimeEvt
+//! Moves the whole list of a wheel slot to the wheel's pending list.
+//! Must be called inside a critical section.
+static void QTimeEvt_detach_(QTimeEvt * volatile * const head,
+    QTimeWheel * const wheel)
+{
+    Q_ASSERT_INCRIT(120, wheel->pending == (QTimeEvt *)0);
+
+    wheel->pending = *head;
+    if (wheel->pending != (QTimeEvt *)0) {
+        wheel->pending->pprev = &wheel->pending;
+    }
+    *head = (QTimeEvt *)0;
+}
+
+#ifdef QF_TICKLESS
+//${QF::QTimeEvt::wheelNext_} .................................................
+//! @private @memberof QTimeEvt
+//! Ticks until the nearest tick, at which the wheel expires or cascades down
+//! a time event (0 if no time event is linked). It is the exact expiry for
+//! a level-0 time event, and a lower bound otherwise: a time event in
+//! a higher level counts at the tick its slot cascades down. Scans the slots
+//! outward from wheel->now, stopping at the first non-empty one of every
+//! level, so it reads at most QF_TIMEEVT_WHEEL_LEVELS * QTE_WHEEL_SIZE slot
+//! heads, whatever the number of the armed time events.
+//! Must be called inside a critical section.
+static QTimeEvtCtr QTimeEvt_wheelNext_(QTimeWheel const * const wheel) {
+    QTimeEvtCtr next = 0U;
+    if (wheel->nLinked != 0U) {
+        // the level-0 slot d ticks ahead holds the events expiring then
+        for (uint_fast16_t d = 1U; d < QTE_WHEEL_SIZE; ++d) {
+            if (wheel->slot[0][(wheel->now + d) & QTE_WHEEL_MASK]
+                != (QTimeEvt *)0)
+            {
+                next = (QTimeEvtCtr)d;
+                break;
+            }
+        }
+
+        // the higher levels cascade down only at multiples of 1 << shift
+        uint_fast8_t shift = 0U;
+        for (uint_fast8_t lvl = 1U; lvl < QF_TIMEEVT_WHEEL_LEVELS; ++lvl) {
+            shift += QF_TIMEEVT_WHEEL_BITS;
+            uint32_t const base = (uint32_t)wheel->now >> shift;
+            for (uint_fast16_t k = 1U; k <= QTE_WHEEL_SIZE; ++k) {
+                QTimeEvtCtr const left = (QTimeEvtCtr)(
+                    ((base + k) << shift) - (uint32_t)wheel->now);
+                if ((next != 0U) && (left >= next)) {
+                    break; // the rest of this level cascades even later
+                }
+                if (wheel->slot[lvl][(base + k) & QTE_WHEEL_MASK]
+                    != (QTimeEvt *)0)
+                {
+                    next = left;
+                    break;
+                }
+            }
+        }
+    }
+    return next;
+}
+#endif // def QF_TICKLESS
+
+//${QF::QTimeEvt::tickWheel_} ................................................
+//! @static @private @memberof QTimeEvt
+//! Timing-wheel variant of QTimeEvt_tick_() advancing the time by nTicks
+//! ticks. The cost per tick does not depend on the number of armed time
+//! events, but only on the number of events cascaded down or expiring at
+//! this very tick. With QF_TICKLESS, the ticks at which nothing expires or
+//! cascades are skipped at once (see QTimeEvt_wheelNext_()).
+static void QTimeEvt_tickWheel_(
+    uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks,
+    void const * const sender)
+{
+    #ifndef Q_SPY
+    Q_UNUSED_PAR(sender);
+    #endif
+
+    QTimeWheel * const wheel = &QTimeEvt_wheel_[tickRate];
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    #ifdef QF_ON_TICK_ACTIVE
+    bool const wasIdle = QTimeEvt_idle_(tickRate);
+    #endif
+
+    #ifdef QF_TIMEEVT_ABS
+    QTimeEvt_tickCtr_[tickRate] += nTicks;
+    #endif
+
+    QS_BEGIN_PRE_(QS_QF_TICK, 0U)
+    #ifdef QF_TIMEEVT_ABS
+        QS_TEC_PRE_(QTimeEvt_tickCtr_[tickRate]); // tick ctr (low bits)
+    #else
+        QTimeEvt_timeEvtHead_[tickRate].ctr = (QTimeEvtCtr)(
+            QTimeEvt_timeEvtHead_[tickRate].ctr + nTicks);
+        QS_TEC_PRE_(QTimeEvt_timeEvtHead_[tickRate].ctr); // tick ctr
+    #endif
+        QS_U8_PRE_(tickRate);     // tick rate
+    QS_END_PRE_()
+
+    for (QTimeEvtCtr n = nTicks; n != 0U; --n) {
+    #ifdef QF_TICKLESS
+        if (n > 1U) {
+            // jump over the ticks, at which nothing expires or cascades
+            QTimeEvtCtr const next = QTimeEvt_wheelNext_(wheel);
+            QTimeEvtCtr const skip = ((next == 0U) || (next > n))
+                                     ? (QTimeEvtCtr)(n - 1U)
+                                     : (QTimeEvtCtr)(next - 1U);
+            wheel->now = (QTimeEvtCtr)(wheel->now + skip);
+            n = (QTimeEvtCtr)(n - skip);
+        }
+    #endif
+
+        ++wheel->now;
+        QTimeEvtCtr const now = wheel->now;
+
+        // cascade the higher levels whenever the lower level wraps around...
+        uint_fast8_t lvl   = 0U;
+        uint_fast8_t shift = 0U;
+        uint_fast8_t idx   = (uint_fast8_t)(now & QTE_WHEEL_MASK);
+        while ((idx == 0U) && (lvl < (QF_TIMEEVT_WHEEL_LEVELS - 1U))) {
+            ++lvl;
+            shift += QF_TIMEEVT_WHEEL_BITS;
+            idx = (uint_fast8_t)((now >> shift) & QTE_WHEEL_MASK);
+
+            QTimeEvt_detach_(&wheel->slot[lvl][idx], wheel);
+            for (QTimeEvt *t = wheel->pending;
+                 t != (QTimeEvt *)0;
+                 t = wheel->pending)
+            {
+                QTimeEvt_unlink_(t, wheel);
+                QTimeEvt_link_(t, wheel); // re-link closer to the expiry
+
+                QF_MEM_APP();
+                QF_CRIT_EXIT(); // exit crit. section to reduce latency
+
+                // prevent merging critical sections,
+                // see NOTE in QTimeEvt_tickList_()
+                QF_CRIT_EXIT_NOP();
+
+                QF_CRIT_ENTRY(); // re-enter crit. section to continue the loop
+                QF_MEM_SYS();
+            }
+        }
+
+        // expire all time events in the current level-0 slot...
+        QTimeEvt_detach_(&wheel->slot[0][now & QTE_WHEEL_MASK], wheel);
+        for (QTimeEvt *t = wheel->pending;
+             t != (QTimeEvt *)0;
+             t = wheel->pending)
+        {
+            // level-0 slot holds only time events expiring at this tick
+            Q_ASSERT_INCRIT(130, t->expiry == now);
+
+            QActive * const act = (QActive *)t->act;
+            QTimeEvt_unlink_(t, wheel);
+
+            if (t->interval != 0U) { // periodic time evt?
+                t->expiry = (QTimeEvtCtr)(now + t->interval);
+                QTimeEvt_link_(t, wheel); // rearm the time event
+            }
+            else { // one-shot time event: automatically disarm
+                t->ctr = 0U;
+
+                QS_BEGIN_PRE_(QS_QF_TIMEEVT_AUTO_DISARM, act->prio)
+                    QS_OBJ_PRE_(t);        // this time event object
+                    QS_OBJ_PRE_(act);      // the target AO
+                    QS_U8_PRE_(tickRate);  // tick rate
+                QS_END_PRE_()
+            }
+
+            QS_BEGIN_PRE_(QS_QF_TIMEEVT_POST, act->prio)
+                QS_TIME_PRE_();            // timestamp
+                QS_OBJ_PRE_(t);            // the time event object
+                QS_SIG_PRE_(t->super.sig); // signal of this time event
+                QS_OBJ_PRE_(act);          // the target AO
+                QS_U8_PRE_(tickRate);      // tick rate
+            QS_END_PRE_()
+
+    #ifdef QXK_H_
+            if (t->super.sig < Q_USER_SIG) {
+                QXThread_timeout_(act);
+                QF_MEM_APP();
+                QF_CRIT_EXIT();
+            }
+            else {
+                QF_MEM_APP();
+                QF_CRIT_EXIT(); // exit crit. section before posting
+
+                // QACTIVE_POST() asserts if the queue overflows
+                QACTIVE_POST(act, &t->super, sender);
+            }
+    #else
+            QF_MEM_APP();
+            QF_CRIT_EXIT(); // exit crit. section before posting
+
+            // QACTIVE_POST() asserts if the queue overflows
+            QACTIVE_POST(act, &t->super, sender);
+    #endif
+
+            QF_CRIT_ENTRY(); // re-enter crit. section to continue the loop
+            QF_MEM_SYS();
+        }
+    }
+
+    #ifdef QF_ON_TICK_ACTIVE
+    if ((!wasIdle) && QTimeEvt_idle_(tickRate)) { // last one gone?
+        QF_onTickActive(tickRate, false);
+    }
+    #endif
+
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+}
+
+//! @endcond
+#endif // def QF_TIMEEVT_WHEEL
+
+//! @cond INTERNAL
+
+//${QF::QTimeEvt::arm_} ......................................................
+//! @private @memberof QTimeEvt
+//! Arms the time event for nTicks ticks of its tick rate, the part shared
+//! by QTimeEvt_armX() and QTimeEvt_armAt(). Must be called inside
+//! a critical section.
+static void QTimeEvt_arm_(QTimeEvt * const me,
+    uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks,
+    QTimeEvtCtr const interval)
+{
+    #ifdef Q_SPY
+    uint_fast8_t const qs_id = ((QActive *)(me->act))->prio;
+    #endif
+
+    #ifdef QF_ON_TICK_ACTIVE
+    bool const wasIdle = QTimeEvt_idle_(tickRate);
+    #endif
+
+    me->ctr = nTicks;
+    me->interval = interval;
+
+    #ifdef QF_TIMEEVT_WHEEL
+    // in the wheel a disarmed time event is always unlinked
+    me->expiry = (QTimeEvtCtr)(QTimeEvt_wheel_[tickRate].now + nTicks);
+    QTimeEvt_link_(me, &QTimeEvt_wheel_[tickRate]);
+    #else
+    // is the time event unlinked?
+    // NOTE: For the duration of a single clock tick of the specified tick
+    // rate a time event can be disarmed and yet still linked into the list
+    // because un-linking is performed exclusively in QTimeEvt_tick_().
+    if ((me->super.refCtr_ & QTE_IS_LINKED) == 0U) {
+        // mark as linked
+        me->super.refCtr_ |= QTE_IS_LINKED;
+
+        // The time event is initially inserted into the separate
+        // "freshly armed" link list based on QTimeEvt_timeEvtHead_[tickRate].act.
+        // Only later, inside the QTimeEvt_tick_() function, the "freshly armed"
+        // list is appended to the main list of armed time events based on
+        // QTimeEvt_timeEvtHead_[tickRate].next. Again, this is to keep any
+        // changes to the main list exclusively inside the QTimeEvt_tick_().
+        me->next = (QTimeEvt *)QTimeEvt_timeEvtHead_[tickRate].act;
+        QTimeEvt_timeEvtHead_[tickRate].act = me;
+    }
+    #ifdef QF_TICKLESS
+    QTimeEvt_nextMinUpd_(tickRate, nTicks);
+    #endif
+    #endif // def QF_TIMEEVT_WHEEL
+
+    QS_BEGIN_PRE_(QS_QF_TIMEEVT_ARM, qs_id)
+        QS_TIME_PRE_();        // timestamp
+        QS_OBJ_PRE_(me);       // this time event object
+        QS_OBJ_PRE_(me->act);  // the active object
+        QS_TEC_PRE_(nTicks);   // the # ticks
+        QS_TEC_PRE_(interval); // the interval
+        QS_U8_PRE_(tickRate);  // tick rate
+    QS_END_PRE_()
+
+    #ifdef QF_ON_TICK_ACTIVE
+    if (wasIdle) { // the first time event of this tick rate?
+        QF_onTickActive(tickRate, true);
+    }
+    #endif
+}
+
+//! @endcond
+
 //${QF::QTimeEvt::ctorX} .....................................................
 //! @public @memberof QTimeEvt
 void QTimeEvt_ctorX(QTimeEvt * const me,
@@ -76,6 +481,10 @@ void QTimeEvt_ctorX(QTimeEvt * const me,
     me->act      = act;
     me->ctr      = 0U;
     me->interval = 0U;
+    #ifdef QF_TIMEEVT_WHEEL
+    me->pprev    = (QTimeEvt * volatile *)0;
+    me->expiry   = 0U;
+    #endif
 
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
@@ -102,9 +511,6 @@ void QTimeEvt_armX(QTimeEvt * const me,
     uint_fast8_t const tickRate
                        = ((uint_fast8_t)me->super.refCtr_ & QTE_TICK_RATE);
     QTimeEvtCtr const ctr = me->ctr;
-    #ifdef Q_SPY
-    uint_fast8_t const qs_id = ((QActive *)(me->act))->prio;
-    #endif
 
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
@@ -119,39 +525,63 @@ void QTimeEvt_armX(QTimeEvt * const me,
     Q_UNUSED_PAR(ctr);
     #endif
 
-    me->ctr = nTicks;
-    me->interval = interval;
+    QTimeEvt_arm_(me, tickRate, nTicks, interval);
 
-    // is the time event unlinked?
-    // NOTE: For the duration of a single clock tick of the specified tick
-    // rate a time event can be disarmed and yet still linked into the list
-    // because un-linking is performed exclusively in QTimeEvt_tick_().
-    if ((me->super.refCtr_ & QTE_IS_LINKED) == 0U) {
-        // mark as linked
-        me->super.refCtr_ |= QTE_IS_LINKED;
+    QF_MEM_APP();
+    QF_CRIT_EXIT();
+}
 
-        // The time event is initially inserted into the separate
-        // "freshly armed" link list based on QTimeEvt_timeEvtHead_[tickRate].act.
-        // Only later, inside the QTimeEvt_tick_() function, the "freshly armed"
-        // list is appended to the main list of armed time events based on
-        // QTimeEvt_timeEvtHead_[tickRate].next. Again, this is to keep any
-        // changes to the main list exclusively inside the QTimeEvt_tick_().
-        me->next = (QTimeEvt *)QTimeEvt_timeEvtHead_[tickRate].act;
-        QTimeEvt_timeEvtHead_[tickRate].act = me;
+#ifdef QF_TIMEEVT_ABS
+//${QF::QTimeEvt::armAt} .....................................................
+//! @public @memberof QTimeEvt
+//! Arms the time event to expire when the tick counter of its tick rate
+//! (QTimeEvt_getTick()) reaches the absolute deadline, and then every
+//! interval ticks (0 for a one-shot). Re-arming at the previous deadline
+//! plus a period keeps the phase, however late the handler runs. A deadline
+//! already passed expires at the next tick, or for a periodic time event
+//! at the next point of its grid (deadline + k*interval).
+void QTimeEvt_armAt(QTimeEvt * const me,
+    uint64_t const deadline,
+    QTimeEvtCtr const interval)
+{
+    uint_fast8_t const tickRate
+                       = ((uint_fast8_t)me->super.refCtr_ & QTE_TICK_RATE);
+    QTimeEvtCtr const ctr = me->ctr;
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    QF_MEM_SYS();
+
+    Q_REQUIRE_INCRIT(900, (me->act != (void *)0)
+        && (ctr == 0U)
+        && (tickRate < (uint_fast8_t)QF_MAX_TICK_RATE)
+        && (me->super.sig >= (QSignal)Q_USER_SIG));
+    #ifdef Q_UNSAFE
+    Q_UNUSED_PAR(ctr);
+    #endif
+
+    uint64_t const now = QTimeEvt_tickCtr_[tickRate];
+    QTimeEvtCtr nTicks;
+    if (deadline > now) {
+        // the deadline must be within the range of the tick counter
+        Q_REQUIRE_INCRIT(910,
+            (deadline - now) <= (uint64_t)(QTimeEvtCtr)(~0U));
+        nTicks = (QTimeEvtCtr)(deadline - now);
+    }
+    else if (interval != 0U) { // late periodic: the next point of the grid
+        nTicks = (QTimeEvtCtr)(interval
+            - (QTimeEvtCtr)((now - deadline) % interval));
+    }
+    else { // late one-shot: expire at the next tick
+        nTicks = 1U;
     }
 
-    QS_BEGIN_PRE_(QS_QF_TIMEEVT_ARM, qs_id)
-        QS_TIME_PRE_();        // timestamp
-        QS_OBJ_PRE_(me);       // this time event object
-        QS_OBJ_PRE_(me->act);  // the active object
-        QS_TEC_PRE_(nTicks);   // the # ticks
-        QS_TEC_PRE_(interval); // the interval
-        QS_U8_PRE_(tickRate);  // tick rate
-    QS_END_PRE_()
+    QTimeEvt_arm_(me, tickRate, nTicks, interval);
 
     QF_MEM_APP();
     QF_CRIT_EXIT();
 }
+#endif // def QF_TIMEEVT_ABS
 
 //${QF::QTimeEvt::disarm} ....................................................
 //! @public @memberof QTimeEvt
@@ -180,6 +610,17 @@ bool QTimeEvt_disarm(QTimeEvt * const me) {
         QS_END_PRE_()
 
         me->ctr = 0U; // schedule removal from the list
+    #ifdef QF_TIMEEVT_WHEEL
+        // the wheel removes the time event right away
+        uint_fast8_t const tickRate
+            = (uint_fast8_t)me->super.refCtr_ & QTE_TICK_RATE;
+        QTimeEvt_unlink_(me, &QTimeEvt_wheel_[tickRate]);
+    #ifdef QF_ON_TICK_ACTIVE
+        if (QTimeEvt_idle_(tickRate)) { // the last time event gone?
+            QF_onTickActive(tickRate, false);
+        }
+    #endif
+    #endif
     }
     else { // the time event was already disarmed automatically
         wasArmed = false;
@@ -219,6 +660,20 @@ bool QTimeEvt_rearm(QTimeEvt * const me,
         && (nTicks != 0U)
         && (me->super.sig >= (QSignal)Q_USER_SIG));
 
+    #ifdef QF_ON_TICK_ACTIVE
+    bool const wasIdle = QTimeEvt_idle_(tickRate);
+    #endif
+
+    #ifdef QF_TIMEEVT_WHEEL
+    QTimeWheel * const wheel = &QTimeEvt_wheel_[tickRate];
+
+    bool const wasArmed = (me->ctr != 0U);
+    if (wasArmed) {
+        QTimeEvt_unlink_(me, wheel); // move to the slot of the new expiry
+    }
+    me->expiry = (QTimeEvtCtr)(wheel->now + nTicks);
+    QTimeEvt_link_(me, wheel);
+    #else
     // is the time evt not running?
     bool wasArmed;
     if (me->ctr == 0U) {
@@ -248,6 +703,10 @@ bool QTimeEvt_rearm(QTimeEvt * const me,
     else { // the time event was armed
         wasArmed = true;
     }
+    #ifdef QF_TICKLESS
+    QTimeEvt_nextMinUpd_(tickRate, nTicks);
+    #endif
+    #endif // def QF_TIMEEVT_WHEEL
     me->ctr = nTicks; // re-load the tick counter (shift the phasing)
 
     QS_BEGIN_PRE_(QS_QF_TIMEEVT_REARM, qs_id)
@@ -259,6 +718,12 @@ bool QTimeEvt_rearm(QTimeEvt * const me,
         QS_2U8_PRE_(tickRate, (wasArmed ? 1U : 0U));
     QS_END_PRE_()
 
+    #ifdef QF_ON_TICK_ACTIVE
+    if (wasIdle) { // the first time event of this tick rate?
+        QF_onTickActive(tickRate, true);
+    }
+    #endif
+
     QF_MEM_APP();
     QF_CRIT_EXIT();
 
@@ -286,16 +751,51 @@ bool QTimeEvt_wasDisarmed(QTimeEvt * const me) {
 QTimeEvtCtr QTimeEvt_currCtr(QTimeEvt const * const me) {
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
+    #ifdef QF_TIMEEVT_WHEEL
+    // the wheel keeps the absolute expiry, so compute what is left
+    QTimeEvtCtr const ctr = (me->ctr != 0U)
+        ? (QTimeEvtCtr)(me->expiry
+              - QTimeEvt_wheel_[me->super.refCtr_ & QTE_TICK_RATE].now)
+        : 0U;
+    #else
     QTimeEvtCtr const ctr = me->ctr;
+    #endif
     QF_CRIT_EXIT();
 
     return ctr;
 }
 
-//${QF::QTimeEvt::tick_} .....................................................
+#ifdef QF_TIMEEVT_ABS
+//${QF::QTimeEvt::getTick} ...................................................
+//! @static @public @memberof QTimeEvt
+//! Returns the 64-bit count of the clock ticks of the given tick rate since
+//! QF_init(), the time base of QTimeEvt_armAt(). It never wraps around (at
+//! 1 kHz not for 584 million years); the 64-bit read is not atomic on
+//! a 32-bit CPU, hence the critical section.
+uint64_t QTimeEvt_getTick(uint_fast8_t const tickRate) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(920, tickRate < QF_MAX_TICK_RATE);
+    uint64_t const now = QTimeEvt_tickCtr_[tickRate];
+    QF_CRIT_EXIT();
+
+    return now;
+}
+#endif // def QF_TIMEEVT_ABS
+
+#ifndef QF_TIMEEVT_WHEEL
+//! @cond INTERNAL
+
+//${QF::QTimeEvt::tickList_} .................................................
 //! @static @private @memberof QTimeEvt
-void QTimeEvt_tick_(
+//! Linked-list variant of QTimeEvt_tick_() advancing the time by nTicks
+//! ticks in one pass over the armed time events. A time event expiring
+//! within the nTicks is posted once, at the end, and a periodic one keeps
+//! its phase. The result is identical to nTicks calls of QTimeEvt_tick_()
+//! as long as no time event expires before the last of the nTicks.
+static void QTimeEvt_tickList_(
     uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks,
     void const * const sender)
 {
     #ifndef Q_SPY
@@ -308,12 +808,30 @@ void QTimeEvt_tick_(
     QF_CRIT_ENTRY();
     QF_MEM_SYS();
 
+    #ifdef QF_ON_TICK_ACTIVE
+    bool const wasIdle = QTimeEvt_idle_(tickRate);
+    #endif
+
+    #ifdef QF_TIMEEVT_ABS
+    QTimeEvt_tickCtr_[tickRate] += nTicks;
+    #endif
+
     QS_BEGIN_PRE_(QS_QF_TICK, 0U)
-        ++prev->ctr;
+    #ifdef QF_TIMEEVT_ABS
+        QS_TEC_PRE_(QTimeEvt_tickCtr_[tickRate]); // tick ctr (low bits)
+    #else
+        prev->ctr = (QTimeEvtCtr)(prev->ctr + nTicks);
         QS_TEC_PRE_(prev->ctr);   // tick ctr
+    #endif
         QS_U8_PRE_(tickRate);     // tick rate
     QS_END_PRE_()
 
+    #ifdef QF_TICKLESS
+    // the pass below visits all the linked time events (also the ones
+    // armed during the pass) and recomputes their nearest expiry
+    QTimeEvt_nextMin_[tickRate] = 0U;
+    #endif
+
     // scan the linked-list of time events at this rate...
     for (;;) {
         QTimeEvt *t = prev->next; // advance down the time evt. list
@@ -353,16 +871,20 @@ void QTimeEvt_tick_(
             QF_CRIT_EXIT_NOP();
         }
         else {
-            --t->ctr;
-
-            if (t->ctr == 0U) { // is time event about to expire?
+            if (t->ctr <= nTicks) { // is time event about to expire?
                 QActive * const act = (QActive *)t->act;
 
                 if (t->interval != 0U) { // periodic time evt?
-                    t->ctr = t->interval; // rearm the time event
+                    // rearm the time event, keeping its phase
+                    t->ctr = (QTimeEvtCtr)(t->interval
+                        - ((QTimeEvtCtr)(nTicks - t->ctr) % t->interval));
                     prev = t; // advance to this time event
+    #ifdef QF_TICKLESS
+                    QTimeEvt_nextMinUpd_(tickRate, t->ctr);
+    #endif
                 }
                 else { // one-shot time event: automatically disarm
+                    t->ctr = 0U;
                     prev->next = t->next;
 
                     // mark time event 't' as NOT linked
@@ -404,7 +926,11 @@ void QTimeEvt_tick_(
     #endif
             }
             else {
+                t->ctr = (QTimeEvtCtr)(t->ctr - nTicks);
                 prev = t; // advance to this time event
+    #ifdef QF_TICKLESS
+                QTimeEvt_nextMinUpd_(tickRate, t->ctr);
+    #endif
 
                 QF_MEM_APP();
                 QF_CRIT_EXIT(); // exit crit. section to reduce latency
@@ -417,10 +943,86 @@ void QTimeEvt_tick_(
         QF_MEM_SYS();
     }
 
+    #ifdef QF_ON_TICK_ACTIVE
+    if ((!wasIdle) && QTimeEvt_idle_(tickRate)) { // last one gone?
+        QF_onTickActive(tickRate, false);
+    }
+    #endif
+
     QF_MEM_APP();
     QF_CRIT_EXIT();
 }
 
+//! @endcond
+#endif // ndef QF_TIMEEVT_WHEEL
+
+//${QF::QTimeEvt::tick_} .....................................................
+//! @static @private @memberof QTimeEvt
+void QTimeEvt_tick_(
+    uint_fast8_t const tickRate,
+    void const * const sender)
+{
+    #ifdef QF_TIMEEVT_WHEEL
+    QTimeEvt_tickWheel_(tickRate, 1U, sender);
+    #else
+    QTimeEvt_tickList_(tickRate, 1U, sender);
+    #endif // def QF_TIMEEVT_WHEEL
+}
+
+#ifdef QF_TICKLESS
+//${QF::QTimeEvt::tickN_} ....................................................
+//! @static @private @memberof QTimeEvt
+//! Catches up nTicks clock ticks at once, e.g., after a tickless sleep.
+//! With nTicks not exceeding QTimeEvt_nextExpiry() the result is identical
+//! to nTicks calls of QTimeEvt_tick_(). A late catch-up (nTicks beyond the
+//! next expiry) posts every expired time event only once in the list, and
+//! at every expiry in the wheel. The wheel skips the ticks, at which
+//! nothing expires or cascades, in O(1) each, so a catch-up costs
+//! O(QF_TIMEEVT_WHEEL_LEVELS * QTE_WHEEL_SIZE) per expiring or cascading
+//! tick with interrupts disabled, but not O(nTicks).
+void QTimeEvt_tickN_(
+    uint_fast8_t const tickRate,
+    QTimeEvtCtr const nTicks,
+    void const * const sender)
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(810, (tickRate < QF_MAX_TICK_RATE)
+        && (nTicks != 0U));
+    QF_CRIT_EXIT();
+
+    #ifdef QF_TIMEEVT_WHEEL
+    QTimeEvt_tickWheel_(tickRate, nTicks, sender);
+    #else
+    QTimeEvt_tickList_(tickRate, nTicks, sender);
+    #endif // def QF_TIMEEVT_WHEEL
+}
+
+//${QF::QTimeEvt::nextExpiry} ................................................
+//! @static @public @memberof QTimeEvt
+//! Returns the number of ticks, which can pass before the next armed time
+//! event of the given tick rate expires (1 means at the next tick), or 0 if
+//! no time event is armed. The result is a lower bound: the list counts
+//! a time event disarmed since the last tick, and the wheel counts a time
+//! event in a higher level at the tick its slot cascades down. Sleeping
+//! that long is always safe; at worst the idle callback wakes up, catches
+//! up the ticks with QTimeEvt_tickN_() and finds nothing expired.
+//! The cost does not depend on the number of armed time events: O(1) in
+//! the list (a minimum kept by the arming and the ticks) and at most
+//! QF_TIMEEVT_WHEEL_LEVELS * QTE_WHEEL_SIZE slot heads in the wheel.
+//! Must be called inside a critical section, e.g., from QV_onIdle(), so
+//! that no time event gets armed in the meantime.
+QTimeEvtCtr QTimeEvt_nextExpiry(uint_fast8_t const tickRate) {
+    Q_REQUIRE_INCRIT(820, tickRate < QF_MAX_TICK_RATE);
+
+    #ifdef QF_TIMEEVT_WHEEL
+    return QTimeEvt_wheelNext_(&QTimeEvt_wheel_[tickRate]);
+    #else
+    return QTimeEvt_nextMin_[tickRate];
+    #endif // def QF_TIMEEVT_WHEEL
+}
+#endif // def QF_TICKLESS
+
 //${QF::QTimeEvt::noActive} ..................................................
 //! @static @public @memberof QTimeEvt
 bool QTimeEvt_noActive(uint_fast8_t const tickRate) {
@@ -429,16 +1031,6 @@ bool QTimeEvt_noActive(uint_fast8_t const tickRate) {
     Q_REQUIRE_INCRIT(800, tickRate < QF_MAX_TICK_RATE);
     QF_CRIT_EXIT();
 
-    bool inactive;
-    if (QTimeEvt_timeEvtHead_[tickRate].next != (QTimeEvt *)0) {
-        inactive = false;
-    }
-    else if ((QTimeEvt_timeEvtHead_[tickRate].act != (void *)0)) {
-        inactive = false;
-    }
-    else {
-        inactive = true;
-    }
-    return inactive;
+    return QTimeEvt_idle_(tickRate);
 }
 //$enddef${QF::QTimeEvt} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
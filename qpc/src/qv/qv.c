@@ -79,6 +79,12 @@ void QF_init(void) {
     QF_bzero_(&QF_priv_,                 sizeof(QF_priv_));
     QF_bzero_(&QV_priv_,                 sizeof(QV_priv_));
     QF_bzero_(&QTimeEvt_timeEvtHead_[0], sizeof(QTimeEvt_timeEvtHead_));
+    #ifdef QF_TIMEEVT_WHEEL
+    QF_bzero_(&QTimeEvt_wheel_[0],       sizeof(QTimeEvt_wheel_));
+    #endif
+    #ifdef QF_TIMEEVT_ABS
+    QF_bzero_(&QTimeEvt_tickCtr_[0],     sizeof(QTimeEvt_tickCtr_));
+    #endif
     QF_bzero_(&QActive_registry_[0],     sizeof(QActive_registry_));
 
     #ifndef Q_UNSAFE
@@ -125,6 +131,19 @@ int_t QF_run(void) {
 
     for (;;) { // QV event loop...
 
+    #ifdef QACTIVE_ISR_RING
+        if (QActive_isrRingPending_ != 0U) { // any events from the ISRs?
+            QF_MEM_APP();
+            QF_INT_ENABLE();
+            QActive_drainIsrRings_(); // move them to the AO event queues
+            QF_INT_DISABLE();
+            QF_MEM_SYS();
+            // an ISR might have posted after its ring was scanned: re-test
+            // the flag with interrupts disabled before going idle
+            continue;
+        }
+    #endif // def QACTIVE_ISR_RING
+
          // check internal integrity (duplicate inverse storage)
          Q_ASSERT_INCRIT(202, QPSet_verify_(&QV_priv_.readySet,
                                              &QV_priv_.readySet_dis));
@@ -150,6 +169,10 @@ int_t QF_run(void) {
             pprev = p; // update previous prio.
     #endif // (defined QF_ON_CONTEXT_SW) || (defined Q_SPY)
 
+    #ifdef QF_EPOOL_MAG
+            QV_priv_.actPrio = p; // the RTC step may use a's magazines
+    #endif
+
             QF_MEM_APP();
             QF_INT_ENABLE();
 
@@ -158,12 +181,19 @@ int_t QF_run(void) {
 
             // dispatch event (virtual call)
             (*a->super.vptr->dispatch)(&a->super, e, p);
+    #ifdef QS_RTC_HIST
+            QS_rtcHistUpdate_(a, (enum_t)e->sig); // RTC-step statistics
+    #endif
     #if (QF_MAX_EPOOL > 0U)
             QF_gc(e);
     #endif
             QF_INT_DISABLE();
             QF_MEM_SYS();
 
+    #ifdef QF_EPOOL_MAG
+            QV_priv_.actPrio = 0U; // end of the RTC step
+    #endif
+
             if (a->eQueue.frontEvt == (QEvt *)0) { // empty queue?
                 QPSet_remove(&QV_priv_.readySet, p);
     #ifndef Q_UNSAFE
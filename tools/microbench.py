@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""Build and run the QEP/QF microbenchmark suite (bench/microbench.c).
+
+Builds bench/microbench.c against the QP/C sources of this repository and
+the single-threaded QK simulation (qpc/ports/posix/qk) in four
+configurations:
+
+* QS tracing off and on (``-DQ_SPY``, all QS records enabled);
+* assertions on and off (``-DQ_UNSAFE``);
+
+runs them one after another and writes all the results into one JSON
+file::
+
+    {
+      "bench": "microbench",
+      "qp_version": "7.3.0",            QP_VERSION_STR of qpc/include/qp.h
+      "cc": "gcc (GCC) 13.2.0",         first line of "<cc> --version"
+      "cflags": "-O2",
+      "results": [
+        {"qs": "off", "unsafe": "off", "op": "QActive_post_",
+         "n": 2000000, "ns_per_op": 5.2, "mops_per_sec": 192.2}, ...
+      ]
+    }
+
+With ``--baseline FILE`` (the output of an earlier run, e.g. before an
+upgrade of qpc/), every ns_per_op is compared with the baseline, and the
+exit status is 1 if any operation got slower by more than ``--threshold``
+(default 10%).
+
+Usage::
+
+    python3 tools/microbench.py [--out microbench.json] [--baseline FILE]
+
+Python 3, standard library only; run from anywhere in the repository.
+"""
+
+import argparse
+import glob
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+CONFIGS = [  # (qs, unsafe)
+    ('off', 'off'),
+    ('off', 'on'),
+    ('on', 'off'),
+    ('on', 'on'),
+]
+
+
+def _path(*parts):
+    return os.path.join(ROOT, *parts)
+
+
+def _sources(qs):
+    src = sorted(glob.glob(_path('qpc', 'src', 'qf', 'q*.c')))
+    src += [_path('qpc', 'src', 'qk', 'qk.c'),
+            _path('qpc', 'ports', 'posix', 'qk', 'qk_port.c')]
+    if qs == 'on':
+        src += [_path('qpc', 'ports', 'posix', 'qk', 'qs_port.c')]
+        src += sorted(glob.glob(_path('QS', 'qs*.c')))
+    src += [_path('bench', 'timebomb_qhsm.c'),
+            _path('bench', 'timebomb_qmsm.c'),
+            _path('bench', 'microbench.c')]
+    return src
+
+
+def _qp_version():
+    with open(_path('qpc', 'include', 'qp.h')) as f:
+        for line in f:
+            if line.startswith('#define QP_VERSION_STR'):
+                return line.split('"')[1]
+    return 'unknown'
+
+
+def build(cc, cflags, qs, unsafe, out):
+    cmd = [cc] + cflags.split()
+    if qs == 'on':
+        cmd.append('-DQ_SPY')
+    if unsafe == 'on':
+        cmd.append('-DQ_UNSAFE')
+    for inc in (('qpc', 'include'), ('qpc', 'ports', 'posix', 'qk'),
+                ('Application',), ('bench',)):
+        cmd.append('-I' + _path(*inc))
+    cmd += _sources(qs) + ['-o', out]
+    subprocess.run(cmd, check=True)
+
+
+def run(exe):
+    out = subprocess.run([exe], check=True, stdout=subprocess.PIPE,
+                         universal_newlines=True).stdout
+    results = []
+    for line in out.splitlines():
+        rec = json.loads(line)
+        del rec['bench']
+        results.append(rec)
+    return results
+
+
+def compare(results, baseline, threshold):
+    """Print the ratios to the baseline; return the number of regressions."""
+    base = {(r['qs'], r['unsafe'], r['op']): r['ns_per_op']
+            for r in baseline['results']}
+    worse = 0
+    print('%-22s %-3s %-6s %10s %10s %7s' % (
+        'op', 'qs', 'unsafe', 'base [ns]', 'now [ns]', 'ratio'))
+    for r in results:
+        key = (r['qs'], r['unsafe'], r['op'])
+        if key not in base:
+            continue
+        ratio = r['ns_per_op'] / base[key]
+        flag = ''
+        if ratio > 1.0 + threshold:
+            flag = '  REGRESSION'
+            worse += 1
+        print('%-22s %-3s %-6s %10.2f %10.2f %7.2f%s' % (
+            r['op'], r['qs'], r['unsafe'], base[key], r['ns_per_op'],
+            ratio, flag))
+    return worse
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(
+        description='Build and run bench/microbench.c with QS on/off and '
+                    'Q_UNSAFE on/off and collect the results in JSON.')
+    ap.add_argument('--out', default='microbench.json',
+                    help='output JSON file (default: microbench.json)')
+    ap.add_argument('--cc', default='gcc', help='C compiler (default: gcc)')
+    ap.add_argument('--cflags', default='-O2',
+                    help='compiler flags (default: -O2)')
+    ap.add_argument('--baseline', help='JSON file of an earlier run to '
+                                       'compare with')
+    ap.add_argument('--threshold', type=float, default=0.10,
+                    help='tolerated slowdown vs the baseline '
+                         '(default: 0.10)')
+    args = ap.parse_args(argv)
+
+    cc_version = subprocess.run(
+        [args.cc, '--version'], check=True, stdout=subprocess.PIPE,
+        universal_newlines=True).stdout.splitlines()[0]
+
+    results = []
+    with tempfile.TemporaryDirectory() as tmp:
+        for qs, unsafe in CONFIGS:
+            exe = os.path.join(tmp, 'microbench_qs%s_unsafe%s' % (qs, unsafe))
+            sys.stderr.write('microbench: QS %s, Q_UNSAFE %s\n' % (qs, unsafe))
+            build(args.cc, args.cflags, qs, unsafe, exe)
+            results += run(exe)
+
+    doc = {
+        'bench': 'microbench',
+        'qp_version': _qp_version(),
+        'cc': cc_version,
+        'cflags': args.cflags,
+        'results': results,
+    }
+    with open(args.out, 'w') as f:
+        json.dump(doc, f, indent=2)
+        f.write('\n')
+
+    if args.baseline is not None:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        if compare(results, baseline, args.threshold) != 0:
+            return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,522 @@
+#!/usr/bin/env python3
+"""Table-driven state machine compiler for QP/C (flattened QMsm code).
+
+Reads a declarative JSON description of a hierarchical state machine and
+emits a C header and source that implement it as a QMsm (or QMActive)
+subclass in the style of qpc/src/qf/qep_msm.c:
+
+* every state gets a QMState object and entry/exit/initial action functions
+  (only for the actions that the state actually has);
+* every transition gets a precomputed transition-action table
+  (QMTranActTable) with the complete list of exit actions, entry actions and
+  the initial action of the target, so that QMsm_dispatch_() never has to
+  discover the least common ancestor;
+* every state gets a signal-indexed table of event functions. The tables are
+  flattened: a state also lists the transitions inherited from its
+  superstates, and their transition-action tables exit directly from that
+  state. An event is therefore handled with one table lookup and one call,
+  instead of probing the state handlers up the hierarchy.
+
+The semantics are those of QHsm/QMsm: the transition action runs in the
+event function before the exits, a transition to a superstate of the source
+is local (the superstate is neither exited nor entered), and the target of
+every transition is drilled into with its initial transition.
+
+Model (JSON)::
+
+    {
+      "class": "TimeBombQM",        C type of the state machine
+      "base": "QMActive",           "QMActive" or "QMsm"
+      "includes": ["qpc.h", ...],   headers for the generated source
+      "maxSig": "MAX_SIG",          end of the signal enumeration
+      "attributes": ["QTimeEvt te;", ...],
+      "ctor": ["...;"],             code after the base-class ctor
+      "initial": {"action": [...], "target": "state"},
+      "states": {
+        "name": {
+          "super": "parent",        omitted for the top-level states
+          "entry": [...], "exit": [...],
+          "init": {"action": [...], "target": "substate"},
+          "on": {
+            "SIG": {"action": [...], "target": "state"},
+            "SIG": {"action": [...], "choice": [
+                {"guard": "expr", "action": [...], "target": "state"},
+                {"guard": "else", ...}]}
+          }
+        }
+      }
+    }
+
+A transition without a "target" is an internal transition. A choice must
+end with an "else" branch, because a flattened table cannot pass an event
+that fails all the guards on to the superstate.
+
+Usage::
+
+    python3 tools/qmsmgen.py bench/timebomb.json bench/timebomb_qmsm
+
+writes bench/timebomb_qmsm.h and bench/timebomb_qmsm.c.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+
+class ModelError(Exception):
+    pass
+
+
+def _lines(value):
+    """Code given as one string or as a list of lines."""
+    if value is None:
+        return []
+    if isinstance(value, str):
+        return [value]
+    return list(value)
+
+
+class Model:
+    def __init__(self, desc):
+        self.cls = desc['class']
+        self.base = desc.get('base', 'QMsm')
+        if self.base not in ('QMsm', 'QMActive'):
+            raise ModelError('base must be QMsm or QMActive')
+        self.includes = desc.get('includes', ['qpc.h'])
+        self.max_sig = desc.get('maxSig', 'MAX_SIG')
+        self.brief = desc.get('brief', self.cls + ' state machine')
+        self.attributes = _lines(desc.get('attributes'))
+        self.ctor = _lines(desc.get('ctor'))
+        self.initial = desc['initial']
+        self.states = desc['states']
+        self._check()
+
+    # hierarchy ------------------------------------------------------------
+    def parent(self, s):
+        return self.states[s].get('super')
+
+    def ancestors(self, s):
+        """s and all its superstates, bottom-up (top not included)."""
+        path = []
+        while s is not None:
+            path.append(s)
+            s = self.parent(s)
+        return path
+
+    def _check(self):
+        def known(s, where):
+            if s not in self.states:
+                raise ModelError('unknown state "%s" in %s' % (s, where))
+
+        for name, st in self.states.items():
+            if st.get('super') is not None:
+                known(st['super'], name + '.super')
+            seen = set()
+            s = name
+            while s is not None:  # the hierarchy must not be cyclic
+                if s in seen:
+                    raise ModelError('cyclic hierarchy at "%s"' % name)
+                seen.add(s)
+                s = self.parent(s)
+            if 'init' in st:
+                t = st['init']['target']
+                known(t, name + '.init')
+                if name not in self.ancestors(t)[1:]:
+                    raise ModelError('init target of "%s" is not a substate'
+                                     % name)
+            for sig, tran in st.get('on', {}).items():
+                for br in self.branches(tran):
+                    if 'target' in br:
+                        known(br['target'], '%s.on.%s' % (name, sig))
+                if 'choice' in tran:
+                    guards = [br.get('guard') for br in tran['choice']]
+                    if guards[-1] != 'else' or 'else' in guards[:-1]:
+                        raise ModelError('choice of %s.on.%s must end with '
+                                         'a single "else" branch'
+                                         % (name, sig))
+        known(self.initial['target'], 'initial')
+
+    @staticmethod
+    def branches(tran):
+        return tran['choice'] if 'choice' in tran else [tran]
+
+    # flattened signal tables ---------------------------------------------
+    def flat_table(self, s):
+        """[(sig, owner)] handled in state s, own signals first."""
+        table = []
+        sigs = set()
+        for owner in self.ancestors(s):
+            for sig in self.states[owner].get('on', {}):
+                if sig not in sigs:
+                    sigs.add(sig)
+                    table.append((sig, owner))
+        return table
+
+    # transitions ----------------------------------------------------------
+    def lca(self, source, target):
+        """LCA of a transition with the QHsm semantics (None: top)."""
+        if source == target:
+            return self.parent(source)  # external self-transition
+        up_s = self.ancestors(source)
+        up_t = self.ancestors(target)
+        if target in up_s:
+            return target   # local tran. to a superstate
+        if source in up_t:
+            return source   # local tran. to a substate
+        for x in up_s[1:]:
+            if x in up_t:
+                return x
+        return None
+
+    def actions(self, current, source, target):
+        """Exit/entry/init action list of a tran. taken in 'current'."""
+        lca = self.lca(source, target)
+        acts = []
+        x = current
+        while x != lca:
+            if self.states[x].get('exit'):
+                acts.append(self.act_name(x, 'x'))
+            x = self.parent(x)
+        if lca != target:
+            path = []
+            x = target
+            while x != lca:
+                path.append(x)
+                x = self.parent(x)
+            for x in reversed(path):
+                if self.states[x].get('entry'):
+                    acts.append(self.act_name(x, 'e'))
+        if 'init' in self.states[target]:
+            acts.append(self.act_name(target, 'i'))
+        return acts
+
+    def init_actions(self, parent, target):
+        """Entry/init action list of an initial tran. from 'parent'."""
+        path = []
+        x = target
+        while x != parent:
+            path.append(x)
+            x = self.parent(x)
+        acts = [self.act_name(x, 'e') for x in reversed(path)
+                if self.states[x].get('entry')]
+        if 'init' in self.states[target]:
+            acts.append(self.act_name(target, 'i'))
+        return acts
+
+    # C names --------------------------------------------------------------
+    def handler(self, s):
+        return '%s_%s' % (self.cls, s)
+
+    def state_obj(self, s):
+        return '%s_%s_s' % (self.cls, s)
+
+    def act_name(self, s, kind):
+        return '%s_%s_%s' % (self.cls, s, kind)
+
+    def evt_fun(self, s, sig):
+        short = sig[:-4] if sig.endswith('_SIG') else sig
+        return '%s_%s_%s' % (self.cls, s, short)
+
+
+# code generation ============================================================
+class Writer:
+    def __init__(self):
+        self.out = []
+
+    def __call__(self, line='', indent=0):
+        self.out.append(('    ' * indent + line).rstrip())
+
+    def code(self, lines, indent):
+        for ln in lines:
+            self(ln, indent)
+
+    def text(self):
+        return '\n'.join(self.out) + '\n'
+
+
+def _uses(lines, name):
+    """Does the code refer to the parameter 'name'?"""
+    return any(re.search(r'\b%s\b' % name, ln) for ln in lines)
+
+
+def _proto(w, head, params, tail):
+    """Emit a function head, wrapping the parameters after the 1st one."""
+    line = '%s(%s)%s' % (head, ', '.join(params), tail)
+    if len(line) <= 79 or len(params) < 2:
+        w(line)
+    elif tail == ' {':  # definition: the brace goes on its own line
+        w('%s(%s,' % (head, params[0]))
+        w('%s)' % ', '.join(params[1:]), 1)
+        w('{')
+    else:
+        w('%s(%s,' % (head, params[0]))
+        w('%s)%s' % (', '.join(params[1:]), tail), 1)
+
+
+def _banner(w, path, src):
+    w('/' + '*' * 78)
+    w('* @file    ' + os.path.basename(path))
+    w('* @brief   generated by tools/qmsmgen.py from ' + src)
+    w('*')
+    w('* DO NOT EDIT: change the model and regenerate this file instead.')
+    w('*' * 78 + '/')
+
+
+def _sep(w, tag):
+    """QM-style separator comment before a generated element."""
+    prefix = '/*${%s} ' % tag
+    w(prefix + '.' * (76 - len(prefix)) + '*/')
+
+
+def _tatbl(w, m, target, acts, ret, indent):
+    """Emit a static transition-action table and return through it."""
+    w('static struct {', indent)
+    w('QMState const *target;', indent + 1)
+    w('QActionHandler act[%d];' % (len(acts) + 1), indent + 1)
+    w('} const tatbl_ = { /* tran-action table */', indent)
+    w('&%s, /* target state */' % m.state_obj(target), indent + 1)
+    w('{', indent + 1)
+    for a in acts:
+        w('Q_ACTION_CAST(&%s),' % a, indent + 2)
+    w('Q_ACTION_NULL /* zero terminator */', indent + 2)
+    w('}', indent + 1)
+    w('};', indent)
+    w('status_ = %s(&tatbl_);' % ret, indent)
+
+
+def _branch(w, m, current, owner, br, indent):
+    w.code(_lines(br.get('action')), indent)
+    if 'target' in br:
+        _tatbl(w, m, br['target'],
+               m.actions(current, owner, br['target']), 'QM_TRAN', indent)
+    else:
+        w('status_ = QM_HANDLED();', indent)
+
+
+def gen_header(m, path, src):
+    w = Writer()
+    _banner(w, path, src)
+    guard = os.path.basename(path).upper().replace('.', '_')
+    w('#ifndef ' + guard)
+    w('#define ' + guard)
+    w()
+    w('/* %s */' % m.brief)
+    w('typedef struct {')
+    w('%s super; /* inherits %s */' % (m.base, m.base), 1)
+    for a in m.attributes:
+        w(a, 1)
+    w('} %s;' % m.cls)
+    w()
+    w('void %s_ctor(%s * const me);' % (m.cls, m.cls))
+    w()
+    w('#endif /* %s */' % guard)
+    return w.text()
+
+
+def gen_source(m, path, header, src):
+    w = Writer()
+    c = m.cls
+    sts = list(m.states)
+    evt_params = ['%s * const me' % c, 'QEvt const * const e']
+    _banner(w, path, src)
+    for inc in m.includes:
+        w('#include "%s"' % inc)
+    w('#include "%s"' % os.path.basename(header))
+    w()
+    w('/* event function of one state for one signal */')
+    _proto(w, 'typedef QState (*%s_EvtFun)' % c, evt_params, ';')
+    w()
+
+    # declarations -----------------------------------------------------
+    w('/* states, actions and event functions */')
+    _proto(w, 'static QState %s_initial' % c,
+           ['%s * const me' % c, 'void const * const par'], ';')
+    for s in sts:
+        st = m.states[s]
+        _proto(w, 'static QState ' + m.handler(s), evt_params, ';')
+        for kind, key in (('e', 'entry'), ('x', 'exit'), ('i', 'init')):
+            if st.get(key):
+                w('static QState %s(%s * const me);'
+                  % (m.act_name(s, kind), c))
+        for sig, _ in m.flat_table(s):
+            _proto(w, 'static QState ' + m.evt_fun(s, sig), evt_params, ';')
+        w('static QMState const %s;' % m.state_obj(s))
+    w()
+
+    # QMState objects --------------------------------------------------
+    for s in sts:
+        st = m.states[s]
+        sup = st.get('super')
+        _sep(w, '%s::SM::%s' % (c, s))
+        w('static QMState const %s = {' % m.state_obj(s))
+        w(('&%s, /* superstate */' % m.state_obj(sup)) if sup
+          else 'QM_STATE_NULL, /* superstate (top) */', 1)
+        w('Q_STATE_CAST(&%s),' % m.handler(s), 1)
+        for kind, key, what in (('e', 'entry', 'entry action'),
+                                ('x', 'exit', 'exit action'),
+                                ('i', 'init', 'initial tran.')):
+            sep = ',' if kind != 'i' else ''
+            if st.get(key):
+                w('Q_ACTION_CAST(&%s)%s' % (m.act_name(s, kind), sep), 1)
+            else:
+                w('Q_ACTION_NULL%s /* no %s */' % (sep, what), 1)
+        w('};')
+    w()
+
+    # signal-indexed dispatch ------------------------------------------
+    w('/* dispatches the event through the signal-indexed table of a state */')
+    w('static inline QState %s_dispatch_(%s * const me,' % (c, c))
+    w('QEvt const * const e, %s_EvtFun const * const tbl)' % c, 1)
+    w('{')
+    w('QSignal const idx = (QSignal)(e->sig - (QSignal)Q_USER_SIG);', 1)
+    w('QState status_;', 1)
+    w('if ((idx < (QSignal)(%s - Q_USER_SIG))' % m.max_sig, 1)
+    w('&& (tbl[idx] != (%s_EvtFun)0))' % c, 2)
+    w('{', 1)
+    w('status_ = (*tbl[idx])(me, e);', 2)
+    w('}', 1)
+    w('else {', 1)
+    w('status_ = QM_SUPER();', 2)
+    w('}', 1)
+    w('return status_;', 1)
+    w('}')
+    w()
+
+    # top-most initial transition ---------------------------------------
+    ini = m.initial
+    _sep(w, c + '::SM')
+    _proto(w, 'static QState %s_initial' % c,
+           ['%s * const me' % c, 'void const * const par'], ' {')
+    w('Q_UNUSED_PAR(par);', 1)
+    w('QState status_;', 1)
+    w.code(_lines(ini.get('action')), 1)
+    w()
+    for s in sts:
+        w('QS_FUN_DICTIONARY(&%s);' % m.handler(s), 1)
+    w()
+    _tatbl(w, m, ini['target'], m.init_actions(None, ini['target']),
+           'QM_TRAN_INIT', 1)
+    w('return status_;', 1)
+    w('}')
+
+    # states -------------------------------------------------------------
+    for s in sts:
+        st = m.states[s]
+        table = m.flat_table(s)
+        w()
+        _sep(w, '%s::SM::%s' % (c, s))
+        _proto(w, 'static QState ' + m.handler(s), evt_params, ' {')
+        if table:
+            w('static %s_EvtFun const tbl_[%s - Q_USER_SIG] = {'
+              % (c, m.max_sig), 1)
+            for i, (sig, owner) in enumerate(table):
+                sep = ',' if i + 1 < len(table) else ''
+                if owner != s:
+                    w('/* inherited from %s */' % owner, 2)
+                w('[%s - Q_USER_SIG] =' % sig, 2)
+                w('&%s%s' % (m.evt_fun(s, sig), sep), 3)
+            w('};', 1)
+            w('return %s_dispatch_(me, e, &tbl_[0]);' % c, 1)
+        else:
+            w('Q_UNUSED_PAR(me);', 1)
+            w('Q_UNUSED_PAR(e);', 1)
+            w('return QM_SUPER();', 1)
+        w('}')
+
+        if st.get('entry'):
+            w('/* entry action */')
+            w('static QState %s(%s * const me) {' % (m.act_name(s, 'e'), c))
+            if not _uses(_lines(st['entry']), 'me'):
+                w('Q_UNUSED_PAR(me);', 1)  # used by QM_ENTRY() only in Q_SPY
+            w.code(_lines(st['entry']), 1)
+            w('return QM_ENTRY(&%s);' % m.state_obj(s), 1)
+            w('}')
+        if st.get('exit'):
+            w('/* exit action */')
+            w('static QState %s(%s * const me) {' % (m.act_name(s, 'x'), c))
+            if not _uses(_lines(st['exit']), 'me'):
+                w('Q_UNUSED_PAR(me);', 1)  # used by QM_EXIT() only in Q_SPY
+            w.code(_lines(st['exit']), 1)
+            w('return QM_EXIT(&%s);' % m.state_obj(s), 1)
+            w('}')
+        if st.get('init'):
+            w('/* initial transition */')
+            w('static QState %s(%s * const me) {' % (m.act_name(s, 'i'), c))
+            w('QState status_;', 1)
+            w.code(_lines(st['init'].get('action')), 1)
+            tgt = st['init']['target']
+            _tatbl(w, m, tgt, m.init_actions(s, tgt), 'QM_TRAN_INIT', 1)
+            w('return status_;', 1)
+            w('}')
+
+        for sig, owner in table:
+            tran = m.states[owner]['on'][sig]
+            w('/* %s%s */' % (sig, '' if owner == s
+                              else ' (inherited from %s)' % owner))
+            _proto(w, 'static QState ' + m.evt_fun(s, sig), evt_params,
+                   ' {')
+            code = _lines(tran.get('action'))
+            for br in m.branches(tran):
+                code += _lines(br.get('action')) + [br.get('guard', '')]
+            if not _uses(code, 'e'):
+                w('Q_UNUSED_PAR(e);', 1)
+            if all('target' not in br for br in m.branches(tran)) \
+                    and not _uses(code, 'me'):
+                w('Q_UNUSED_PAR(me);', 1)
+            w('QState status_;', 1)
+            if 'choice' in tran:
+                w.code(_lines(tran.get('action')), 1)
+                for i, br in enumerate(tran['choice']):
+                    if br['guard'] == 'else':
+                        w('else {', 1)
+                    else:
+                        w('%sif (%s) {' % ('else ' if i else '', br['guard']),
+                          1)
+                    _branch(w, m, s, owner, br, 2)
+                    w('}', 1)
+            else:
+                _branch(w, m, s, owner, tran, 1)
+            w('return status_;', 1)
+            w('}')
+
+    # constructor --------------------------------------------------------
+    w()
+    _sep(w, c + '::ctor')
+    w('void %s_ctor(%s * const me) {' % (c, c))
+    w('%s_ctor(&me->super, Q_STATE_CAST(&%s_initial));' % (m.base, c), 1)
+    w.code(m.ctor, 1)
+    w('}')
+    return w.text()
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(
+        description='Generate a flattened QMsm implementation of a state '
+                    'machine from its JSON description.')
+    ap.add_argument('model', help='JSON description of the state machine')
+    ap.add_argument('out', help='output path without extension '
+                                '(writes <out>.h and <out>.c)')
+    args = ap.parse_args(argv)
+
+    with open(args.model) as f:
+        desc = json.load(f)
+    try:
+        m = Model(desc)
+    except (ModelError, KeyError) as ex:
+        sys.stderr.write('%s: %s\n' % (args.model, ex))
+        return 1
+
+    src = args.model.replace(os.sep, '/')
+    header = args.out + '.h'
+    source = args.out + '.c'
+    with open(header, 'w') as f:
+        f.write(gen_header(m, header, src))
+    with open(source, 'w') as f:
+        f.write(gen_source(m, source, header, src))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())